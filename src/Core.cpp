@@ -0,0 +1,170 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <memory>
+#include <string>
+
+#include <boost/mpl/vector.hpp>
+#include <boost/python.hpp>
+
+#include "constants/Constants.h"
+#include "simulation/SimulationSetup.h"
+
+using namespace boost::python;
+
+namespace
+{
+
+//! Submodule of the core extension, whose bindings are exposed upon the first access of one of its attributes.
+/*!
+ *  The submodule is created empty, with a module-level __getattr__ (PEP 562) and __dir__ that expose the bindings
+ *  into it when first called. Importing the core extension (or a submodule) therefore only costs the creation of the
+ *  module objects; the class and function tables of a submodule are only built by processes that use it.
+ */
+class LazySubmodule
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param module Empty module object the bindings are exposed in.
+     *  \param exposeFunction Function exposing the bindings in the current scope.
+     */
+    LazySubmodule( const object& module, void( *exposeFunction )( ) ):
+        module_( module ), exposeFunction_( exposeFunction ), isInitialized_( std::make_shared< bool >( false ) )
+    { }
+
+    //! Expose the bindings in the module, if not done before, and list the public names in its __all__.
+    void initialize( ) const
+    {
+        if( !*isInitialized_ )
+        {
+            // Set beforehand, so that attribute access during the exposure does not recurse, and reset if the exposure
+            // fails, so that the next access raises the error again instead of finding an empty module.
+            *isInitialized_ = true;
+            try
+            {
+                scope submoduleScope( module_ );
+                exposeFunction_( );
+            }
+            catch( ... )
+            {
+                *isInitialized_ = false;
+                throw;
+            }
+
+            list publicNames;
+            const list names = dict( module_.attr( "__dict__" ) ).keys( );
+            for( long i = 0; i < len( names ); i++ )
+            {
+                const std::string name = extract< std::string >( names[ i ] );
+                if( name.compare( 0, 1, "_" ) != 0 )
+                {
+                    publicNames.append( name );
+                }
+            }
+            publicNames.sort( );
+            setattr( module_, "__all__", publicNames );
+        }
+    }
+
+    //! Module __getattr__, only called by Python for attributes not (yet) in the module dictionary.
+    object getAttribute( const std::string& name ) const
+    {
+        // Special attributes are looked up by the import system, and should not trigger the exposure, except for
+        // __all__, which "from ... import *" requires.
+        const bool isSpecialAttribute = name != "__all__" && name.size( ) > 4 && name.compare( 0, 2, "__" ) == 0 &&
+                name.compare( name.size( ) - 2, 2, "__" ) == 0;
+        if( !isSpecialAttribute )
+        {
+            initialize( );
+            dict moduleDictionary( module_.attr( "__dict__" ) );
+            if( moduleDictionary.has_key( name ) )
+            {
+                return moduleDictionary[ name ];
+            }
+        }
+
+        const std::string moduleName = extract< std::string >( module_.attr( "__name__" ) );
+        PyErr_SetString( PyExc_AttributeError,
+                         ( "module '" + moduleName + "' has no attribute '" + name + "'" ).c_str( ) );
+        throw_error_already_set( );
+        return object( );
+    }
+
+    //! Module __dir__, listing the exposed attributes.
+    list getAttributeNames( ) const
+    {
+        initialize( );
+        list names = dict( module_.attr( "__dict__" ) ).keys( );
+        names.sort( );
+        return names;
+    }
+
+private:
+
+    //! Module the bindings are exposed in.
+    object module_;
+
+    //! Function exposing the bindings in the current scope.
+    void( *exposeFunction_ )( );
+
+    //! Whether the bindings have been exposed, shared by the copies held by __getattr__ and __dir__.
+    std::shared_ptr< bool > isInitialized_;
+};
+
+struct LazySubmoduleGetAttribute
+{
+    LazySubmodule submodule;
+
+    object operator( )( const std::string& name ) const
+    {
+        return submodule.getAttribute( name );
+    }
+};
+
+struct LazySubmoduleDirectory
+{
+    LazySubmodule submodule;
+
+    list operator( )( ) const
+    {
+        return submodule.getAttributeNames( );
+    }
+};
+
+//! Add a lazily exposed submodule to the current scope, and register it in sys.modules.
+void addLazySubmodule( const std::string& name, void( *exposeFunction )( ) )
+{
+    const std::string moduleName = extract< std::string >( scope( ).attr( "__name__" ) )( ) + "." + name;
+    object module( handle<>( PyModule_New( moduleName.c_str( ) ) ) );
+
+    const LazySubmodule submodule( module, exposeFunction );
+    const LazySubmoduleGetAttribute getAttribute = { submodule };
+    const LazySubmoduleDirectory directory = { submodule };
+    module.attr( "__getattr__" ) = make_function(
+                getAttribute, default_call_policies( ), boost::mpl::vector2< object, const std::string& >( ) );
+    module.attr( "__dir__" ) = make_function(
+                directory, default_call_policies( ), boost::mpl::vector1< list >( ) );
+
+    scope( ).attr( name.c_str( ) ) = module;
+    import( "sys" ).attr( "modules" )[ moduleName ] = module;
+}
+
+} // namespace
+
+// Single extension holding all tudatpy bindings, so that Boost.Python, Tudat and the type registry are loaded once
+// per process, instead of once per submodule. It is built into the tudatpy package (as tudatpy.core), and its
+// submodules are named after it (e.g. tudatpy.core.simulation_setup).
+BOOST_PYTHON_MODULE(core)
+        {
+            addLazySubmodule( "constants", &tudatpy::exposeConstants );
+            addLazySubmodule( "simulation_setup", &tudatpy::exposeSimulationSetup );
+        }
@@ -0,0 +1,368 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+// Benchmarks of the native (GIL-free) evaluation and propagation paths of tudatpy. The output follows the JSON format
+// of Google Benchmark (--benchmark_out), so that results of both harnesses can be compared with the same tools.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Tudat/Astrodynamics/Aerodynamics/exponentialAtmosphere.h"
+#include "Tudat/Astrodynamics/Ephemerides/keplerEphemeris.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createAccelerationModels.h"
+
+#include "../simulation/AtmosphereModels.h"
+#include "../simulation/DynamicsSimulator.h"
+#include "../simulation/Ephemerides.h"
+#include "../simulation/FixedSizePropagation.h"
+#include "../simulation/GravityFieldModels.h"
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+
+namespace
+{
+
+//! Result of a single benchmark, with times per iteration in nanoseconds.
+struct BenchmarkResult
+{
+    std::string name;
+    std::size_t iterations;
+    double realTime;
+    double cpuTime;
+    double itemsPerSecond;
+};
+
+//! Value written by the benchmarks, so that the compiler cannot remove the benchmarked computations.
+volatile double benchmarkSink;
+
+double itemsPerSecond( const double itemsPerIteration, const std::size_t iterations, const double realTime )
+{
+    return realTime > 0.0 ? itemsPerIteration * iterations / realTime : 0.0;
+}
+
+//! Run a function repeatedly, increasing the number of iterations until the run takes at least minimumTime seconds.
+template< typename Function >
+BenchmarkResult runBenchmark( const std::string& name, const double itemsPerIteration, const double minimumTime,
+                              Function function )
+{
+    function( );
+
+    std::size_t iterations = 1;
+    while( true )
+    {
+        const std::clock_t cpuStart = std::clock( );
+        const std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now( );
+        for( std::size_t i = 0; i < iterations; i++ )
+        {
+            function( );
+        }
+        const double realTime =
+                std::chrono::duration< double >( std::chrono::steady_clock::now( ) - realStart ).count( );
+        const double cpuTime = static_cast< double >( std::clock( ) - cpuStart ) / CLOCKS_PER_SEC;
+
+        if( realTime >= minimumTime || iterations >= 1000000000 )
+        {
+            BenchmarkResult result;
+            result.name = name;
+            result.iterations = iterations;
+            result.realTime = realTime / iterations * 1.0E9;
+            result.cpuTime = cpuTime / iterations * 1.0E9;
+            result.itemsPerSecond = itemsPerSecond( itemsPerIteration, iterations, realTime );
+            return result;
+        }
+
+        // Aim slightly beyond the minimum time, as Google Benchmark does.
+        const double scaleFactor = realTime > 0.0 ? 1.4 * minimumTime / realTime : 10.0;
+        iterations = static_cast< std::size_t >(
+                    std::ceil( iterations * std::max( 2.0, std::min( 10.0, scaleFactor ) ) ) );
+    }
+}
+
+//! Settings of a point-mass Earth-Moon environment with a vehicle, which can be created without SPICE kernels.
+std::map< std::string, std::shared_ptr< BodySettings > > getBenchmarkBodySettings( )
+{
+    std::map< std::string, std::shared_ptr< BodySettings > > bodySettings;
+
+    bodySettings[ "Earth" ] = std::make_shared< BodySettings >( );
+    bodySettings[ "Earth" ]->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" );
+    bodySettings[ "Earth" ]->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >( 3.986004418E14 );
+
+    Eigen::Vector6d moonState = Eigen::Vector6d::Zero( );
+    moonState( 0 ) = 3.844E8;
+    bodySettings[ "Moon" ] = std::make_shared< BodySettings >( );
+    bodySettings[ "Moon" ]->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                moonState, "SSB", "ECLIPJ2000" );
+    bodySettings[ "Moon" ]->gravityFieldSettings = std::make_shared< CentralGravityFieldSettings >( 4.9048695E12 );
+
+    bodySettings[ "Vehicle" ] = std::make_shared< BodySettings >( );
+    bodySettings[ "Vehicle" ]->constantMass = 1000.0;
+
+    return bodySettings;
+}
+
+NamedBodyMap createBenchmarkBodyMap( )
+{
+    NamedBodyMap bodyMap = createBodies( getBenchmarkBodySettings( ) );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+    return bodyMap;
+}
+
+//! Settings of a one-day propagation of a low Earth orbit, perturbed by the Moon.
+std::shared_ptr< TranslationalStatePropagatorSettings< double > > getBenchmarkPropagatorSettings(
+        const NamedBodyMap& bodyMap )
+{
+    SelectedAccelerationMap selectedAccelerations;
+    selectedAccelerations[ "Vehicle" ][ "Earth" ].push_back(
+                std::make_shared< AccelerationSettings >( tudat::basic_astrodynamics::central_gravity ) );
+    selectedAccelerations[ "Vehicle" ][ "Moon" ].push_back(
+                std::make_shared< AccelerationSettings >( tudat::basic_astrodynamics::central_gravity ) );
+
+    const std::vector< std::string > bodiesToPropagate = { "Vehicle" };
+    const std::vector< std::string > centralBodies = { "Earth" };
+    const tudat::basic_astrodynamics::AccelerationMap accelerationMap = createAccelerationModelsMap(
+                bodyMap, selectedAccelerations, bodiesToPropagate, centralBodies );
+
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 6 );
+    initialState( 0 ) = 7.0E6;
+    initialState( 4 ) = std::sqrt( 3.986004418E14 / 7.0E6 );
+
+    return std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                centralBodies, accelerationMap, bodiesToPropagate, initialState,
+                std::make_shared< PropagationTimeTerminationSettings >( 86400.0 ) );
+}
+
+std::string getDate( )
+{
+    const std::time_t now = std::time( nullptr );
+    char date[ 32 ];
+    std::strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", std::localtime( &now ) );
+    return date;
+}
+
+void writeResults( std::ostream& stream, const std::string& executable, const std::vector< BenchmarkResult >& results )
+{
+    stream << "{\n  \"context\": {\n"
+           << "    \"date\": \"" << getDate( ) << "\",\n"
+           << "    \"executable\": \"" << executable << "\",\n"
+           << "    \"num_cpus\": " << std::thread::hardware_concurrency( ) << ",\n"
+#ifdef NDEBUG
+           << "    \"library_build_type\": \"release\"\n"
+#else
+           << "    \"library_build_type\": \"debug\"\n"
+#endif
+           << "  },\n  \"benchmarks\": [";
+    stream << std::setprecision( 10 );
+    for( unsigned int i = 0; i < results.size( ); i++ )
+    {
+        stream << ( i == 0 ? "\n" : ",\n" )
+               << "    {\n"
+               << "      \"name\": \"" << results.at( i ).name << "\",\n"
+               << "      \"run_name\": \"" << results.at( i ).name << "\",\n"
+               << "      \"run_type\": \"iteration\",\n"
+               << "      \"iterations\": " << results.at( i ).iterations << ",\n"
+               << "      \"real_time\": " << results.at( i ).realTime << ",\n"
+               << "      \"cpu_time\": " << results.at( i ).cpuTime << ",\n"
+               << "      \"time_unit\": \"ns\",\n"
+               << "      \"items_per_second\": " << results.at( i ).itemsPerSecond << "\n"
+               << "    }";
+    }
+    stream << "\n  ]\n}\n";
+}
+
+} // namespace
+
+//! Run the benchmarks.
+/*!
+ *  Options (as in Google Benchmark): --benchmark_out=<file> writes the results as JSON, --benchmark_filter=<text>
+ *  only runs benchmarks whose name contains the text, and --benchmark_min_time=<seconds> sets the minimum duration of
+ *  each benchmark (default 0.5 s).
+ */
+int main( int argc, char* argv[ ] )
+{
+    std::string outputFile;
+    std::string filter;
+    double minimumTime = 0.5;
+    for( int i = 1; i < argc; i++ )
+    {
+        const std::string argument = argv[ i ];
+        if( argument.compare( 0, 16, "--benchmark_out=" ) == 0 )
+        {
+            outputFile = argument.substr( 16 );
+        }
+        else if( argument.compare( 0, 19, "--benchmark_filter=" ) == 0 )
+        {
+            filter = argument.substr( 19 );
+        }
+        else if( argument.compare( 0, 21, "--benchmark_min_time=" ) == 0 )
+        {
+            minimumTime = std::stod( argument.substr( 21 ) );
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << argument << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector< BenchmarkResult > results;
+    auto run = [ & ]( const std::string& name, const double itemsPerIteration,
+                      const std::function< void( ) >& function )
+    {
+        if( name.find( filter ) != std::string::npos )
+        {
+            results.push_back( runBenchmark( name, itemsPerIteration, minimumTime, function ) );
+            std::cout << std::left << std::setw( 64 ) << name << std::right
+                      << std::setw( 16 ) << std::fixed << std::setprecision( 0 ) << results.back( ).realTime << " ns"
+                      << std::setw( 16 ) << std::scientific << std::setprecision( 3 )
+                      << results.back( ).itemsPerSecond << " items/s" << std::endl;
+        }
+    };
+
+    run( "BM_BodyMapCreation", 1.0, [ ]( )
+    {
+        benchmarkSink = static_cast< double >( createBenchmarkBodyMap( ).size( ) );
+    } );
+
+    // Ephemeris evaluation (Kepler orbit, solving Kepler's equation per epoch).
+    {
+        const std::size_t numberOfEpochs = 100000;
+        Eigen::Vector6d keplerElements;
+        keplerElements << 7.0E6, 0.01, 0.9, 0.1, 0.2, 0.3;
+        tudat::ephemerides::KeplerEphemeris ephemeris( keplerElements, 0.0, 3.986004418E14, "Earth", "ECLIPJ2000" );
+        std::vector< double > epochs( numberOfEpochs );
+        for( std::size_t i = 0; i < numberOfEpochs; i++ )
+        {
+            epochs.at( i ) = 10.0 * static_cast< double >( i );
+        }
+        std::vector< double > states( 6 * numberOfEpochs );
+        run( "BM_KeplerEphemerisStates/epochs:100000", numberOfEpochs, [ & ]( )
+        {
+            tudatpy::computeCartesianStates( ephemeris, epochs.data( ), numberOfEpochs, states.data( ) );
+            benchmarkSink = states.back( );
+        } );
+    }
+
+    // Spherical harmonic gravity evaluation, single- and multi-threaded.
+    {
+        const std::size_t numberOfPoints = 10000;
+        const int maximumDegree = 20;
+        Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+        Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+        cosineCoefficients( 0, 0 ) = 1.0;
+        for( int degree = 2; degree <= maximumDegree; degree++ )
+        {
+            for( int order = 0; order <= degree; order++ )
+            {
+                cosineCoefficients( degree, order ) = 1.0E-6 / ( degree * degree );
+                sineCoefficients( degree, order ) = order > 0 ? 0.5E-6 / ( degree * degree ) : 0.0;
+            }
+        }
+        std::vector< double > positions( 3 * numberOfPoints );
+        for( std::size_t i = 0; i < numberOfPoints; i++ )
+        {
+            const double angle = 2.0 * M_PI * static_cast< double >( i ) / numberOfPoints;
+            positions.at( 3 * i ) = 7.0E6 * std::cos( angle );
+            positions.at( 3 * i + 1 ) = 7.0E6 * std::sin( angle ) * std::cos( 3.0 * angle );
+            positions.at( 3 * i + 2 ) = 7.0E6 * std::sin( angle ) * std::sin( 3.0 * angle );
+        }
+        std::vector< double > accelerations( 3 * numberOfPoints );
+        const unsigned int threadCounts[ 2 ] = { 1, 0 };
+        for( const unsigned int numberOfThreads : threadCounts )
+        {
+            run( "BM_SphericalHarmonicAccelerations/degree:20/points:10000/threads:" +
+                 ( numberOfThreads == 0 ? std::string( "all" ) : std::to_string( numberOfThreads ) ), numberOfPoints,
+                 [ & ]( )
+            {
+                tudatpy::computeSphericalHarmonicAccelerations(
+                            3.986004418E14, 6.378137E6, cosineCoefficients, sineCoefficients, numberOfPoints,
+                            positions.data( ), accelerations.data( ), numberOfThreads );
+                benchmarkSink = accelerations.back( );
+            } );
+        }
+    }
+
+    // Atmosphere density evaluation.
+    {
+        const std::size_t numberOfPoints = 100000;
+        tudat::aerodynamics::ExponentialAtmosphere atmosphere( 7.2E3, 290.0, 1.225 );
+        std::vector< double > altitudes( numberOfPoints );
+        for( std::size_t i = 0; i < numberOfPoints; i++ )
+        {
+            altitudes.at( i ) = 1.0E5 + static_cast< double >( i );
+        }
+        const double zero = 0.0;
+        const tudatpy::StridedValues broadcastZero = { &zero, 0 };
+        std::vector< double > densities( numberOfPoints );
+        run( "BM_ExponentialAtmosphereDensity/points:100000", numberOfPoints, [ & ]( )
+        {
+            tudatpy::computeAtmosphereProperty( atmosphere, tudatpy::atmosphere_density, numberOfPoints,
+                                                altitudes.data( ), broadcastZero, broadcastZero, broadcastZero,
+                                                densities.data( ) );
+            benchmarkSink = densities.back( );
+        } );
+    }
+
+    // Propagation throughput, in integration steps per second.
+    {
+        const NamedBodyMap bodyMap = createBenchmarkBodyMap( );
+        const std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                getBenchmarkPropagatorSettings( bodyMap );
+        const std::shared_ptr< IntegratorSettings< double > > integratorSettings =
+                std::make_shared< IntegratorSettings< double > >( rungeKutta4, 0.0, 10.0 );
+        const double numberOfSteps = 86400.0 / 10.0;
+
+        const tudatpy::HistoryStorage historyStorages[ 2 ] =
+        { tudatpy::map_history_storage, tudatpy::contiguous_history_storage };
+        for( const tudatpy::HistoryStorage historyStorage : historyStorages )
+        {
+            tudatpy::SingleArcSimulation simulation( bodyMap, integratorSettings, propagatorSettings, false,
+                                                     historyStorage );
+            run( std::string( "BM_PropagationRK4/point_mass/" ) +
+                 ( historyStorage == tudatpy::map_history_storage ? "map_history" : "contiguous_history" ),
+                 numberOfSteps, [ & ]( )
+            {
+                simulation.integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) );
+                benchmarkSink = static_cast< double >( simulation.getStateHistory( )->size( ) );
+            } );
+        }
+
+        run( "BM_PropagationRK4/point_mass/fixed_size", numberOfSteps, [ & ]( )
+        {
+            benchmarkSink = static_cast< double >( tudatpy::propagateFixedSizeTranslationalDynamics(
+                                                       bodyMap, integratorSettings, propagatorSettings ).size( ) );
+        } );
+    }
+
+    if( !outputFile.empty( ) )
+    {
+        std::ofstream output( outputFile.c_str( ) );
+        writeResults( output, argv[ 0 ], results );
+        if( !output )
+        {
+            std::cerr << "Could not write " << outputFile << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
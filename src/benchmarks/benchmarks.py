@@ -0,0 +1,214 @@
+#    Copyright (c) 2010-2018, Delft University of Technology
+#    All rigths reserved
+#
+#    This file is part of the Tudat. Redistribution and use in source and
+#    binary forms, with or without modification, are permitted exclusively
+#    under the terms of the Modified BSD license. You should have received
+#    a copy of the license with this file. If not, please or visit:
+#    http://tudat.tudelft.nl/LICENSE.
+#
+
+"""Timing harness for the Python interface of tudatpy.
+
+Measures the costs seen from Python (module import, binding call overhead, body creation, vectorized evaluation
+rates and propagation throughput), and writes them in the JSON format of Google Benchmark, like the C++ benchmarks.
+
+Usage: python benchmarks.py [--module-path DIR] [--output FILE] [--filter TEXT] [--min-time SECONDS]
+"""
+
+import argparse
+import datetime
+import json
+import os
+import subprocess
+import sys
+import time
+
+import numpy as np
+
+
+class BenchmarkRunner(object):
+    """Runs benchmarks in the same way as Google Benchmark: each function is repeated until the total time exceeds
+    the minimum time, and the mean time per iteration is reported."""
+
+    def __init__(self, name_filter, minimum_time):
+        self.name_filter = name_filter
+        self.minimum_time = minimum_time
+        self.results = []
+
+    def run(self, name, function, items_per_iteration=1.0, counters=None):
+        if self.name_filter not in name:
+            return
+
+        function()
+        iterations = 1
+        while True:
+            cpu_start = time.process_time()
+            real_start = time.perf_counter()
+            for _ in range(iterations):
+                function()
+            real_time = time.perf_counter() - real_start
+            cpu_time = time.process_time() - cpu_start
+            if real_time >= self.minimum_time or iterations >= 1000000000:
+                break
+            scale_factor = 1.4 * self.minimum_time / real_time if real_time > 0.0 else 10.0
+            iterations = int(np.ceil(iterations * max(2.0, min(10.0, scale_factor))))
+
+        self.add_result(name, iterations, real_time, cpu_time, items_per_iteration, counters)
+
+    def add_result(self, name, iterations, real_time, cpu_time, items_per_iteration=1.0, counters=None):
+        result = {
+            'name': name,
+            'run_name': name,
+            'run_type': 'iteration',
+            'iterations': iterations,
+            'real_time': real_time / iterations * 1.0E9,
+            'cpu_time': cpu_time / iterations * 1.0E9,
+            'time_unit': 'ns',
+            'items_per_second': items_per_iteration * iterations / real_time if real_time > 0.0 else 0.0,
+        }
+        result.update(counters or {})
+        self.results.append(result)
+        print('{:<64}{:>16.0f} ns{:>16.3e} items/s'.format(name, result['real_time'], result['items_per_second']))
+
+
+def benchmark_import(runner, module_path, repetitions=5):
+    """Import time (and peak resident memory) of a fresh interpreter, without and with the first use of
+    simulation_setup (which exposes its bindings)."""
+    statements = {
+        'BM_PythonImport/core': 'import tudatpy.core',
+        'BM_PythonImport/core.simulation_setup': 'import tudatpy.core.simulation_setup as s; s.BodySettings',
+    }
+    for name, statement in statements.items():
+        if runner.name_filter not in name:
+            continue
+        code = ('import resource, time\n'
+                'start = time.perf_counter()\n'
+                '{}\n'
+                'duration = time.perf_counter() - start\n'
+                'print(duration, resource.getrusage(resource.RUSAGE_SELF).ru_maxrss)\n').format(statement)
+        environment = dict(os.environ)
+        environment['PYTHONPATH'] = os.pathsep.join(filter(None, [module_path, environment.get('PYTHONPATH')]))
+        durations = []
+        maximum_resident_sizes = []
+        for _ in range(repetitions):
+            output = subprocess.check_output([sys.executable, '-c', code], env=environment)
+            duration, maximum_resident_size = output.split()
+            durations.append(float(duration))
+            maximum_resident_sizes.append(int(maximum_resident_size))
+        runner.add_result(name, repetitions, sum(durations), sum(durations),
+                          counters={'max_rss_kib': max(maximum_resident_sizes)})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--module-path', default='',
+                        help='Directory containing the tudatpy package (with the core extension module).')
+    parser.add_argument('--output', default='', help='File to which the results are written as JSON.')
+    parser.add_argument('--filter', default='', help='Only run benchmarks whose name contains this text.')
+    parser.add_argument('--min-time', type=float, default=0.5, help='Minimum duration of each benchmark [s].')
+    arguments = parser.parse_args()
+
+    if arguments.module_path:
+        sys.path.insert(0, arguments.module_path)
+
+    runner = BenchmarkRunner(arguments.filter, arguments.min_time)
+    benchmark_import(runner, arguments.module_path)
+
+    from tudatpy.core import simulation_setup as setup
+
+    # Binding overhead of a single property access.
+    body_settings = setup.BodySettings()
+    runner.run('BM_BodySettingsProperty/get', lambda: body_settings.constant_mass)
+
+    def set_constant_mass():
+        body_settings.constant_mass = 1000.0
+    runner.run('BM_BodySettingsProperty/set', set_constant_mass)
+
+    # Environment creation and evaluation.
+    setup.load_standard_spice_kernels()
+    body_names = ['Earth', 'Moon', 'Sun']
+    runner.run('BM_CreateBodies/direct_spice/bodies:3',
+               lambda: setup.create_bodies(setup.get_default_body_settings(list(body_names))))
+
+    body_settings = setup.get_default_body_settings(list(body_names))
+    body_settings['Vehicle'] = setup.BodySettings()
+    body_settings['Vehicle'].constant_mass = 1000.0
+    bodies = setup.create_bodies(body_settings)
+
+    number_of_epochs = 10000
+    epochs = np.linspace(0.0, 86400.0, number_of_epochs)
+    moon_ephemeris = bodies['Moon'].ephemeris
+    runner.run('BM_EphemerisStates/direct_spice/batch/epochs:10000',
+               lambda: moon_ephemeris.get_cartesian_state(epochs), number_of_epochs)
+
+    def get_states_per_epoch():
+        for epoch in epochs[:1000]:
+            moon_ephemeris.get_cartesian_state(float(epoch))
+    runner.run('BM_EphemerisStates/direct_spice/scalar/epochs:1000', get_states_per_epoch, 1000)
+
+    number_of_points = 10000
+    angles = np.linspace(0.0, 2.0 * np.pi, number_of_points)
+    positions = 7.0E6 * np.column_stack(
+        (np.cos(angles), np.sin(angles) * np.cos(3.0 * angles), np.sin(angles) * np.sin(3.0 * angles)))
+    earth_gravity_field = bodies['Earth'].gravity_field_model
+    if hasattr(earth_gravity_field, 'get_accelerations'):
+        for number_of_threads in [1, 0]:
+            runner.run('BM_SphericalHarmonicAccelerations/default_earth/points:10000/threads:{}'.format(
+                           number_of_threads or 'all'),
+                       lambda: earth_gravity_field.get_accelerations(positions, number_of_threads=number_of_threads),
+                       number_of_points)
+
+    # Propagation throughput, in integration steps per second.
+    selected_accelerations = {'Vehicle': {
+        'Earth': [setup.AccelerationSettings(setup.AvailableAcceleration.point_mass_gravity)],
+        'Moon': [setup.AccelerationSettings(setup.AvailableAcceleration.point_mass_gravity)]}}
+    acceleration_models = setup.create_acceleration_models(bodies, selected_accelerations, ['Vehicle'], ['Earth'])
+
+    moon_acceleration = setup.get_acceleration_models(bodies, acceleration_models, 'Vehicle', 'Moon')[0]
+    runner.run('BM_AccelerationModelBatch/third_body_point_mass/points:10000',
+               lambda: moon_acceleration.compute_batch(epochs, positions), number_of_points)
+
+    initial_state = [7.0E6, 0.0, 0.0, 0.0, np.sqrt(3.986004418E14 / 7.0E6), 0.0]
+    propagator_settings = setup.TranslationalStatePropagatorSettings(
+        ['Earth'], acceleration_models, ['Vehicle'], initial_state, setup.PropagationTimeTerminationSettings(86400.0))
+    integrator_settings = setup.IntegratorSettings(setup.AvailableIntegrators.runge_kutta_4, 0.0, 10.0)
+    number_of_steps = 86400.0 / 10.0
+
+    for storage_name, history_storage in [('map_history', setup.HistoryStorage.map),
+                                          ('contiguous_history', setup.HistoryStorage.contiguous)]:
+        simulator = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, False,
+                                                     history_storage)
+
+        def propagate():
+            simulator.integrate_equations_of_motion(initial_state)
+            return simulator.state_history
+        runner.run('BM_PropagationRK4/point_mass/' + storage_name, propagate, number_of_steps)
+
+    runner.run('BM_PropagationRK4/point_mass/fixed_size',
+               lambda: setup.propagate_fixed_size_translational(bodies, integrator_settings, propagator_settings),
+               number_of_steps)
+
+    # Dense output, evaluated at epochs between the integration steps.
+    dense_trajectory = setup.SingleArcDynamicsSimulator(
+        bodies, integrator_settings, propagator_settings, False).integrate_equations_of_motion_dense(initial_state)
+    dense_epochs = np.linspace(0.0, 86400.0, 100000)
+    runner.run('BM_DenseTrajectoryEvaluation/point_mass/epochs:100000',
+               lambda: dense_trajectory.evaluate(dense_epochs), len(dense_epochs))
+
+    # Re-propagation of a variation that equals the baseline over its first 90%, resumed from a checkpoint.
+    incremental_propagation = setup.IncrementalPropagation(bodies, integrator_settings, propagator_settings)
+    runner.run('BM_IncrementalPropagationRK4/point_mass/unchanged:90%',
+               lambda: incremental_propagation.propagate(propagator_settings, 0.9 * 86400.0), number_of_steps)
+
+    if arguments.output:
+        with open(arguments.output, 'w') as output:
+            json.dump({'context': {'date': datetime.datetime.now().isoformat(),
+                                   'executable': sys.executable,
+                                   'python_version': sys.version.split()[0],
+                                   'num_cpus': os.cpu_count()},
+                       'benchmarks': runner.results}, output, indent=2)
+
+
+if __name__ == '__main__':
+    main()
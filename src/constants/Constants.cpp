@@ -5,11 +5,17 @@
 #include <boost/python.hpp>
 #include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
 
+#include "Constants.h"
+
 using namespace boost::python;
 using namespace tudat::physical_constants;
 
-BOOST_PYTHON_MODULE(constants)
-        {
-                boost::python::scope().attr("JULIAN_DAY") = JULIAN_DAY;
-        }
+namespace tudatpy
+{
+
+void exposeConstants( )
+{
+    scope( ).attr( "JULIAN_DAY" ) = JULIAN_DAY;
+}
 
+} // namespace tudatpy
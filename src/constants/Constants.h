@@ -0,0 +1,22 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_CONSTANTS_H
+#define TUDATPY_CONSTANTS_H
+
+namespace tudatpy
+{
+
+//! Expose the physical constants in the current scope.
+void exposeConstants( );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_CONSTANTS_H
@@ -1,3 +1,3 @@
-from tudatpy.src.constants import constants
+from tudatpy.core import constants
 
-print(constants.JULIAN_DAY)
\ No newline at end of file
+print(constants.JULIAN_DAY)
@@ -0,0 +1,200 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModelTypes.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createAccelerationModels.h"
+
+#include "AccelerationModels.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::basic_astrodynamics;
+
+namespace tudatpy
+{
+
+AccelerationModelEvaluator::AccelerationModelEvaluator(
+        const std::shared_ptr< AccelerationModel3d > accelerationModel, const NamedBodyMap& bodyMap,
+        const std::string& bodyUndergoingAcceleration, const std::string& bodyExertingAcceleration ):
+    accelerationModel_( accelerationModel ), bodyUndergoingAcceleration_( bodyUndergoingAcceleration ),
+    bodyExertingAcceleration_( bodyExertingAcceleration )
+{
+    if( bodyMap.count( bodyUndergoingAcceleration ) == 0 )
+    {
+        throw std::runtime_error( "Error when creating acceleration model evaluator, body " +
+                                  bodyUndergoingAcceleration + " does not exist" );
+    }
+    acceleratedBody_ = bodyMap.at( bodyUndergoingAcceleration );
+
+    const auto radiationPressureInterfaces = acceleratedBody_->getRadiationPressureInterfaces( );
+    for( auto interfaceIterator = radiationPressureInterfaces.begin( );
+         interfaceIterator != radiationPressureInterfaces.end( ); interfaceIterator++ )
+    {
+        radiationPressureInterfaces_.push_back( interfaceIterator->second );
+    }
+
+    for( auto bodyIterator = bodyMap.begin( ); bodyIterator != bodyMap.end( ); bodyIterator++ )
+    {
+        if( bodyIterator->first != bodyUndergoingAcceleration && bodyIterator->second->getEphemeris( ) != nullptr )
+        {
+            ephemerisBodies_.push_back( bodyIterator->second );
+        }
+        if( bodyIterator->second->getRotationalEphemeris( ) != nullptr )
+        {
+            rotatingBodies_.push_back( bodyIterator->second );
+        }
+    }
+}
+
+void AccelerationModelEvaluator::computeAccelerations(
+        const std::size_t numberOfPoints, const StridedValues& epochs, const double* states,
+        const std::size_t stateSize, double* accelerations )
+{
+    Eigen::Vector6d state = Eigen::Vector6d::Zero( );
+    for( std::size_t i = 0; i < numberOfPoints; i++ )
+    {
+        for( std::size_t j = 0; j < stateSize; j++ )
+        {
+            state( j ) = states[ i * stateSize + j ];
+        }
+        updateEnvironment( epochs[ i ], state );
+
+        accelerationModel_->resetTime( TUDAT_NAN );
+        accelerationModel_->updateMembers( epochs[ i ] );
+        Eigen::Map< Eigen::Vector3d >( accelerations + 3 * i ) = accelerationModel_->getAcceleration( );
+    }
+}
+
+void AccelerationModelEvaluator::updateEnvironment( const double time, const Eigen::Vector6d& state )
+{
+    for( unsigned int i = 0; i < ephemerisBodies_.size( ); i++ )
+    {
+        ephemerisBodies_[ i ]->setStateFromEphemeris< double, double >( time );
+    }
+    for( unsigned int i = 0; i < rotatingBodies_.size( ); i++ )
+    {
+        rotatingBodies_[ i ]->setCurrentRotationalStateToLocalFrameFromEphemeris( time );
+    }
+    acceleratedBody_->setState( state );
+    if( acceleratedBody_->getFlightConditions( ) != nullptr )
+    {
+        acceleratedBody_->getFlightConditions( )->resetCurrentTime( );
+        acceleratedBody_->getFlightConditions( )->updateConditions( time );
+    }
+    for( unsigned int i = 0; i < radiationPressureInterfaces_.size( ); i++ )
+    {
+        radiationPressureInterfaces_[ i ]->updateInterface( time );
+    }
+}
+
+namespace
+{
+
+std::shared_ptr< AccelerationModelEvaluator > createAccelerationModelEvaluator(
+        const NamedBodyMap& bodyMap, const std::string& bodyUndergoingAcceleration,
+        const std::string& bodyExertingAcceleration, const std::shared_ptr< AccelerationSettings > accelerationSettings,
+        const std::string& centralBody )
+{
+    if( bodyMap.count( bodyUndergoingAcceleration ) == 0 || bodyMap.count( bodyExertingAcceleration ) == 0 ||
+            ( !centralBody.empty( ) && bodyMap.count( centralBody ) == 0 ) )
+    {
+        throw std::runtime_error( "Error when creating acceleration model, not all bodies exist" );
+    }
+    return std::make_shared< AccelerationModelEvaluator >(
+                tudat::simulation_setup::createAccelerationModel(
+                    bodyMap.at( bodyUndergoingAcceleration ), bodyMap.at( bodyExertingAcceleration ),
+                    accelerationSettings, bodyUndergoingAcceleration, bodyExertingAcceleration,
+                    centralBody.empty( ) ? nullptr : bodyMap.at( centralBody ), centralBody, bodyMap ),
+                bodyMap, bodyUndergoingAcceleration, bodyExertingAcceleration );
+}
+
+list getAccelerationModels( const NamedBodyMap& bodyMap, const AccelerationMap& accelerationMap,
+                            const std::string& bodyUndergoingAcceleration, const std::string& bodyExertingAcceleration )
+{
+    list accelerationModels;
+    const auto accelerationsOnBody = accelerationMap.find( bodyUndergoingAcceleration );
+    if( accelerationsOnBody != accelerationMap.end( ) )
+    {
+        const auto accelerationsFromBody = accelerationsOnBody->second.find( bodyExertingAcceleration );
+        if( accelerationsFromBody != accelerationsOnBody->second.end( ) )
+        {
+            for( unsigned int i = 0; i < accelerationsFromBody->second.size( ); i++ )
+            {
+                accelerationModels.append( std::make_shared< AccelerationModelEvaluator >(
+                                               accelerationsFromBody->second.at( i ), bodyMap,
+                                               bodyUndergoingAcceleration, bodyExertingAcceleration ) );
+            }
+        }
+    }
+    return accelerationModels;
+}
+
+AvailableAcceleration getAccelerationType( const AccelerationModelEvaluator& evaluator )
+{
+    return getAccelerationModelType( evaluator.getAccelerationModel( ) );
+}
+
+object computeAccelerationBatch( AccelerationModelEvaluator& evaluator, const object& epochs, const object& states )
+{
+    const ContiguousArray stateArray( states, 2 );
+    if( stateArray.columns( ) != 6 && stateArray.columns( ) != 3 )
+    {
+        throw std::runtime_error(
+                    "Error when evaluating acceleration model, states must be an (N x 6) or (N x 3) array" );
+    }
+    const BroadcastArray epochArray( epochs, stateArray.rows( ), "epochs" );
+
+    numpy::ndarray accelerations = createArray( stateArray.rows( ), 3 );
+    // The GIL is held, since the states of the (shared) bodies are modified, and their models may call SPICE.
+    evaluator.computeAccelerations( stateArray.rows( ), epochArray.getValues( ), stateArray.data( ),
+                                    stateArray.columns( ), getArrayData( accelerations ) );
+    return accelerations;
+}
+
+} // namespace
+
+void exposeAccelerationModels( )
+{
+    class_< AccelerationModelEvaluator, std::shared_ptr< AccelerationModelEvaluator >, boost::noncopyable >(
+                "AccelerationModel",
+                "Acceleration model bound to the bodies it was created with, created by create_acceleration_model\n"
+                "or get_acceleration_models.", no_init )
+            .add_property( "body_undergoing_acceleration", make_function(
+                               &AccelerationModelEvaluator::getBodyUndergoingAcceleration,
+                               return_value_policy< copy_const_reference >( ) ) )
+            .add_property( "body_exerting_acceleration", make_function(
+                               &AccelerationModelEvaluator::getBodyExertingAcceleration,
+                               return_value_policy< copy_const_reference >( ) ) )
+            .add_property( "acceleration_type", &getAccelerationType )
+            .def( "compute_batch", &computeAccelerationBatch, ( arg( "epochs" ), arg( "states" ) ),
+                  "Accelerations at an (N x 6) array of global-frame states (or (N x 3) positions, at zero\n"
+                  "velocity) of the body undergoing the acceleration, and an array of N epochs (or a single epoch),\n"
+                  "as an (N x 3) array. Per point, the environment of the bodies is updated and the model is\n"
+                  "evaluated in a single native loop. The GIL is held, as this modifies the current states of the\n"
+                  "bodies, so it must not be called while they are used in a propagation." )
+            ;
+
+    def( "create_acceleration_model", &createAccelerationModelEvaluator,
+         ( arg( "body_map" ), arg( "body_undergoing_acceleration" ), arg( "body_exerting_acceleration" ),
+           arg( "acceleration_settings" ), arg( "central_body" ) = "" ),
+         "Create a single acceleration model (the central body is only used by third-body accelerations)." );
+
+    def( "get_acceleration_models", &getAccelerationModels,
+         ( arg( "body_map" ), arg( "acceleration_models" ), arg( "body_undergoing_acceleration" ),
+           arg( "body_exerting_acceleration" ) ),
+         "List of the models of an AccelerationMap (created with body_map) exerted by one body on another." );
+}
+
+} // namespace tudatpy
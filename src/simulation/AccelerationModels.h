@@ -0,0 +1,112 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_ACCELERATION_MODELS_H
+#define TUDATPY_ACCELERATION_MODELS_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+
+#include "Conversions.h"
+
+namespace tudatpy
+{
+
+//! Acceleration model together with the bodies whose environment it is evaluated in.
+/*!
+ *  The model reads the states and environment of the bodies through the body map, so that evaluating it at a given
+ *  epoch and state requires updating those bodies first, as the environment updater of a propagation does. The
+ *  updated bodies are shared with any other user of the body map, so that evaluations must not run concurrently with
+ *  a propagation using the same bodies.
+ */
+class AccelerationModelEvaluator
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param accelerationModel Acceleration model to evaluate.
+     *  \param bodyMap Bodies the acceleration model was created with.
+     *  \param bodyUndergoingAcceleration Name of the body undergoing the acceleration.
+     *  \param bodyExertingAcceleration Name of the body exerting the acceleration.
+     */
+    AccelerationModelEvaluator(
+            const std::shared_ptr< tudat::basic_astrodynamics::AccelerationModel3d > accelerationModel,
+            const tudat::simulation_setup::NamedBodyMap& bodyMap, const std::string& bodyUndergoingAcceleration,
+            const std::string& bodyExertingAcceleration );
+
+    //! Compute the acceleration at a series of epochs and states of the body undergoing the acceleration.
+    /*!
+     *  For each point, the states of all other bodies are set from their ephemerides, the rotational states from the
+     *  rotational ephemerides, the state of the body undergoing the acceleration from the input, and its flight
+     *  conditions and radiation pressure interfaces are updated, before the model itself is updated and evaluated.
+     *  Since the bodies are shared with Python, and their models may call SPICE, this is called with the GIL held.
+     *  \param numberOfPoints Number of points.
+     *  \param epochs Epochs of the points.
+     *  \param states Row-major (numberOfPoints x stateSize) block of states in the global frame.
+     *  \param stateSize Number of columns of states: 6 for Cartesian states, or 3 for positions (zero velocity).
+     *  \param accelerations Row-major (numberOfPoints x 3) block to which the accelerations are written.
+     */
+    void computeAccelerations( const std::size_t numberOfPoints, const StridedValues& epochs, const double* states,
+                               const std::size_t stateSize, double* accelerations );
+
+    //! Acceleration model to evaluate.
+    std::shared_ptr< tudat::basic_astrodynamics::AccelerationModel3d > getAccelerationModel( ) const
+    {
+        return accelerationModel_;
+    }
+
+    //! Name of the body undergoing the acceleration.
+    const std::string& getBodyUndergoingAcceleration( ) const
+    {
+        return bodyUndergoingAcceleration_;
+    }
+
+    //! Name of the body exerting the acceleration.
+    const std::string& getBodyExertingAcceleration( ) const
+    {
+        return bodyExertingAcceleration_;
+    }
+
+private:
+
+    //! Update the environment models on which the acceleration depends.
+    void updateEnvironment( const double time, const Eigen::Vector6d& state );
+
+    //! Acceleration model to evaluate.
+    std::shared_ptr< tudat::basic_astrodynamics::AccelerationModel3d > accelerationModel_;
+
+    //! Name of the body undergoing the acceleration.
+    std::string bodyUndergoingAcceleration_;
+
+    //! Name of the body exerting the acceleration.
+    std::string bodyExertingAcceleration_;
+
+    //! Body undergoing the acceleration.
+    std::shared_ptr< tudat::simulation_setup::Body > acceleratedBody_;
+
+    //! Bodies of which the state is set from their ephemeris.
+    std::vector< std::shared_ptr< tudat::simulation_setup::Body > > ephemerisBodies_;
+
+    //! Bodies of which the rotation is set from their rotational ephemeris.
+    std::vector< std::shared_ptr< tudat::simulation_setup::Body > > rotatingBodies_;
+
+    //! Radiation pressure interfaces of the body undergoing the acceleration.
+    std::vector< std::shared_ptr< tudat::electromagnetism::RadiationPressureInterface > > radiationPressureInterfaces_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_ACCELERATION_MODELS_H
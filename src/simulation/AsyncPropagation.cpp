@@ -0,0 +1,394 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/python.hpp>
+
+#include "DynamicsSimulator.h"
+#include "FrozenBodyMap.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Reservations of the bodies of asynchronous propagations, so that propagations sharing a body run one at a time.
+class BodyReservations
+{
+public:
+
+    //! Block until none of the bodies is reserved, and reserve them.
+    void reserve( const std::vector< const Body* >& bodies )
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        bodiesReleased_.wait( lock, [ & ]( )
+        {
+            return std::none_of( bodies.begin( ), bodies.end( ), [ this ]( const Body* body )
+            {
+                return reservedBodies_.count( body ) > 0;
+            } );
+        } );
+        reservedBodies_.insert( bodies.begin( ), bodies.end( ) );
+    }
+
+    //! Release bodies reserved by reserve.
+    void release( const std::vector< const Body* >& bodies )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            for( unsigned int i = 0; i < bodies.size( ); i++ )
+            {
+                reservedBodies_.erase( bodies.at( i ) );
+            }
+        }
+        bodiesReleased_.notify_all( );
+    }
+
+private:
+
+    //! Bodies used by a propagation.
+    std::set< const Body* > reservedBodies_;
+
+    //! Mutex guarding reservedBodies_.
+    std::mutex mutex_;
+
+    //! Signalled when bodies are released.
+    std::condition_variable bodiesReleased_;
+};
+
+//! Reserves bodies (see BodyReservations) for the lifetime of the object.
+class ScopedBodyReservation
+{
+public:
+
+    //! Constructor, blocking until the bodies are reserved.
+    ScopedBodyReservation( BodyReservations& reservations, const std::vector< const Body* >& bodies ):
+        reservations_( reservations ), bodies_( bodies )
+    {
+        reservations_.reserve( bodies_ );
+    }
+
+    //! Destructor, releasing the bodies.
+    ~ScopedBodyReservation( )
+    {
+        reservations_.release( bodies_ );
+    }
+
+private:
+
+    ScopedBodyReservation( const ScopedBodyReservation& );
+
+    ScopedBodyReservation& operator=( const ScopedBodyReservation& );
+
+    //! Reservations holding the bodies.
+    BodyReservations& reservations_;
+
+    //! Reserved bodies.
+    const std::vector< const Body* >& bodies_;
+};
+
+//! Python class of the futures returned by propagate_async (a subclass of concurrent.futures.Future).
+/*!
+ *  Held as a raw (never released) reference, since the static destructors run after the interpreter is finalized.
+ */
+PyObject* propagationFutureClass = nullptr;
+
+//! Worker pool running the asynchronous propagations, created on first use and never destroyed, for the same reason.
+WorkerPool* asyncPropagationPool = nullptr;
+
+//! Reservations of the bodies of the asynchronous propagations, created and kept with the worker pool.
+BodyReservations* asyncPropagationBodyReservations = nullptr;
+
+//! Futures of the propagations that were submitted, but not yet started (only accessed with the GIL held).
+std::set< PyObject* > pendingPropagationFutures;
+
+//! Worker pool running the asynchronous propagations.
+WorkerPool& getAsyncPropagationPool( )
+{
+    // Only called with the GIL held, which serializes the creation.
+    if( asyncPropagationPool == nullptr )
+    {
+        asyncPropagationBodyReservations = new BodyReservations( );
+        asyncPropagationPool = new WorkerPool( 0 );
+    }
+    return *asyncPropagationPool;
+}
+
+//! Cancel the propagations not yet started, and wait for the running ones, so that none completes its future after
+//! the interpreter exits.
+void waitForAsyncPropagations( )
+{
+    if( asyncPropagationPool != nullptr )
+    {
+        // The cancelled propagations complete their tasks without propagating.
+        const std::vector< PyObject* > futures( pendingPropagationFutures.begin( ), pendingPropagationFutures.end( ) );
+        for( unsigned int i = 0; i < futures.size( ); i++ )
+        {
+            object( handle<>( borrowed( futures.at( i ) ) ) ).attr( "cancel" )( );
+        }
+
+        ScopedGilRelease gilRelease;
+        asyncPropagationPool->waitUntilIdle( );
+    }
+}
+
+//! Complete the future of a propagation (with the GIL held), printing any error raised when doing so.
+/*!
+ *  \param future Future of the propagation.
+ *  \param simulationObject Python object holding the simulation, set as result if the propagation succeeded.
+ *  \param errorMessage Message of the error raised by the propagation (empty if it succeeded).
+ */
+void completePropagationFuture( PyObject* future, PyObject* simulationObject, const std::string& errorMessage )
+{
+    try
+    {
+        object futureObject( handle<>( borrowed( future ) ) );
+        try
+        {
+            if( errorMessage.empty( ) )
+            {
+                futureObject.attr( "set_result" )( object( handle<>( borrowed( simulationObject ) ) ) );
+            }
+            else
+            {
+                object runtimeError( handle<>( borrowed( PyExc_RuntimeError ) ) );
+                futureObject.attr( "set_exception" )( runtimeError( errorMessage ) );
+            }
+        }
+        catch( const error_already_set& )
+        {
+            // The error raised when setting the result (e.g. when converting it) is passed to the waiting threads.
+            PyObject* type;
+            PyObject* value;
+            PyObject* traceback;
+            PyErr_Fetch( &type, &value, &traceback );
+            PyErr_NormalizeException( &type, &value, &traceback );
+            const object error = object( handle<>( value ) );
+            Py_XDECREF( type );
+            Py_XDECREF( traceback );
+            futureObject.attr( "set_exception" )( error );
+        }
+    }
+    catch( const error_already_set& )
+    {
+        PyErr_Print( );
+    }
+    catch( ... )
+    {
+        PySys_WriteStderr( "Error when completing asynchronous propagation\n" );
+    }
+}
+
+//! Whether the future of a propagation was cancelled (with the GIL held).
+/*!
+ *  \param future Future of the propagation.
+ *  \return Whether the future was cancelled (false if this could not be determined).
+ */
+bool isPropagationFutureCancelled( PyObject* future )
+{
+    try
+    {
+        const object isCancelled = object( handle<>( borrowed( future ) ) ).attr( "cancelled" )( );
+        return PyObject_IsTrue( isCancelled.ptr( ) ) == 1;
+    }
+    catch( const error_already_set& )
+    {
+        PyErr_Print( );
+    }
+    catch( ... )
+    {
+        PySys_WriteStderr( "Error when starting asynchronous propagation\n" );
+    }
+    return false;
+}
+
+//! Mark the future of a propagation as running (with the GIL held), or notify its waiters that it was cancelled.
+/*!
+ *  \param future Future of the propagation.
+ *  \return Whether the propagation is to be run (false if the future was cancelled, or could not be started).
+ */
+bool startPropagationFuture( PyObject* future )
+{
+    try
+    {
+        const object isNotCancelled = object( handle<>( borrowed( future ) ) ).attr(
+                    "set_running_or_notify_cancel" )( );
+        return PyObject_IsTrue( isNotCancelled.ptr( ) ) == 1;
+    }
+    catch( const error_already_set& )
+    {
+        // The future cannot be run (e.g. it was completed by the caller), so the propagation is skipped.
+        PyErr_Print( );
+    }
+    catch( ... )
+    {
+        PySys_WriteStderr( "Error when starting asynchronous propagation\n" );
+    }
+    return false;
+}
+
+//! Run a propagation on a worker thread, and complete its future.
+/*!
+ *  Futures cancelled before their task is started are skipped without reserving their bodies. Otherwise, the
+ *  propagation waits until no other asynchronous propagation uses any of its bodies (during which it can still be
+ *  cancelled). Besides the propagation, the histories are flattened, so that reading them from the result does not
+ *  block the thread holding the GIL.
+ *  \param simulation Simulation to propagate.
+ *  \param bodies Bodies used by the propagation.
+ *  \param simulationObject Python object holding simulation, set as result of the future; the reference is released.
+ *  \param future Future of the propagation; the reference is released.
+ */
+void runAsyncPropagation( const std::shared_ptr< SingleArcSimulation > simulation,
+                          const std::vector< const Body* >& bodies, PyObject* simulationObject, PyObject* future )
+{
+    {
+        ScopedGilAcquire gilAcquire;
+        if( isPropagationFutureCancelled( future ) )
+        {
+            pendingPropagationFutures.erase( future );
+            startPropagationFuture( future );
+            Py_DECREF( simulationObject );
+            Py_DECREF( future );
+            return;
+        }
+    }
+
+    ScopedBodyReservation bodyReservation( *asyncPropagationBodyReservations, bodies );
+
+    {
+        ScopedGilAcquire gilAcquire;
+        pendingPropagationFutures.erase( future );
+        if( !startPropagationFuture( future ) )
+        {
+            Py_DECREF( simulationObject );
+            Py_DECREF( future );
+            return;
+        }
+    }
+
+    std::string errorMessage;
+    try
+    {
+        simulation->integrateEquationsOfMotion(
+                    simulation->getSimulator( )->getPropagatorSettings( )->getInitialStates( ) );
+        simulation->getStateHistory( );
+        simulation->getDependentVariableHistory( );
+    }
+    catch( const std::exception& error )
+    {
+        errorMessage = error.what( );
+        if( errorMessage.empty( ) )
+        {
+            errorMessage = "Error when propagating asynchronously";
+        }
+    }
+    catch( ... )
+    {
+        errorMessage = "Error when propagating asynchronously, unknown exception";
+    }
+
+    ScopedGilAcquire gilAcquire;
+    completePropagationFuture( future, simulationObject, errorMessage );
+    Py_DECREF( simulationObject );
+    Py_DECREF( future );
+}
+
+object propagateAsync(
+        const NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings, const HistoryStorage historyStorage,
+        const bool areDependentVariablesDeferred )
+{
+    if( usesSpice( bodyMap ) )
+    {
+        throw std::runtime_error( "Error when propagating asynchronously, the ephemerides and rotation models of the "
+                                  "bodies must not call SPICE, which is not thread-safe (use tabulated models)" );
+    }
+
+    // The simulation is created synchronously, so that errors in the settings are raised by this call.
+    const std::shared_ptr< SingleArcSimulation > simulation = std::make_shared< SingleArcSimulation >(
+                bodyMap, integratorSettings, propagatorSettings, false, historyStorage, false,
+                areDependentVariablesDeferred );
+    object simulationObject( simulation );
+    object future = object( handle<>( borrowed( propagationFutureClass ) ) )( );
+
+    std::vector< const Body* > bodies;
+    for( auto bodyIterator = bodyMap.begin( ); bodyIterator != bodyMap.end( ); bodyIterator++ )
+    {
+        bodies.push_back( bodyIterator->second.get( ) );
+    }
+
+    // The worker thread owns a reference to both objects, released once the future is completed.
+    WorkerPool& pool = getAsyncPropagationPool( );
+    PyObject* simulationReference = incref( simulationObject.ptr( ) );
+    PyObject* futureReference = incref( future.ptr( ) );
+    pendingPropagationFutures.insert( futureReference );
+    pool.submit( [ simulation, bodies, simulationReference, futureReference ]( )
+    {
+        runAsyncPropagation( simulation, bodies, simulationReference, futureReference );
+    } );
+    return future;
+}
+
+object awaitPropagationFuture( const object& self )
+{
+    return import( "asyncio" ).attr( "wrap_future" )( self ).attr( "__await__" )( );
+}
+
+} // namespace
+
+void exposeAsyncPropagation( )
+{
+    dict classAttributes;
+    classAttributes[ "__module__" ] = scope( ).attr( "__name__" );
+    classAttributes[ "__doc__" ] =
+            "concurrent.futures.Future of a propagation started by propagate_async, that can also be awaited in an\n"
+            "asyncio event loop (which is then not blocked by the propagation). Its result is the\n"
+            "SingleArcDynamicsSimulator; a failed propagation raises RuntimeError.";
+    classAttributes[ "__await__" ] = make_function( &awaitPropagationFuture );
+    object futureClass = object( handle<>( borrowed( reinterpret_cast< PyObject* >( &PyType_Type ) ) ) )(
+                "PropagationFuture", make_tuple( import( "concurrent.futures" ).attr( "Future" ) ),
+                classAttributes );
+    scope( ).attr( "PropagationFuture" ) = futureClass;
+    propagationFutureClass = incref( futureClass.ptr( ) );
+
+    import( "atexit" ).attr( "register" )( make_function( &waitForAsyncPropagations ) );
+
+    def( "propagate_async", &propagateAsync,
+         ( arg( "body_map" ), arg( "integrator_settings" ), arg( "propagator_settings" ),
+           arg( "history_storage" ) = map_history_storage, arg( "defer_dependent_variables" ) = false ),
+         "Start a propagation from the initial states of the propagator settings on a native worker pool (with\n"
+         "one thread per hardware thread, created on first use), and return its PropagationFuture at once.\n"
+         "The propagation runs with the GIL released; the future may be waited on with result() or awaited in\n"
+         "an asyncio event loop. Propagations still pending can be cancelled.\n\n"
+         "The bodies are used by the worker thread until the future is done, and must not be used by other\n"
+         "propagations meanwhile. Asynchronous propagations sharing a body run one after the other; to run them\n"
+         "concurrently, give each its own bodies (see FrozenBodyMap). The ephemerides and rotation models must\n"
+         "not call SPICE, which is not thread-safe: RuntimeError is raised for bodies that may (use tabulated\n"
+         "models instead, e.g. InterpolatedSpiceEphemerisSettings or an EphemerisCache). When the interpreter\n"
+         "exits, propagations not yet started are cancelled, and running ones are waited for." );
+}
+
+} // namespace tudatpy
@@ -0,0 +1,173 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cmath>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Astrodynamics/Aerodynamics/exponentialAtmosphere.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createAtmosphereModel.h"
+
+#include "AtmosphereModels.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::aerodynamics;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Density of an exponential atmosphere at contiguous altitudes.
+void computeExponentialAtmosphereDensities( const double densityAtZeroAltitude, const double scaleHeight,
+                                            const std::size_t numberOfPoints, const double* altitudes,
+                                            double* densities )
+{
+    const double inverseScaleHeight = 1.0 / scaleHeight;
+    for( std::size_t i = 0; i < numberOfPoints; i++ )
+    {
+        densities[ i ] = densityAtZeroAltitude * std::exp( -altitudes[ i ] * inverseScaleHeight );
+    }
+}
+
+} // namespace
+
+void computeAtmosphereProperty(
+        AtmosphereModel& atmosphereModel, const AtmosphereProperty property, const std::size_t numberOfPoints,
+        const double* altitudes, const StridedValues& longitudes, const StridedValues& latitudes,
+        const StridedValues& times, double* values )
+{
+    ExponentialAtmosphere* exponentialAtmosphere = dynamic_cast< ExponentialAtmosphere* >( &atmosphereModel );
+    if( exponentialAtmosphere != nullptr && property == atmosphere_density )
+    {
+        computeExponentialAtmosphereDensities(
+                    exponentialAtmosphere->getDensityAtZeroAltitude( ), exponentialAtmosphere->getScaleHeight( ),
+                    numberOfPoints, altitudes, values );
+        return;
+    }
+    if( exponentialAtmosphere != nullptr && property == atmosphere_temperature )
+    {
+        std::fill( values, values + numberOfPoints, exponentialAtmosphere->getConstantTemperature( ) );
+        return;
+    }
+
+    for( std::size_t i = 0; i < numberOfPoints; i++ )
+    {
+        switch( property )
+        {
+        case atmosphere_density:
+            values[ i ] = atmosphereModel.getDensity( altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+            break;
+        case atmosphere_pressure:
+            values[ i ] = atmosphereModel.getPressure( altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+            break;
+        case atmosphere_temperature:
+            values[ i ] = atmosphereModel.getTemperature(
+                        altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+            break;
+        }
+    }
+}
+
+namespace
+{
+
+object getAtmosphereProperty( AtmosphereModel& atmosphereModel, const AtmosphereProperty property,
+                              const object& altitudes, const object& longitudes, const object& latitudes,
+                              const object& times )
+{
+    const ContiguousArray altitudeArray( altitudes );
+    const std::size_t numberOfPoints = altitudeArray.size( );
+    const BroadcastArray longitudeArray( longitudes, numberOfPoints, "longitudes" );
+    const BroadcastArray latitudeArray( latitudes, numberOfPoints, "latitudes" );
+    const BroadcastArray timeArray( times, numberOfPoints, "times" );
+
+    numpy::ndarray values = createArray( numberOfPoints );
+    double* valueData = getArrayData( values );
+    {
+        // Only exponential atmospheres are stateless; other models (e.g. tabulated atmospheres, whose interpolators
+        // store the interval found by their last lookup) are evaluated with the GIL held, which serializes them.
+        ScopedGilRelease gilRelease( dynamic_cast< ExponentialAtmosphere* >( &atmosphereModel ) != nullptr );
+        computeAtmosphereProperty( atmosphereModel, property, numberOfPoints, altitudeArray.data( ),
+                                   longitudeArray.getValues( ), latitudeArray.getValues( ), timeArray.getValues( ),
+                                   valueData );
+    }
+    return values;
+}
+
+object getDensity( AtmosphereModel& atmosphereModel, const object& altitudes, const object& longitudes,
+                   const object& latitudes, const object& times )
+{
+    return getAtmosphereProperty( atmosphereModel, atmosphere_density, altitudes, longitudes, latitudes, times );
+}
+
+object getPressure( AtmosphereModel& atmosphereModel, const object& altitudes, const object& longitudes,
+                    const object& latitudes, const object& times )
+{
+    return getAtmosphereProperty( atmosphereModel, atmosphere_pressure, altitudes, longitudes, latitudes, times );
+}
+
+object getTemperature( AtmosphereModel& atmosphereModel, const object& altitudes, const object& longitudes,
+                       const object& latitudes, const object& times )
+{
+    return getAtmosphereProperty( atmosphereModel, atmosphere_temperature, altitudes, longitudes, latitudes, times );
+}
+
+} // namespace
+
+void exposeAtmosphereModels( )
+{
+    class_< AtmosphereSettings, std::shared_ptr< AtmosphereSettings >, boost::noncopyable >(
+                "AtmosphereSettings", no_init )
+            ;
+
+    class_< ExponentialAtmosphereSettings, std::shared_ptr< ExponentialAtmosphereSettings >,
+            bases< AtmosphereSettings >, boost::noncopyable >(
+                "ExponentialAtmosphereSettings",
+                init< double, double, double >(
+                    ( arg( "density_scale_height" ), arg( "constant_temperature" ),
+                      arg( "density_at_zero_altitude" ) ) ) )
+            ;
+
+    class_< TabulatedAtmosphereSettings, std::shared_ptr< TabulatedAtmosphereSettings >,
+            bases< AtmosphereSettings >, boost::noncopyable >(
+                "TabulatedAtmosphereSettings", init< std::string >( arg( "atmosphere_table_file" ) ) )
+            ;
+
+    def( "create_atmosphere_model", &createAtmosphereModel, ( arg( "atmosphere_settings" ), arg( "body_name" ) ) );
+
+    // Altitudes must be an array (or scalar); all other inputs are either scalars or arrays of the same size.
+    class_< AtmosphereModel, std::shared_ptr< AtmosphereModel >, boost::noncopyable >( "AtmosphereModel", no_init )
+            .def( "get_density", &getDensity,
+                  ( arg( "altitudes" ), arg( "longitudes" ) = 0.0, arg( "latitudes" ) = 0.0, arg( "times" ) = 0.0 ),
+                  "Densities at arrays of points, evaluated natively (with the GIL released for exponential\n"
+                  "atmospheres)." )
+            .def( "get_pressure", &getPressure,
+                  ( arg( "altitudes" ), arg( "longitudes" ) = 0.0, arg( "latitudes" ) = 0.0, arg( "times" ) = 0.0 ),
+                  "Pressures at arrays of points, evaluated natively (with the GIL released for exponential\n"
+                  "atmospheres)." )
+            .def( "get_temperature", &getTemperature,
+                  ( arg( "altitudes" ), arg( "longitudes" ) = 0.0, arg( "latitudes" ) = 0.0, arg( "times" ) = 0.0 ),
+                  "Temperatures at arrays of points, evaluated natively (with the GIL released for exponential\n"
+                  "atmospheres)." )
+            ;
+
+    class_< ExponentialAtmosphere, std::shared_ptr< ExponentialAtmosphere >, bases< AtmosphereModel >,
+            boost::noncopyable >( "ExponentialAtmosphere", no_init )
+            .add_property( "scale_height", &ExponentialAtmosphere::getScaleHeight )
+            .add_property( "density_at_zero_altitude", &ExponentialAtmosphere::getDensityAtZeroAltitude )
+            ;
+}
+
+} // namespace tudatpy
@@ -0,0 +1,53 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_ATMOSPHERE_MODELS_H
+#define TUDATPY_ATMOSPHERE_MODELS_H
+
+#include <cstddef>
+
+#include "Tudat/Astrodynamics/Aerodynamics/atmosphereModel.h"
+
+#include "Conversions.h"
+
+namespace tudatpy
+{
+
+//! Quantities that can be evaluated in a batched atmosphere query.
+enum AtmosphereProperty
+{
+    atmosphere_density,
+    atmosphere_pressure,
+    atmosphere_temperature
+};
+
+//! Evaluate a property of an atmosphere model at a series of points.
+/*!
+ *  Exponential atmospheres are evaluated with a dedicated kernel on the contiguous altitudes (a single exponential per
+ *  point, without virtual calls, which the compiler can vectorize); all other models are evaluated point by point.
+ *  Does not touch any Python object, so that it may be called with the GIL released. Only exponential atmospheres may
+ *  be evaluated concurrently, since other models store the state of their last evaluation.
+ *  \param atmosphereModel Atmosphere model to evaluate.
+ *  \param property Property to evaluate.
+ *  \param numberOfPoints Number of points.
+ *  \param altitudes Contiguous altitudes of the points.
+ *  \param longitudes Longitudes of the points.
+ *  \param latitudes Latitudes of the points.
+ *  \param times Epochs of the points.
+ *  \param values Contiguous block to which the values are written.
+ */
+void computeAtmosphereProperty(
+        tudat::aerodynamics::AtmosphereModel& atmosphereModel, const AtmosphereProperty property,
+        const std::size_t numberOfPoints, const double* altitudes, const StridedValues& longitudes,
+        const StridedValues& latitudes, const StridedValues& times, double* values );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_ATMOSPHERE_MODELS_H
@@ -0,0 +1,158 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <boost/python.hpp>
+
+#include "Tudat/SimulationSetup/PropagationSetup/createAccelerationModels.h"
+
+#include "BatchPropagation.h"
+#include "Conversions.h"
+#include "Parallel.h"
+#include "PropagationSetup.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Environment, acceleration models and settings owned by a single worker thread.
+struct WorkerEnvironment
+{
+    NamedBodyMap bodyMap;
+
+    tudat::basic_astrodynamics::AccelerationMap accelerationMap;
+
+    //! Copies of the shared settings, which Tudat simulators may modify.
+    std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings;
+
+    std::shared_ptr< PropagationTerminationSettings > terminationSettings;
+};
+
+} // namespace
+
+std::vector< StateHistory > propagateBatch(
+        const BatchPropagationSettings& settings, const double* initialStates,
+        const std::size_t numberOfPropagations, const std::size_t stateSize, const unsigned int numberOfThreads )
+{
+    std::vector< StateHistory > stateHistories( numberOfPropagations );
+    std::vector< std::unique_ptr< WorkerEnvironment > > workerEnvironments(
+                getNumberOfThreads( numberOfThreads, numberOfPropagations ) );
+
+    parallelFor( numberOfPropagations, numberOfThreads,
+                 [ & ]( const std::size_t propagationIndex, const unsigned int threadIndex )
+    {
+        std::unique_ptr< WorkerEnvironment >& environment = workerEnvironments.at( threadIndex );
+        if( !environment )
+        {
+            environment.reset( new WorkerEnvironment( ) );
+            environment->bodyMap = settings.bodies->createBodyMap( );
+            environment->accelerationMap = createAccelerationModelsMap(
+                        environment->bodyMap, settings.selectedAccelerations,
+                        settings.bodiesToPropagate, settings.centralBodies );
+            environment->integratorSettings = copyIntegratorSettings( settings.integratorSettings );
+            environment->terminationSettings = copyTerminationSettings( settings.terminationSettings );
+        }
+
+        const std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                    settings.centralBodies, environment->accelerationMap, settings.bodiesToPropagate,
+                    Eigen::Map< const Eigen::VectorXd >( initialStates + propagationIndex * stateSize, stateSize ),
+                    environment->terminationSettings );
+
+        SingleArcDynamicsSimulator< double, double > simulator(
+                    environment->bodyMap, environment->integratorSettings, propagatorSettings );
+        stateHistories.at( propagationIndex ) = StateHistory( simulator.getEquationsOfMotionNumericalSolution( ) );
+    } );
+
+    return stateHistories;
+}
+
+namespace
+{
+
+list propagateBatchFromPython(
+        const std::shared_ptr< FrozenBodyMap > bodies, const dict& selectedAccelerations,
+        const list& bodiesToPropagate, const list& centralBodies, const object& initialStates,
+        const std::shared_ptr< PropagationTerminationSettings > terminationSettings,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const unsigned int numberOfThreads )
+{
+    BatchPropagationSettings settings;
+    settings.bodies = bodies;
+    settings.selectedAccelerations = extractSelectedAccelerationMap( selectedAccelerations );
+    settings.bodiesToPropagate = extractList< std::string >( bodiesToPropagate );
+    settings.centralBodies = extractList< std::string >( centralBodies );
+    settings.terminationSettings = terminationSettings;
+    settings.integratorSettings = integratorSettings;
+
+    const ContiguousArray initialStatesArray( initialStates, 2 );
+
+    // Bodies whose models may call SPICE are propagated one at a time on this thread, with the GIL held.
+    const bool isSpiceUsed = usesSpice( bodies->getPrototypeBodyMap( ) );
+    std::vector< StateHistory > stateHistories;
+    {
+        ScopedGilRelease gilRelease( !isSpiceUsed );
+        stateHistories = propagateBatch( settings, initialStatesArray.data( ), initialStatesArray.rows( ),
+                                         initialStatesArray.columns( ), isSpiceUsed ? 1 : numberOfThreads );
+    }
+
+    list results;
+    for( unsigned int i = 0; i < stateHistories.size( ); i++ )
+    {
+        results.append( std::make_shared< StateHistory >( std::move( stateHistories.at( i ) ) ) );
+    }
+    return results;
+}
+
+list propagateBatchFromSettings(
+        const dict& bodySettings, const dict& selectedAccelerations, const list& bodiesToPropagate,
+        const list& centralBodies, const object& initialStates,
+        const std::shared_ptr< PropagationTerminationSettings > terminationSettings,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const unsigned int numberOfThreads, const std::string& globalFrameOrigin,
+        const std::string& globalFrameOrientation )
+{
+    return propagateBatchFromPython(
+                std::make_shared< FrozenBodyMap >( extractMap< std::shared_ptr< BodySettings > >( bodySettings ),
+                                                   globalFrameOrigin, globalFrameOrientation ),
+                selectedAccelerations, bodiesToPropagate, centralBodies, initialStates, terminationSettings,
+                integratorSettings, numberOfThreads );
+}
+
+} // namespace
+
+void exposeBatchPropagation( )
+{
+    def( "propagate_batch", &propagateBatchFromSettings,
+         ( arg( "body_settings" ), arg( "selected_acceleration_per_body" ), arg( "bodies_to_propagate" ),
+           arg( "central_bodies" ), arg( "initial_states" ), arg( "termination_settings" ),
+           arg( "integrator_settings" ), arg( "number_of_threads" ) = 0, arg( "global_frame_origin" ) = "SSB",
+           arg( "global_frame_orientation" ) = "ECLIPJ2000" ),
+         "Propagate each row of initial_states independently on a pool of native threads, with the GIL released.\n"
+         "Returns a list of StateHistory objects.\n\n"
+         "Every thread creates its own bodies from a FrozenBodyMap built once from body_settings. Parallel\n"
+         "propagation requires an environment that does not call SPICE during the propagation: tabulated\n"
+         "ephemerides (e.g. InterpolatedSpiceEphemerisSettings, or an EphemerisCache) and simple or tabulated\n"
+         "rotation models. If any ephemeris or rotation model may call SPICE (such as direct SPICE ephemerides),\n"
+         "the propagations are run one at a time, with the GIL held, regardless of number_of_threads." );
+    def( "propagate_batch", &propagateBatchFromPython,
+         ( arg( "bodies" ), arg( "selected_acceleration_per_body" ), arg( "bodies_to_propagate" ),
+           arg( "central_bodies" ), arg( "initial_states" ), arg( "termination_settings" ),
+           arg( "integrator_settings" ), arg( "number_of_threads" ) = 0 ),
+         "Same as above, for bodies created from an existing FrozenBodyMap." );
+}
+
+} // namespace tudatpy
@@ -0,0 +1,68 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_BATCH_PROPAGATION_H
+#define TUDATPY_BATCH_PROPAGATION_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+#include "FrozenBodyMap.h"
+#include "StateHistory.h"
+
+namespace tudatpy
+{
+
+//! Settings shared (read-only) by all propagations of a batch.
+struct BatchPropagationSettings
+{
+    //! Environment from which the bodies of each worker thread are created.
+    std::shared_ptr< const FrozenBodyMap > bodies;
+
+    //! Accelerations acting on the propagated bodies.
+    tudat::simulation_setup::SelectedAccelerationMap selectedAccelerations;
+
+    //! Names of the propagated bodies.
+    std::vector< std::string > bodiesToPropagate;
+
+    //! Names of the central bodies, one per propagated body.
+    std::vector< std::string > centralBodies;
+
+    //! Settings for the termination of each propagation.
+    std::shared_ptr< tudat::propagators::PropagationTerminationSettings > terminationSettings;
+
+    //! Settings of the numerical integrator.
+    std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings;
+};
+
+//! Propagate a batch of independent initial states in parallel.
+/*!
+ *  Each worker thread creates its own body map from the shared snapshot, its own acceleration models, and its own
+ *  copies of the integrator and termination settings (see copyIntegratorSettings), once, and reuses them for all
+ *  propagations it executes. Models that call SPICE during the propagation (such as direct SPICE
+ *  ephemerides) are not thread-safe; for such bodies (see usesSpice), a single thread must be used.
+ *  \param settings Settings shared by all propagations.
+ *  \param initialStates Row-major (numberOfPropagations x stateSize) block of initial states.
+ *  \param numberOfPropagations Number of propagations.
+ *  \param stateSize Size of a single initial state.
+ *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+ *  \return Propagated state history of each propagation.
+ */
+std::vector< StateHistory > propagateBatch(
+        const BatchPropagationSettings& settings, const double* initialStates,
+        const std::size_t numberOfPropagations, const std::size_t stateSize, const unsigned int numberOfThreads );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_BATCH_PROPAGATION_H
@@ -0,0 +1,194 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "ChunkedOutput.h"
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Identifier at the start and end of every chunked output file (including the format version).
+const char chunkedOutputIdentifier[ 8 ] = { 'T', 'P', 'Y', 'C', 'H', 'K', '0', '1' };
+
+//! Header of a chunked output file.
+struct ChunkedOutputHeader
+{
+    char identifier[ 8 ];
+    std::uint64_t chunkSize;
+    std::uint64_t stateSize;
+    std::uint64_t dependentVariableSize;
+};
+
+//! Footer of a chunked output file.
+struct ChunkedOutputFooter
+{
+    std::uint64_t indexOffset;
+    std::uint64_t numberOfChunks;
+    char identifier[ 8 ];
+};
+
+} // namespace
+
+ChunkedOutputWriter::ChunkedOutputWriter( const std::string& filePath, const std::size_t chunkSize ):
+    filePath_( filePath ), file_( filePath.c_str( ), std::ios::binary | std::ios::trunc ), chunkSize_( chunkSize ),
+    numberOfColumns_( 0 ), numberOfBufferedEpochs_( 0 )
+{
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when writing chunked output, could not open " + filePath );
+    }
+    if( chunkSize_ == 0 )
+    {
+        throw std::runtime_error( "Error when writing chunked output, chunk size must be positive" );
+    }
+}
+
+void ChunkedOutputWriter::initialize( const std::size_t stateSize, const std::size_t dependentVariableSize )
+{
+    ChunkedOutputHeader header;
+    std::memcpy( header.identifier, chunkedOutputIdentifier, sizeof( chunkedOutputIdentifier ) );
+    header.chunkSize = chunkSize_;
+    header.stateSize = stateSize;
+    header.dependentVariableSize = dependentVariableSize;
+    file_.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+
+    numberOfColumns_ = 1 + stateSize + dependentVariableSize;
+    chunkBuffer_.resize( chunkSize_ * numberOfColumns_ );
+    numberOfBufferedEpochs_ = 0;
+    chunkIndex_.clear( );
+}
+
+void ChunkedOutputWriter::append( const double epoch, const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& dependentVariables )
+{
+    double* row = chunkBuffer_.data( ) + numberOfBufferedEpochs_;
+    row[ 0 ] = epoch;
+    for( long i = 0; i < state.rows( ); i++ )
+    {
+        row[ ( 1 + i ) * chunkSize_ ] = state( i );
+    }
+    for( long i = 0; i < dependentVariables.rows( ); i++ )
+    {
+        row[ ( 1 + state.rows( ) + i ) * chunkSize_ ] = dependentVariables( i );
+    }
+
+    numberOfBufferedEpochs_++;
+    if( numberOfBufferedEpochs_ == chunkSize_ )
+    {
+        writeChunk( );
+    }
+}
+
+void ChunkedOutputWriter::finalize( )
+{
+    if( numberOfBufferedEpochs_ > 0 )
+    {
+        writeChunk( );
+    }
+
+    ChunkedOutputFooter footer;
+    footer.indexOffset = static_cast< std::uint64_t >( file_.tellp( ) );
+    footer.numberOfChunks = chunkIndex_.size( );
+    std::memcpy( footer.identifier, chunkedOutputIdentifier, sizeof( chunkedOutputIdentifier ) );
+    file_.write( reinterpret_cast< const char* >( chunkIndex_.data( ) ),
+                 chunkIndex_.size( ) * sizeof( ChunkIndexEntry ) );
+    file_.write( reinterpret_cast< const char* >( &footer ), sizeof( footer ) );
+    file_.flush( );
+
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when writing chunked output " + filePath_ );
+    }
+}
+
+void ChunkedOutputWriter::writeChunk( )
+{
+    ChunkIndexEntry entry;
+    entry.offset = static_cast< std::uint64_t >( file_.tellp( ) );
+    entry.numberOfEpochs = numberOfBufferedEpochs_;
+    entry.firstEpoch = chunkBuffer_.front( );
+    entry.lastEpoch = chunkBuffer_.at( numberOfBufferedEpochs_ - 1 );
+    chunkIndex_.push_back( entry );
+
+    // Columns of partial chunks are written without the unused end of their buffer.
+    for( std::size_t i = 0; i < numberOfColumns_; i++ )
+    {
+        file_.write( reinterpret_cast< const char* >( chunkBuffer_.data( ) + i * chunkSize_ ),
+                     numberOfBufferedEpochs_ * sizeof( double ) );
+    }
+    numberOfBufferedEpochs_ = 0;
+
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when writing chunked output " + filePath_ );
+    }
+}
+
+ChunkedOutputReader::ChunkedOutputReader( const std::string& filePath ):
+    filePath_( filePath ), file_( filePath.c_str( ), std::ios::binary ), numberOfEpochs_( 0 )
+{
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when reading chunked output, could not open " + filePath );
+    }
+
+    ChunkedOutputHeader header;
+    ChunkedOutputFooter footer;
+    file_.read( reinterpret_cast< char* >( &header ), sizeof( header ) );
+    file_.seekg( -static_cast< std::streamoff >( sizeof( footer ) ), std::ios::end );
+    file_.read( reinterpret_cast< char* >( &footer ), sizeof( footer ) );
+    if( !file_ || std::memcmp( header.identifier, chunkedOutputIdentifier, sizeof( chunkedOutputIdentifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when reading chunked output, " + filePath +
+                                  " is not a chunked output file of this version" );
+    }
+    if( std::memcmp( footer.identifier, chunkedOutputIdentifier, sizeof( chunkedOutputIdentifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when reading chunked output, " + filePath +
+                                  " is incomplete (the propagation did not finish)" );
+    }
+
+    stateSize_ = header.stateSize;
+    dependentVariableSize_ = header.dependentVariableSize;
+    chunkIndex_.resize( footer.numberOfChunks );
+    file_.seekg( footer.indexOffset );
+    file_.read( reinterpret_cast< char* >( chunkIndex_.data( ) ), chunkIndex_.size( ) * sizeof( ChunkIndexEntry ) );
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when reading chunked output, index of " + filePath + " is truncated" );
+    }
+    for( unsigned int i = 0; i < chunkIndex_.size( ); i++ )
+    {
+        numberOfEpochs_ += chunkIndex_.at( i ).numberOfEpochs;
+    }
+}
+
+void ChunkedOutputReader::readColumn( const std::size_t chunk, const std::size_t column, double* values )
+{
+    if( chunk >= chunkIndex_.size( ) || column > stateSize_ + dependentVariableSize_ )
+    {
+        throw std::runtime_error( "Error when reading chunked output, chunk or column does not exist" );
+    }
+
+    const ChunkIndexEntry& entry = chunkIndex_.at( chunk );
+    file_.seekg( entry.offset + column * entry.numberOfEpochs * sizeof( double ) );
+    file_.read( reinterpret_cast< char* >( values ), entry.numberOfEpochs * sizeof( double ) );
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when reading chunked output, " + filePath_ + " is truncated" );
+    }
+}
+
+} // namespace tudatpy
@@ -0,0 +1,155 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_CHUNKED_OUTPUT_H
+#define TUDATPY_CHUNKED_OUTPUT_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "PropagationLoop.h"
+
+namespace tudatpy
+{
+
+//! Entry of the chunk index of a chunked output file.
+struct ChunkIndexEntry
+{
+    //! Offset of the chunk in the file.
+    std::uint64_t offset;
+
+    //! Number of epochs in the chunk.
+    std::uint64_t numberOfEpochs;
+
+    //! First epoch in the chunk.
+    double firstEpoch;
+
+    //! Last epoch in the chunk.
+    double lastEpoch;
+};
+
+//! Output sink streaming a propagation to a chunked, columnar binary file.
+/*!
+ *  The file consists of a header, a series of chunks and an index of the chunks, followed by a footer locating the
+ *  index. Each chunk holds up to chunkSize epochs, stored column by column: the epochs, then each state entry, then
+ *  each dependent variable, each as a contiguous block of doubles. Only a single chunk is held in memory, so the memory
+ *  used by a propagation does not depend on its length. Values are stored in native byte order.
+ */
+class ChunkedOutputWriter: public PropagationOutputSink
+{
+public:
+
+    //! Constructor, creating the file.
+    /*!
+     *  \param filePath Path of the file to write.
+     *  \param chunkSize Maximum number of epochs per chunk.
+     */
+    ChunkedOutputWriter( const std::string& filePath, const std::size_t chunkSize );
+
+    void initialize( const std::size_t stateSize, const std::size_t dependentVariableSize );
+
+    void append( const double epoch, const Eigen::VectorXd& state, const Eigen::VectorXd& dependentVariables );
+
+    //! Write the last (partial) chunk, the index and the footer.
+    void finalize( );
+
+private:
+
+    //! Write the buffered chunk to the file, and clear the buffer.
+    void writeChunk( );
+
+    //! Path of the file.
+    std::string filePath_;
+
+    //! Output file.
+    std::ofstream file_;
+
+    //! Maximum number of epochs per chunk.
+    std::size_t chunkSize_;
+
+    //! Number of columns (epochs, states and dependent variables).
+    std::size_t numberOfColumns_;
+
+    //! Column-major (chunkSize x numberOfColumns) buffer of the current chunk.
+    std::vector< double > chunkBuffer_;
+
+    //! Number of epochs in the current chunk.
+    std::size_t numberOfBufferedEpochs_;
+
+    //! Index of the chunks written so far.
+    std::vector< ChunkIndexEntry > chunkIndex_;
+};
+
+//! Reader of a file written by ChunkedOutputWriter.
+class ChunkedOutputReader
+{
+public:
+
+    //! Constructor, reading the header and index of the file.
+    explicit ChunkedOutputReader( const std::string& filePath );
+
+    //! Size of the state vectors.
+    std::size_t getStateSize( ) const
+    {
+        return stateSize_;
+    }
+
+    //! Size of the dependent variable vectors.
+    std::size_t getDependentVariableSize( ) const
+    {
+        return dependentVariableSize_;
+    }
+
+    //! Total number of epochs.
+    std::size_t getNumberOfEpochs( ) const
+    {
+        return numberOfEpochs_;
+    }
+
+    //! Index of the chunks.
+    const std::vector< ChunkIndexEntry >& getChunkIndex( ) const
+    {
+        return chunkIndex_;
+    }
+
+    //! Read a column (0 for the epochs, followed by the state entries and the dependent variables) of a chunk.
+    /*!
+     *  \param chunk Index of the chunk.
+     *  \param column Index of the column.
+     *  \param values Block to which the chunk's numberOfEpochs values are written.
+     */
+    void readColumn( const std::size_t chunk, const std::size_t column, double* values );
+
+private:
+
+    //! Path of the file.
+    std::string filePath_;
+
+    //! Input file.
+    std::ifstream file_;
+
+    //! Size of the state vectors.
+    std::size_t stateSize_;
+
+    //! Size of the dependent variable vectors.
+    std::size_t dependentVariableSize_;
+
+    //! Total number of epochs.
+    std::size_t numberOfEpochs_;
+
+    //! Index of the chunks.
+    std::vector< ChunkIndexEntry > chunkIndex_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_CHUNKED_OUTPUT_H
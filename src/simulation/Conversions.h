@@ -0,0 +1,241 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_CONVERSIONS_H
+#define TUDATPY_CONVERSIONS_H
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <boost/python.hpp>
+#include <boost/python/numpy.hpp>
+
+namespace tudatpy
+{
+
+//! Create a read-only NumPy view on a row-major block of doubles.
+/*!
+ *  No data is copied: the returned array points directly into C++ memory, and holds a reference to owner, so that the
+ *  memory stays valid for as long as the array (or any view derived from it) is alive.
+ *  \param data Pointer to the first element of the block.
+ *  \param numberOfRows Number of rows of the block.
+ *  \param numberOfColumns Number of columns of the block.
+ *  \param owner Python object that owns data.
+ *  \return Two-dimensional (numberOfRows x numberOfColumns) float64 array.
+ */
+inline boost::python::numpy::ndarray createArrayView(
+        const double* data, const std::size_t numberOfRows, const std::size_t numberOfColumns,
+        const boost::python::object& owner )
+{
+    namespace np = boost::python::numpy;
+    return np::from_data( data, np::dtype::get_builtin< double >( ),
+                          boost::python::make_tuple( numberOfRows, numberOfColumns ),
+                          boost::python::make_tuple( numberOfColumns * sizeof( double ), sizeof( double ) ),
+                          owner );
+}
+
+//! Create a read-only one-dimensional NumPy view on a contiguous block of doubles (see createArrayView).
+inline boost::python::numpy::ndarray createVectorView(
+        const double* data, const std::size_t size, const boost::python::object& owner )
+{
+    namespace np = boost::python::numpy;
+    return np::from_data( data, np::dtype::get_builtin< double >( ),
+                          boost::python::make_tuple( size ),
+                          boost::python::make_tuple( sizeof( double ) ),
+                          owner );
+}
+
+//! Create a new, uninitialized (numberOfRows x numberOfColumns) float64 array owned by NumPy.
+inline boost::python::numpy::ndarray createArray( const std::size_t numberOfRows, const std::size_t numberOfColumns )
+{
+    namespace np = boost::python::numpy;
+    return np::empty( boost::python::make_tuple( numberOfRows, numberOfColumns ), np::dtype::get_builtin< double >( ) );
+}
+
+//! Create a new, uninitialized one-dimensional float64 array owned by NumPy.
+inline boost::python::numpy::ndarray createArray( const std::size_t size )
+{
+    namespace np = boost::python::numpy;
+    return np::empty( boost::python::make_tuple( size ), np::dtype::get_builtin< double >( ) );
+}
+
+//! Create a new one-dimensional float64 array owned by NumPy, holding a copy of an Eigen vector.
+template< typename Derived >
+boost::python::numpy::ndarray createArray( const Eigen::MatrixBase< Derived >& vector )
+{
+    boost::python::numpy::ndarray array = createArray( static_cast< std::size_t >( vector.size( ) ) );
+    Eigen::Map< Eigen::VectorXd >( reinterpret_cast< double* >( array.get_data( ) ), vector.size( ) ) = vector;
+    return array;
+}
+
+//! Pointer to the (writable) data of an array created by createArray.
+inline double* getArrayData( const boost::python::numpy::ndarray& array )
+{
+    return reinterpret_cast< double* >( array.get_data( ) );
+}
+
+//! Read-only, C-contiguous float64 view of an arbitrary Python array-like (NumPy array, list, tuple, ...).
+/*!
+ *  The input is only copied when it is not already a C-contiguous, aligned float64 array. One-dimensional input is
+ *  interpreted as a single column when two dimensions are requested.
+ */
+class ContiguousArray
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param object Python array-like to view.
+     *  \param numberOfDimensions Number of dimensions (1 or 2) the input is interpreted with.
+     */
+    ContiguousArray( const boost::python::object& object, const int numberOfDimensions = 1 ):
+        array_( boost::python::numpy::from_object(
+                    object, boost::python::numpy::dtype::get_builtin< double >( ), 1, numberOfDimensions,
+                    boost::python::numpy::ndarray::C_CONTIGUOUS | boost::python::numpy::ndarray::ALIGNED ) )
+    { }
+
+    //! Pointer to the first element.
+    const double* data( ) const
+    {
+        return reinterpret_cast< const double* >( array_.get_data( ) );
+    }
+
+    //! Number of rows (number of elements for one-dimensional input).
+    std::size_t rows( ) const
+    {
+        return static_cast< std::size_t >( array_.shape( 0 ) );
+    }
+
+    //! Number of columns (one for one-dimensional input).
+    std::size_t columns( ) const
+    {
+        return array_.get_nd( ) > 1 ? static_cast< std::size_t >( array_.shape( 1 ) ) : 1;
+    }
+
+    //! Total number of elements.
+    std::size_t size( ) const
+    {
+        return rows( ) * columns( );
+    }
+
+private:
+
+    //! Contiguous array holding (or referencing) the data.
+    boost::python::numpy::ndarray array_;
+};
+
+//! Strided read-only view on a series of doubles; a stride of zero repeats a single value.
+struct StridedValues
+{
+    //! Pointer to the first value.
+    const double* data;
+
+    //! Distance between consecutive values.
+    std::size_t stride;
+
+    //! Value at the given index.
+    double operator[]( const std::size_t index ) const
+    {
+        return data[ index * stride ];
+    }
+};
+
+//! One-dimensional float64 input that is either an array of a given size, or a scalar broadcast to that size.
+class BroadcastArray
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param object Python scalar or array-like.
+     *  \param size Number of elements the input is broadcast to.
+     *  \param name Name of the input, used in error messages.
+     */
+    BroadcastArray( const boost::python::object& object, const std::size_t size, const std::string& name ):
+        array_( object )
+    {
+        if( array_.size( ) != 1 && array_.size( ) != size )
+        {
+            throw std::runtime_error( "Error, size of " + name + " is inconsistent with the other inputs" );
+        }
+        stride_ = array_.size( ) == 1 ? 0 : 1;
+    }
+
+    //! View on the values, which (unlike this object) may be used with the GIL released.
+    StridedValues getValues( ) const
+    {
+        StridedValues values = { array_.data( ), stride_ };
+        return values;
+    }
+
+private:
+
+    //! Contiguous input data.
+    ContiguousArray array_;
+
+    //! Distance between consecutive elements (zero for broadcast scalars).
+    std::size_t stride_;
+};
+
+//! Convert a Python array-like to an Eigen vector.
+inline Eigen::VectorXd extractVector( const boost::python::object& object )
+{
+    ContiguousArray array( object );
+    return Eigen::Map< const Eigen::VectorXd >( array.data( ), array.size( ) );
+}
+
+//! Convert a Python sequence to a std::vector.
+template< typename ValueType >
+std::vector< ValueType > extractList( const boost::python::object& sequence )
+{
+    std::vector< ValueType > values;
+    const long numberOfEntries = boost::python::len( sequence );
+    values.reserve( numberOfEntries );
+    for( long i = 0; i < numberOfEntries; i++ )
+    {
+        values.push_back( boost::python::extract< ValueType >( sequence[ i ] ) );
+    }
+    return values;
+}
+
+//! Convert a Python dict with string keys to a std::map.
+template< typename ValueType >
+std::map< std::string, ValueType > extractMap( const boost::python::dict& dictionary )
+{
+    std::map< std::string, ValueType > values;
+    const boost::python::list keys = dictionary.keys( );
+    for( long i = 0; i < boost::python::len( keys ); i++ )
+    {
+        const std::string key = boost::python::extract< std::string >( keys[ i ] );
+        values[ key ] = boost::python::extract< ValueType >( dictionary[ keys[ i ] ] );
+    }
+    return values;
+}
+
+//! Convert a std::map with string keys to a Python dict.
+template< typename ValueType >
+boost::python::dict createDict( const std::map< std::string, ValueType >& values )
+{
+    boost::python::dict dictionary;
+    for( auto valueIterator = values.begin( ); valueIterator != values.end( ); valueIterator++ )
+    {
+        dictionary[ valueIterator->first ] = valueIterator->second;
+    }
+    return dictionary;
+}
+
+} // namespace tudatpy
+
+#endif // TUDATPY_CONVERSIONS_H
@@ -0,0 +1,243 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <boost/python.hpp>
+
+#include "Conversions.h"
+#include "DenseOutput.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Number of epochs evaluated by a worker thread per task.
+const std::size_t epochsPerTask = 1024;
+
+//! Reverse the order of the rows of a row-major block.
+void reverseRows( std::vector< double >& values, const std::size_t numberOfColumns )
+{
+    const std::size_t numberOfRows = values.size( ) / numberOfColumns;
+    for( std::size_t i = 0; i < numberOfRows / 2; i++ )
+    {
+        std::swap_ranges( values.begin( ) + i * numberOfColumns, values.begin( ) + ( i + 1 ) * numberOfColumns,
+                          values.begin( ) + ( numberOfRows - 1 - i ) * numberOfColumns );
+    }
+}
+
+} // namespace
+
+void DenseTrajectory::append( const double epoch, const Eigen::VectorXd& state, const Eigen::VectorXd& stateDerivative )
+{
+    if( epochs_.empty( ) )
+    {
+        if( state.rows( ) == 0 || state.rows( ) % 6 != 0 )
+        {
+            throw std::runtime_error( "Error when creating dense trajectory, states must consist of Cartesian states" );
+        }
+        stateSize_ = state.rows( );
+    }
+    else if( epoch == epochs_.back( ) )
+    {
+        // A zero-length step holds no trajectory, and could not be interpolated.
+        return;
+    }
+    else if( epochs_.size( ) > 1 && ( epoch > epochs_.back( ) ) != ( epochs_.back( ) > epochs_.front( ) ) )
+    {
+        throw std::runtime_error( "Error when creating dense trajectory, epochs must be monotonic" );
+    }
+    epochs_.push_back( epoch );
+    states_.insert( states_.end( ), state.data( ), state.data( ) + stateSize_ );
+    stateDerivatives_.insert( stateDerivatives_.end( ), stateDerivative.data( ), stateDerivative.data( ) + stateSize_ );
+}
+
+void DenseTrajectory::finalize( )
+{
+    if( epochs_.size( ) > 1 && epochs_.front( ) > epochs_.back( ) )
+    {
+        std::reverse( epochs_.begin( ), epochs_.end( ) );
+        reverseRows( states_, stateSize_ );
+        reverseRows( stateDerivatives_, stateSize_ );
+    }
+}
+
+void DenseTrajectory::evaluate( const double epoch, double* state ) const
+{
+    if( epochs_.empty( ) || !( epoch >= epochs_.front( ) && epoch <= epochs_.back( ) ) )
+    {
+        throw std::runtime_error( "Error when evaluating dense trajectory, epoch " + std::to_string( epoch ) +
+                                  " is outside the propagated interval" );
+    }
+    if( epochs_.size( ) == 1 )
+    {
+        std::copy( states_.begin( ), states_.end( ), state );
+        return;
+    }
+
+    // Step containing the epoch, of which the end is the first integrated epoch after it.
+    const std::size_t nextEpochIndex = std::upper_bound( epochs_.begin( ), epochs_.end( ), epoch ) - epochs_.begin( );
+    const std::size_t step = std::min( nextEpochIndex, epochs_.size( ) - 1 ) - 1;
+    const double stepSize = epochs_[ step + 1 ] - epochs_[ step ];
+    const double s = ( epoch - epochs_[ step ] ) / stepSize;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double s4 = s3 * s;
+    const double s5 = s4 * s;
+
+    // Quintic Hermite basis functions for the positions at the start and end (h0, h5), velocities (h1, h4) and
+    // accelerations (h2, h3), and their derivatives w.r.t. s.
+    const double h0 = 1.0 - 10.0 * s3 + 15.0 * s4 - 6.0 * s5;
+    const double h1 = s - 6.0 * s3 + 8.0 * s4 - 3.0 * s5;
+    const double h2 = 0.5 * ( s2 - 3.0 * s3 + 3.0 * s4 - s5 );
+    const double h3 = 0.5 * ( s3 - 2.0 * s4 + s5 );
+    const double h4 = -4.0 * s3 + 7.0 * s4 - 3.0 * s5;
+    const double h5 = 10.0 * s3 - 15.0 * s4 + 6.0 * s5;
+    const double dh0 = -30.0 * s2 + 60.0 * s3 - 30.0 * s4;
+    const double dh1 = 1.0 - 18.0 * s2 + 32.0 * s3 - 15.0 * s4;
+    const double dh2 = 0.5 * ( 2.0 * s - 9.0 * s2 + 12.0 * s3 - 5.0 * s4 );
+    const double dh3 = 0.5 * ( 3.0 * s2 - 8.0 * s3 + 5.0 * s4 );
+    const double dh4 = -12.0 * s2 + 28.0 * s3 - 15.0 * s4;
+    const double dh5 = 30.0 * s2 - 60.0 * s3 + 30.0 * s4;
+
+    const double* startState = states_.data( ) + step * stateSize_;
+    const double* endState = startState + stateSize_;
+    const double* startDerivative = stateDerivatives_.data( ) + step * stateSize_;
+    const double* endDerivative = startDerivative + stateSize_;
+    for( std::size_t body = 0; body < stateSize_; body += 6 )
+    {
+        for( std::size_t i = body; i < body + 3; i++ )
+        {
+            const double startPosition = startState[ i ], endPosition = endState[ i ];
+            const double startVelocity = startState[ i + 3 ], endVelocity = endState[ i + 3 ];
+            const double startAcceleration = startDerivative[ i + 3 ], endAcceleration = endDerivative[ i + 3 ];
+            state[ i ] = h0 * startPosition + h5 * endPosition +
+                    stepSize * ( h1 * startVelocity + h4 * endVelocity ) +
+                    stepSize * stepSize * ( h2 * startAcceleration + h3 * endAcceleration );
+            state[ i + 3 ] = ( dh0 * startPosition + dh5 * endPosition ) / stepSize +
+                    dh1 * startVelocity + dh4 * endVelocity +
+                    stepSize * ( dh2 * startAcceleration + dh3 * endAcceleration );
+        }
+    }
+}
+
+void DenseTrajectory::evaluate( const std::size_t numberOfEpochs, const double* epochs, double* states,
+                                const unsigned int numberOfThreads ) const
+{
+    const std::size_t numberOfTasks = ( numberOfEpochs + epochsPerTask - 1 ) / epochsPerTask;
+    parallelFor( numberOfTasks, getNumberOfThreads( numberOfThreads, numberOfTasks ),
+                 [ & ]( const std::size_t taskIndex, const unsigned int )
+    {
+        const std::size_t lastEpoch = std::min( numberOfEpochs, ( taskIndex + 1 ) * epochsPerTask );
+        for( std::size_t i = taskIndex * epochsPerTask; i < lastEpoch; i++ )
+        {
+            evaluate( epochs[ i ], states + i * stateSize_ );
+        }
+    } );
+}
+
+DenseOutputSink::DenseOutputSink( DenseTrajectory& trajectory,
+                                  SingleArcDynamicsSimulator< double, double >& simulator ):
+    trajectory_( trajectory ), stateDerivativeModel_( simulator.getDynamicsStateDerivative( ) )
+{
+    const std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            std::dynamic_pointer_cast< TranslationalStatePropagatorSettings< double > >(
+                simulator.getPropagatorSettings( ) );
+    if( propagatorSettings == nullptr || propagatorSettings->propagator_ != cowell )
+    {
+        throw std::runtime_error( "Error when creating dense trajectory, only translational dynamics with the Cowell "
+                                  "propagator are supported" );
+    }
+}
+
+void DenseOutputSink::append( const double epoch, const Eigen::VectorXd& state,
+                              const Eigen::VectorXd& /*dependentVariables*/ )
+{
+    trajectory_.append( epoch, state, stateDerivativeModel_->computeStateDerivative( epoch, state ) );
+}
+
+namespace
+{
+
+object evaluateDenseTrajectory( const DenseTrajectory& trajectory, const object& epochs,
+                                const unsigned int numberOfThreads )
+{
+    extract< double > scalarEpoch( epochs );
+    if( scalarEpoch.check( ) && !extract< numpy::ndarray >( epochs ).check( ) )
+    {
+        numpy::ndarray state = createArray( trajectory.getStateSize( ) );
+        trajectory.evaluate( scalarEpoch( ), getArrayData( state ) );
+        return state;
+    }
+
+    const ContiguousArray epochArray( epochs );
+    numpy::ndarray states = createArray( epochArray.size( ), trajectory.getStateSize( ) );
+    double* stateData = getArrayData( states );
+    {
+        ScopedGilRelease gilRelease;
+        trajectory.evaluate( epochArray.size( ), epochArray.data( ), stateData, numberOfThreads );
+    }
+    return states;
+}
+
+// As for the state history of a simulator, the views reference memory owned by the trajectory object.
+object getTrajectoryStates( const object& self )
+{
+    const DenseTrajectory& trajectory = extract< const DenseTrajectory& >( self )( );
+    return createArrayView( trajectory.getStates( ).data( ), trajectory.size( ), trajectory.getStateSize( ), self );
+}
+
+object getTrajectoryEpochs( const object& self )
+{
+    const DenseTrajectory& trajectory = extract< const DenseTrajectory& >( self )( );
+    return createVectorView( trajectory.getEpochs( ).data( ), trajectory.size( ), self );
+}
+
+double getInitialEpoch( const DenseTrajectory& trajectory )
+{
+    return trajectory.getEpochs( ).front( );
+}
+
+double getFinalEpoch( const DenseTrajectory& trajectory )
+{
+    return trajectory.getEpochs( ).back( );
+}
+
+} // namespace
+
+void exposeDenseOutput( )
+{
+    class_< DenseTrajectory, std::shared_ptr< DenseTrajectory > >( "DenseTrajectory", no_init )
+            .def( "evaluate", &evaluateDenseTrajectory, ( arg( "epochs" ), arg( "number_of_threads" ) = 0 ),
+                  "Cartesian states at an epoch, or, for an array of N epochs, an (N x state size) array of states\n"
+                  "evaluated natively on number_of_threads threads (0 for all hardware threads) with the GIL\n"
+                  "released. Epochs must lie within the propagated interval." )
+            .def( "__call__", &evaluateDenseTrajectory, ( arg( "epochs" ), arg( "number_of_threads" ) = 0 ) )
+            .add_property( "states", &getTrajectoryStates,
+                           "States at the integrated epochs as a read-only (N x state size) array, sharing memory\n"
+                           "with this object." )
+            .add_property( "epochs", &getTrajectoryEpochs,
+                           "Integrated epochs, in increasing order, sharing memory with this object." )
+            .add_property( "initial_epoch", &getInitialEpoch )
+            .add_property( "final_epoch", &getFinalEpoch )
+            .def( "__len__", &DenseTrajectory::size )
+            ;
+}
+
+} // namespace tudatpy
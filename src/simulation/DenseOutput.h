@@ -0,0 +1,153 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_DENSE_OUTPUT_H
+#define TUDATPY_DENSE_OUTPUT_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+#include "PropagationLoop.h"
+
+namespace tudatpy
+{
+
+//! Propagated translational trajectory that can be evaluated at any epoch within the propagation.
+/*!
+ *  Stores the Cartesian states and accelerations at the integrated epochs. In between, the positions of each body are
+ *  found by quintic Hermite interpolation of the positions, velocities and accelerations at the ends of the step, and
+ *  the velocities as the derivative of that polynomial, so that the interpolation error is of the same order as that
+ *  of a high-order integrator at its own step size. The step containing an epoch is found by bisection. Evaluation
+ *  does not modify the object, so that it may be done from several threads.
+ */
+class DenseTrajectory
+{
+public:
+
+    //! Constructor for an empty trajectory.
+    DenseTrajectory( ): stateSize_( 0 ) { }
+
+    //! Append an integrated epoch, after the last one.
+    /*!
+     *  An epoch equal to the last one (a step of zero length) is skipped.
+     *  \param epoch Epoch, later (or, for a backward propagation, earlier) than the last one.
+     *  \param state Cartesian states (position and velocity) of all bodies at the epoch.
+     *  \param stateDerivative Time derivative of state.
+     *  \throws std::runtime_error If the epochs are not monotonic.
+     */
+    void append( const double epoch, const Eigen::VectorXd& state, const Eigen::VectorXd& stateDerivative );
+
+    //! Called after the last epoch has been appended; orders the epochs of a backward propagation.
+    void finalize( );
+
+    //! Evaluate the states at an epoch.
+    /*!
+     *  \param epoch Epoch, between the first and last integrated epochs.
+     *  \param state Block of getStateSize( ) values to which the states are written.
+     */
+    void evaluate( const double epoch, double* state ) const;
+
+    //! Evaluate the states at a series of epochs.
+    /*!
+     *  The epochs are split into blocks that are distributed over the worker threads. Does not touch any Python
+     *  object, so that it may be called with the GIL released.
+     *  \param numberOfEpochs Number of epochs.
+     *  \param epochs Epochs, between the first and last integrated epochs (in any order).
+     *  \param states Row-major (numberOfEpochs x getStateSize( )) block to which the states are written.
+     *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+     */
+    void evaluate( const std::size_t numberOfEpochs, const double* epochs, double* states,
+                   const unsigned int numberOfThreads ) const;
+
+    //! Number of integrated epochs.
+    std::size_t size( ) const
+    {
+        return epochs_.size( );
+    }
+
+    //! Size of a single state vector.
+    std::size_t getStateSize( ) const
+    {
+        return stateSize_;
+    }
+
+    //! Integrated epochs, in increasing order.
+    const std::vector< double >& getEpochs( ) const
+    {
+        return epochs_;
+    }
+
+    //! States at the integrated epochs, as a row-major (size( ) x getStateSize( )) block.
+    const std::vector< double >& getStates( ) const
+    {
+        return states_;
+    }
+
+private:
+
+    //! Integrated epochs.
+    std::vector< double > epochs_;
+
+    //! States at the integrated epochs (row-major).
+    std::vector< double > states_;
+
+    //! Time derivatives of the states at the integrated epochs (row-major).
+    std::vector< double > stateDerivatives_;
+
+    //! Size of a single state vector.
+    std::size_t stateSize_;
+};
+
+//! Output sink storing the output of a propagation in a dense trajectory.
+/*!
+ *  The state derivative at every integrated epoch is evaluated with the state derivative model of the simulator,
+ *  since the Tudat integrators do not expose the evaluations of their stages.
+ */
+class DenseOutputSink: public PropagationOutputSink
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param trajectory Trajectory to which the output is appended.
+     *  \param simulator Simulator of the propagation, which must propagate translational dynamics with the Cowell
+     *  propagator (so that its state derivative is that of the conventional state).
+     *  \throws std::runtime_error For other dynamics or propagators, so that the sink is rejected before propagating.
+     */
+    DenseOutputSink( DenseTrajectory& trajectory,
+                     tudat::propagators::SingleArcDynamicsSimulator< double, double >& simulator );
+
+    void initialize( const std::size_t /*stateSize*/, const std::size_t /*dependentVariableSize*/ )
+    {
+        trajectory_ = DenseTrajectory( );
+    }
+
+    void append( const double epoch, const Eigen::VectorXd& state, const Eigen::VectorXd& dependentVariables );
+
+    void finalize( )
+    {
+        trajectory_.finalize( );
+    }
+
+private:
+
+    //! Trajectory to which the output is appended.
+    DenseTrajectory& trajectory_;
+
+    //! State derivative model of the simulator.
+    std::shared_ptr< tudat::propagators::DynamicsStateDerivativeModel< double, double > > stateDerivativeModel_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_DENSE_OUTPUT_H
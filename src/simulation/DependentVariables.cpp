@@ -0,0 +1,98 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include "Tudat/SimulationSetup/PropagationSetup/propagationOutput.h"
+
+#include "DependentVariables.h"
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+std::shared_ptr< SingleArcPropagatorSettings< double > > createSettingsWithoutDependentVariables(
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings )
+{
+    const std::shared_ptr< TranslationalStatePropagatorSettings< double > > translationalSettings =
+            std::dynamic_pointer_cast< TranslationalStatePropagatorSettings< double > >( propagatorSettings );
+    if( translationalSettings == nullptr )
+    {
+        throw std::runtime_error( "Error when deferring dependent variables, only translational dynamics are "
+                                  "supported" );
+    }
+    return std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                translationalSettings->centralBodies_, translationalSettings->accelerationsMap_,
+                translationalSettings->bodiesToIntegrate_, translationalSettings->getInitialStates( ),
+                translationalSettings->getTerminationSettings( ), translationalSettings->propagator_ );
+}
+
+DependentVariableReconstructor::DependentVariableReconstructor(
+        const NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings ):
+    simulator_( std::make_shared< SingleArcDynamicsSimulator< double, double > >(
+                    bodyMap, integratorSettings, propagatorSettings, false ) )
+{
+    if( simulator_->getPropagatorSettings( )->getDependentVariablesToSave( ) == nullptr )
+    {
+        throw std::runtime_error( "Error when creating dependent variable computation, no dependent variables are "
+                                  "to be saved" );
+    }
+    dependentVariableFunction_ = createDependentVariableListFunction< double, double >(
+                simulator_->getPropagatorSettings( )->getDependentVariablesToSave( ), bodyMap,
+                simulator_->getDynamicsStateDerivative( )->getStateDerivativeModels( ) ).first;
+}
+
+Eigen::VectorXd DependentVariableReconstructor::computeDependentVariables( const double epoch,
+                                                                           const Eigen::VectorXd& state )
+{
+    // As during the propagation, the environment at the epoch is updated by evaluating the state derivative.
+    const std::shared_ptr< DynamicsStateDerivativeModel< double, double > > stateDerivativeModel =
+            simulator_->getDynamicsStateDerivative( );
+    stateDerivativeModel->computeStateDerivative(
+                epoch, stateDerivativeModel->convertFromOutputSolution( state, epoch ) );
+    return dependentVariableFunction_( );
+}
+
+StateHistory DependentVariableReconstructor::computeDependentVariableHistory( const StateHistory& stateHistory )
+{
+    StateHistory dependentVariableHistory;
+    for( std::size_t i = 0; i < stateHistory.size( ); i++ )
+    {
+        const Eigen::VectorXd dependentVariables = computeDependentVariables(
+                    stateHistory.getEpochs( )[ i ],
+                    Eigen::Map< const Eigen::VectorXd >( stateHistory.getState( i ), stateHistory.getStateSize( ) ) );
+        dependentVariableHistory.append( stateHistory.getEpochs( )[ i ], dependentVariables );
+
+        // The size of the dependent variables is only known after the first evaluation.
+        if( i == 0 )
+        {
+            dependentVariableHistory.reserve( stateHistory.size( ) );
+        }
+    }
+    return dependentVariableHistory;
+}
+
+void DependentVariableOutputSink::append( const double epoch, const Eigen::VectorXd& state,
+                                          const Eigen::VectorXd& /*dependentVariables*/ )
+{
+    const Eigen::VectorXd computedDependentVariables = reconstructor_.computeDependentVariables( epoch, state );
+    if( !isInitialized_ )
+    {
+        outputSink_.initialize( stateSize_, computedDependentVariables.rows( ) );
+        isInitialized_ = true;
+    }
+    outputSink_.append( epoch, state, computedDependentVariables );
+}
+
+} // namespace tudatpy
@@ -0,0 +1,130 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_DEPENDENT_VARIABLES_H
+#define TUDATPY_DEPENDENT_VARIABLES_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+#include "PropagationLoop.h"
+#include "StateHistory.h"
+
+namespace tudatpy
+{
+
+//! Create a copy of translational propagator settings without dependent variables.
+/*!
+ *  A simulator created from the copy only updates the environment models required by the state derivative and the
+ *  termination conditions, so that the dependent variables do not add to the cost of the integrator stages.
+ *  \param propagatorSettings Settings to copy, which must be translational.
+ *  \return Copy of the settings, sharing the acceleration models and termination settings.
+ */
+std::shared_ptr< tudat::propagators::SingleArcPropagatorSettings< double > > createSettingsWithoutDependentVariables(
+        const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings );
+
+//! Computation of the dependent variables of a propagation from its (conventional) states, after the integration.
+/*!
+ *  Uses a separate, non-integrating Tudat simulator created from the complete propagator settings, of which the
+ *  environment updater includes the models required by the dependent variables (such as the flight conditions). The
+ *  environment is updated at an epoch by evaluating the state derivative of that simulator, after which the dependent
+ *  variables are read from it. Evaluation modifies the states of the bodies, so it must not be done concurrently with
+ *  a propagation using the same bodies.
+ */
+class DependentVariableReconstructor
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param bodyMap Bodies used in the propagation.
+     *  \param integratorSettings Settings of the numerical integrator of the propagation.
+     *  \param propagatorSettings Settings of the propagation, including the dependent variables to compute.
+     */
+    DependentVariableReconstructor(
+            const tudat::simulation_setup::NamedBodyMap& bodyMap,
+            const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+            const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings );
+
+    //! Compute the dependent variables at a single epoch.
+    /*!
+     *  \param epoch Epoch of the state.
+     *  \param state Conventional state at the epoch.
+     *  \return Dependent variables at the epoch.
+     */
+    Eigen::VectorXd computeDependentVariables( const double epoch, const Eigen::VectorXd& state );
+
+    //! Compute the dependent variable history at the epochs of a state history.
+    StateHistory computeDependentVariableHistory( const StateHistory& stateHistory );
+
+private:
+
+    //! Non-integrating simulator, providing the state derivative model and the complete environment updater.
+    std::shared_ptr< tudat::propagators::SingleArcDynamicsSimulator< double, double > > simulator_;
+
+    //! Function returning the dependent variables from the current environment.
+    std::function< Eigen::VectorXd( ) > dependentVariableFunction_;
+};
+
+//! Output sink computing the dependent variables at every appended epoch, and passing them on to another sink.
+/*!
+ *  Used for propagations of which the simulator computes no dependent variables (see
+ *  createSettingsWithoutDependentVariables), so that the environment required by the dependent variables is only
+ *  updated at the output epochs, instead of at every integrator stage.
+ */
+class DependentVariableOutputSink: public PropagationOutputSink
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param reconstructor Computation of the dependent variables.
+     *  \param outputSink Sink receiving the states and dependent variables.
+     */
+    DependentVariableOutputSink( DependentVariableReconstructor& reconstructor, PropagationOutputSink& outputSink ):
+        reconstructor_( reconstructor ), outputSink_( outputSink ), stateSize_( 0 ), isInitialized_( false )
+    { }
+
+    //! Called once, before the first state is appended; the sink receiving the output is initialized on the first
+    //! append, when the size of the dependent variables is known.
+    void initialize( const std::size_t stateSize, const std::size_t /*dependentVariableSize*/ )
+    {
+        stateSize_ = stateSize;
+        isInitialized_ = false;
+    }
+
+    void append( const double epoch, const Eigen::VectorXd& state, const Eigen::VectorXd& dependentVariables );
+
+    void finalize( )
+    {
+        outputSink_.finalize( );
+    }
+
+private:
+
+    //! Computation of the dependent variables.
+    DependentVariableReconstructor& reconstructor_;
+
+    //! Sink receiving the states and dependent variables.
+    PropagationOutputSink& outputSink_;
+
+    //! Size of the conventional state vectors.
+    std::size_t stateSize_;
+
+    //! Whether outputSink_ was initialized.
+    bool isInitialized_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_DEPENDENT_VARIABLES_H
@@ -0,0 +1,482 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "ChunkedOutput.h"
+#include "Conversions.h"
+#include "DenseOutput.h"
+#include "DynamicsSimulator.h"
+#include "FixedSizePropagation.h"
+#include "FrozenBodyMap.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Whether propagator settings include dependent variables to save.
+bool areDependentVariablesSaved( const std::shared_ptr< PropagatorSettings< double > > propagatorSettings )
+{
+    const std::shared_ptr< SingleArcPropagatorSettings< double > > singleArcSettings =
+            std::dynamic_pointer_cast< SingleArcPropagatorSettings< double > >( propagatorSettings );
+    return singleArcSettings != nullptr && singleArcSettings->getDependentVariablesToSave( ) != nullptr;
+}
+
+//! Settings with which the Tudat simulator is created, which exclude deferred dependent variables.
+std::shared_ptr< PropagatorSettings< double > > getSimulatorPropagatorSettings(
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+        const bool areDependentVariablesDeferred )
+{
+    if( areDependentVariablesDeferred && areDependentVariablesSaved( propagatorSettings ) )
+    {
+        return createSettingsWithoutDependentVariables( propagatorSettings );
+    }
+    return propagatorSettings;
+}
+
+} // namespace
+
+SingleArcSimulation::SingleArcSimulation(
+        const NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+        const bool areEquationsOfMotionToBeIntegrated, const HistoryStorage historyStorage, const bool isProfiled,
+        const bool areDependentVariablesDeferred ):
+    bodyMap_( bodyMap ),
+    simulator_( std::make_shared< SingleArcDynamicsSimulator< double, double > >(
+                    bodyMap, integratorSettings,
+                    getSimulatorPropagatorSettings( propagatorSettings, areDependentVariablesDeferred ),
+                    areEquationsOfMotionToBeIntegrated && historyStorage == map_history_storage && !isProfiled ) ),
+    historyStorage_( historyStorage ),
+    isPropagatedUponConstruction_( areEquationsOfMotionToBeIntegrated ),
+    stateHistory_( std::make_shared< StateHistory >( ) ),
+    dependentVariableHistory_( std::make_shared< StateHistory >( ) ),
+    isStateHistoryUpToDate_( false )
+{
+    if( areDependentVariablesDeferred && areDependentVariablesSaved( propagatorSettings ) )
+    {
+        dependentVariableReconstructor_ = std::make_shared< DependentVariableReconstructor >(
+                    bodyMap_, integratorSettings, propagatorSettings );
+    }
+
+    if( isProfiled )
+    {
+        profiler_ = std::make_shared< PropagationProfiler >( *simulator_, bodyMap_ );
+    }
+
+    if( areEquationsOfMotionToBeIntegrated && ( historyStorage_ == contiguous_history_storage || isProfiled ) )
+    {
+        integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) );
+    }
+    else if( areEquationsOfMotionToBeIntegrated )
+    {
+        // Propagated by the Tudat simulator upon its construction.
+        computeDeferredDependentVariables( );
+    }
+}
+
+void SingleArcSimulation::integrateEquationsOfMotion( const Eigen::VectorXd& initialStates )
+{
+    isStateHistoryUpToDate_ = false;
+    // Profiled propagations are run by propagateToSink, and thus stored contiguously regardless of historyStorage_.
+    if( historyStorage_ == contiguous_history_storage || profiler_ != nullptr )
+    {
+        stateHistory_ = std::make_shared< StateHistory >( );
+        dependentVariableHistory_ = std::make_shared< StateHistory >( );
+        HistoryOutputSink outputSink( *stateHistory_, *dependentVariableHistory_ );
+        propagateToSink( *simulator_, bodyMap_, initialStates, outputSink, profiler_.get( ) );
+        isStateHistoryUpToDate_ = true;
+    }
+    else
+    {
+        simulator_->integrateEquationsOfMotion( initialStates );
+    }
+    computeDeferredDependentVariables( );
+}
+
+void SingleArcSimulation::integrateEquationsOfMotion( const Eigen::VectorXd& initialStates,
+                                                      PropagationOutputSink& outputSink )
+{
+    if( dependentVariableReconstructor_ != nullptr )
+    {
+        DependentVariableOutputSink dependentVariableSink( *dependentVariableReconstructor_, outputSink );
+        propagateToSink( *simulator_, bodyMap_, initialStates, dependentVariableSink, profiler_.get( ) );
+    }
+    else
+    {
+        propagateToSink( *simulator_, bodyMap_, initialStates, outputSink, profiler_.get( ) );
+    }
+}
+
+void SingleArcSimulation::integrateEquationsOfMotion( const Eigen::VectorXd& initialStates,
+                                                      PropagationCheckpointer& checkpointer )
+{
+    isStateHistoryUpToDate_ = false;
+    stateHistory_ = std::make_shared< StateHistory >( );
+    dependentVariableHistory_ = std::make_shared< StateHistory >( );
+    HistoryOutputSink outputSink( *stateHistory_, *dependentVariableHistory_ );
+    propagateToSink( *simulator_, bodyMap_, initialStates, outputSink, profiler_.get( ), &checkpointer );
+    isStateHistoryUpToDate_ = true;
+    computeDeferredDependentVariables( );
+}
+
+std::shared_ptr< const StateHistory > SingleArcSimulation::getStateHistory( )
+{
+    if( !isStateHistoryUpToDate_ )
+    {
+        stateHistory_ = std::make_shared< StateHistory >( simulator_->getEquationsOfMotionNumericalSolution( ) );
+        dependentVariableHistory_ = std::make_shared< StateHistory >( simulator_->getDependentVariableHistory( ) );
+        isStateHistoryUpToDate_ = true;
+    }
+    return stateHistory_;
+}
+
+std::shared_ptr< const StateHistory > SingleArcSimulation::getDependentVariableHistory( )
+{
+    getStateHistory( );
+    return dependentVariableHistory_;
+}
+
+void SingleArcSimulation::computeDeferredDependentVariables( )
+{
+    // Computed right after the propagation, before the environment can be modified.
+    if( dependentVariableReconstructor_ != nullptr )
+    {
+        getStateHistory( );
+        dependentVariableHistory_ = std::make_shared< StateHistory >(
+                    dependentVariableReconstructor_->computeDependentVariableHistory( *stateHistory_ ) );
+    }
+}
+
+namespace
+{
+
+std::shared_ptr< SingleArcSimulation > createSingleArcSimulation(
+        const NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+        const bool areEquationsOfMotionToBeIntegrated, const HistoryStorage historyStorage, const bool isProfiled,
+        const bool areDependentVariablesDeferred )
+{
+    return std::make_shared< SingleArcSimulation >( bodyMap, integratorSettings, propagatorSettings,
+                                                    areEquationsOfMotionToBeIntegrated, historyStorage, isProfiled,
+                                                    areDependentVariablesDeferred );
+}
+
+void integrateEquationsOfMotion( SingleArcSimulation& simulation, const object& initialStates )
+{
+    simulation.integrateEquationsOfMotion( extractVector( initialStates ) );
+}
+
+// The propagations below release the GIL, unless the bodies may call SPICE, which is not thread-safe.
+void integrateEquationsOfMotionToFile( SingleArcSimulation& simulation, const object& initialStates,
+                                       const std::string& filePath, const std::size_t chunkSize )
+{
+    // Else, the propagation was already run, and its history stored, upon construction.
+    if( simulation.isPropagatedUponConstruction( ) )
+    {
+        throw std::runtime_error( "Error when propagating to file, simulator must be created with "
+                                  "are_equations_of_motion_to_be_integrated=False" );
+    }
+    const Eigen::VectorXd initialStateVector = extractVector( initialStates );
+    ChunkedOutputWriter outputWriter( filePath, chunkSize );
+    {
+        ScopedGilRelease gilRelease( !usesSpice( simulation.getBodyMap( ) ) );
+        simulation.integrateEquationsOfMotion( initialStateVector, outputWriter );
+    }
+}
+
+void integrateEquationsOfMotionWithCheckpoints( SingleArcSimulation& simulation, const object& initialStates,
+                                                const std::string& checkpointPath, const double checkpointInterval )
+{
+    const Eigen::VectorXd initialStateVector = extractVector( initialStates );
+    PropagationCheckpointFile checkpointer( checkpointPath, checkpointInterval,
+                                            simulation.getSimulator( )->getIntegratorSettings( ),
+                                            simulation.getSimulator( )->getPropagatorSettings( ) );
+    {
+        ScopedGilRelease gilRelease( !usesSpice( simulation.getBodyMap( ) ) );
+        simulation.integrateEquationsOfMotion( initialStateVector, checkpointer );
+    }
+}
+
+std::shared_ptr< DenseTrajectory > integrateEquationsOfMotionDense( SingleArcSimulation& simulation,
+                                                                   const object& initialStates )
+{
+    const Eigen::VectorXd initialStateVector = extractVector( initialStates );
+    std::shared_ptr< DenseTrajectory > trajectory = std::make_shared< DenseTrajectory >( );
+    DenseOutputSink outputSink( *trajectory, *simulation.getSimulator( ) );
+    {
+        ScopedGilRelease gilRelease( !usesSpice( simulation.getBodyMap( ) ) );
+        simulation.integrateEquationsOfMotion( initialStateVector, outputSink );
+    }
+    return trajectory;
+}
+
+std::shared_ptr< StateHistory > propagateFixedSize(
+        const NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings )
+{
+    std::shared_ptr< StateHistory > stateHistory = std::make_shared< StateHistory >( );
+    {
+        ScopedGilRelease gilRelease( !usesSpice( bodyMap ) );
+        *stateHistory = propagateFixedSizeTranslationalDynamics( bodyMap, integratorSettings, propagatorSettings );
+    }
+    return stateHistory;
+}
+
+// The views below reference the history of the last propagation. Their owner is a Python object holding (a reference
+// to) that history rather than the simulator, so that the views remain valid when the simulator propagates again.
+object getStateHistory( SingleArcSimulation& simulation )
+{
+    const std::shared_ptr< const StateHistory > stateHistory = simulation.getStateHistory( );
+    return createArrayView( stateHistory->getStates( ).data( ), stateHistory->size( ), stateHistory->getStateSize( ),
+                            object( stateHistory ) );
+}
+
+object getStateHistoryEpochs( SingleArcSimulation& simulation )
+{
+    const std::shared_ptr< const StateHistory > stateHistory = simulation.getStateHistory( );
+    return createVectorView( stateHistory->getEpochs( ).data( ), stateHistory->size( ), object( stateHistory ) );
+}
+
+object getDependentVariableHistory( SingleArcSimulation& simulation )
+{
+    const std::shared_ptr< const StateHistory > dependentVariableHistory = simulation.getDependentVariableHistory( );
+    return createArrayView( dependentVariableHistory->getStates( ).data( ), dependentVariableHistory->size( ),
+                            dependentVariableHistory->getStateSize( ), object( dependentVariableHistory ) );
+}
+
+const PropagationProfiler& getProfiler( const SingleArcSimulation& simulation )
+{
+    if( simulation.getProfiler( ) == nullptr )
+    {
+        throw std::runtime_error(
+                    "Error when retrieving propagation profile, simulator was not created with profile=True" );
+    }
+    return *simulation.getProfiler( );
+}
+
+dict convertProfileCounter( const ProfileCounter& counter )
+{
+    dict counterDictionary;
+    counterDictionary[ "calls" ] = counter.numberOfCalls;
+    counterDictionary[ "total_ns" ] = counter.nanoseconds;
+    counterDictionary[ "mean_ns" ] = counter.numberOfCalls > 0 ?
+                static_cast< double >( counter.nanoseconds ) / counter.numberOfCalls : 0.0;
+    return counterDictionary;
+}
+
+dict getProfile( const SingleArcSimulation& simulation )
+{
+    const PropagationProfile profile = getProfiler( simulation ).getProfile( );
+
+    list accelerations;
+    for( unsigned int i = 0; i < profile.accelerations.size( ); i++ )
+    {
+        dict acceleration = convertProfileCounter( profile.accelerations.at( i ).counter );
+        acceleration[ "body_undergoing_acceleration" ] = profile.accelerations.at( i ).bodyUndergoingAcceleration;
+        acceleration[ "body_exerting_acceleration" ] = profile.accelerations.at( i ).bodyExertingAcceleration;
+        acceleration[ "acceleration_type" ] = profile.accelerations.at( i ).accelerationType;
+        accelerations.append( acceleration );
+    }
+
+    dict profileDictionary;
+    profileDictionary[ "accelerations" ] = accelerations;
+    profileDictionary[ "environment_update" ] = convertProfileCounter( profile.environmentUpdate );
+    profileDictionary[ "integrator_stages" ] = convertProfileCounter( profile.integratorStages );
+    profileDictionary[ "output" ] = convertProfileCounter( profile.output );
+    profileDictionary[ "accepted_steps" ] = profile.numberOfAcceptedSteps;
+    profileDictionary[ "rejected_steps" ] = profile.numberOfRejectedSteps;
+    profileDictionary[ "total_ns" ] = profile.totalNanoseconds;
+    return profileDictionary;
+}
+
+std::string getProfileReport( const SingleArcSimulation& simulation )
+{
+    return formatPropagationProfile( getProfiler( simulation ).getProfile( ) );
+}
+
+object getStates( const object& self )
+{
+    const StateHistory& stateHistory = extract< const StateHistory& >( self )( );
+    return createArrayView( stateHistory.getStates( ).data( ), stateHistory.size( ), stateHistory.getStateSize( ),
+                            self );
+}
+
+object getEpochs( const object& self )
+{
+    const StateHistory& stateHistory = extract< const StateHistory& >( self )( );
+    return createVectorView( stateHistory.getEpochs( ).data( ), stateHistory.size( ), self );
+}
+
+std::size_t getNumberOfChunks( const ChunkedOutputReader& reader )
+{
+    return reader.getChunkIndex( ).size( );
+}
+
+// Columns are read into the rows of a (columns x epochs) array, which is returned transposed (as a view).
+object readChunkColumns( ChunkedOutputReader& reader, const std::size_t chunk, const std::size_t firstColumn,
+                         const std::size_t numberOfColumns )
+{
+    const std::size_t numberOfEpochs = reader.getChunkIndex( ).at( chunk ).numberOfEpochs;
+    numpy::ndarray values = createArray( numberOfColumns, numberOfEpochs );
+    for( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        reader.readColumn( chunk, firstColumn + i, getArrayData( values ) + i * numberOfEpochs );
+    }
+    return values.transpose( );
+}
+
+tuple readChunk( ChunkedOutputReader& reader, const std::size_t chunk )
+{
+    if( chunk >= reader.getChunkIndex( ).size( ) )
+    {
+        PyErr_SetString( PyExc_IndexError, "chunk index out of range" );
+        throw_error_already_set( );
+    }
+    numpy::ndarray epochs = createArray( reader.getChunkIndex( ).at( chunk ).numberOfEpochs );
+    reader.readColumn( chunk, 0, getArrayData( epochs ) );
+    return make_tuple( epochs, readChunkColumns( reader, chunk, 1, reader.getStateSize( ) ),
+                       readChunkColumns( reader, chunk, 1 + reader.getStateSize( ),
+                                         reader.getDependentVariableSize( ) ) );
+}
+
+object readColumn( ChunkedOutputReader& reader, const std::size_t column )
+{
+    numpy::ndarray values = createArray( reader.getNumberOfEpochs( ) );
+    double* valueData = getArrayData( values );
+    for( std::size_t i = 0; i < reader.getChunkIndex( ).size( ); i++ )
+    {
+        reader.readColumn( i, column, valueData );
+        valueData += reader.getChunkIndex( ).at( i ).numberOfEpochs;
+    }
+    return values;
+}
+
+} // namespace
+
+void exposeDynamicsSimulator( )
+{
+    enum_< HistoryStorage >( "HistoryStorage" )
+            .value( "map", map_history_storage )
+            .value( "contiguous", contiguous_history_storage )
+            ;
+
+    class_< StateHistory, std::shared_ptr< StateHistory > >( "StateHistory", no_init )
+            .add_property( "states", &getStates,
+                           "States as a read-only (N x state size) array, sharing memory with this object." )
+            .add_property( "epochs", &getEpochs, "Epochs of the rows of states, sharing memory with this object." )
+            .def( "__len__", &StateHistory::size )
+            ;
+    register_ptr_to_python< std::shared_ptr< const StateHistory > >( );
+
+    class_< SingleArcSimulation, std::shared_ptr< SingleArcSimulation >, boost::noncopyable >(
+                "SingleArcDynamicsSimulator", no_init )
+            .def( "__init__", make_constructor(
+                      &createSingleArcSimulation, default_call_policies( ),
+                      ( arg( "body_map" ), arg( "integrator_settings" ), arg( "propagator_settings" ),
+                        arg( "are_equations_of_motion_to_be_integrated" ) = true,
+                        arg( "history_storage" ) = map_history_storage, arg( "profile" ) = false,
+                        arg( "defer_dependent_variables" ) = false ) ),
+                  "With HistoryStorage.contiguous, states are appended to flat, geometrically grown buffers during\n"
+                  "the propagation, instead of to a std::map that is flattened afterwards.\n\n"
+                  "With profile=True (translational dynamics with the Cowell propagator only, else RuntimeError is\n"
+                  "raised), the acceleration models, environment updates, integrator stages and output of each\n"
+                  "propagation are timed; see profile and profile_report. Profiled propagations are run by the\n"
+                  "integration loop of this module (as for integrate_equations_of_motion_to_file) rather than by the\n"
+                  "Tudat simulator, and always store their history contiguously.\n\n"
+                  "With defer_dependent_variables=True (translational dynamics only), the propagation neither updates\n"
+                  "the environment models that only the dependent variables require (such as flight conditions) nor\n"
+                  "evaluates the dependent variables. They are computed from the stored states, at the stored epochs\n"
+                  "only, in a pass over the history at the end of each propagation (or, for\n"
+                  "integrate_equations_of_motion_to_file, as each epoch is written).\n\n"
+                  "Methods documented to propagate with the GIL released keep it if an ephemeris or rotation model of\n"
+                  "the bodies may call SPICE, which is not thread-safe." )
+            .def( "integrate_equations_of_motion", &integrateEquationsOfMotion, arg( "initial_states" ) )
+            .def( "integrate_equations_of_motion_to_file", &integrateEquationsOfMotionToFile,
+                  ( arg( "initial_states" ), arg( "file_path" ), arg( "chunk_size" ) = 65536 ),
+                  "Propagate with the GIL released, streaming the states and dependent variables to a chunked\n"
+                  "columnar file (read with ChunkedOutputFile) instead of storing them. At most chunk_size epochs are\n"
+                  "held in memory. The simulator must be created with\n"
+                  "are_equations_of_motion_to_be_integrated=False (else RuntimeError is raised), so that the\n"
+                  "propagation is not also run, and stored in memory, upon construction." )
+            .def( "integrate_equations_of_motion_with_checkpoints", &integrateEquationsOfMotionWithCheckpoints,
+                  ( arg( "initial_states" ), arg( "checkpoint_path" ), arg( "checkpoint_interval" ) = 600.0 ),
+                  "Propagate with the GIL released, appending the output and the integrator state to the file at\n"
+                  "checkpoint_path at least checkpoint_interval seconds (wall-clock) apart, and at the end. If the\n"
+                  "file holds checkpoints of the same propagation (initial epoch and states, and integrator and\n"
+                  "propagator settings), the stored output is loaded and the propagation is resumed from the last\n"
+                  "complete checkpoint; checkpoints of another propagation raise RuntimeError. With the Euler, RK4\n"
+                  "and variable step Runge-Kutta integrators (the only ones supported), the result is then\n"
+                  "bit-for-bit that of an uninterrupted propagation, provided the bodies and the parameters of the\n"
+                  "acceleration models (which are not compared) are unchanged. Every checkpoint is synchronized to\n"
+                  "the storage device. The history is stored contiguously; a CPU time termination condition\n"
+                  "restarts on resumption." )
+            .def( "integrate_equations_of_motion_dense", &integrateEquationsOfMotionDense, arg( "initial_states" ),
+                  "Propagate with the GIL released, returning a DenseTrajectory that can be evaluated at any epoch\n"
+                  "within the propagation (translational dynamics with the Cowell propagator only). The propagation\n"
+                  "is not stored in the simulator." )
+            .add_property( "state_history", &getStateHistory,
+                           "Propagated states of the last propagation as a read-only (N x state size) array, sharing\n"
+                           "memory with the simulator. The array stays valid (and unchanged) when the simulator\n"
+                           "propagates again." )
+            .add_property( "state_history_epochs", &getStateHistoryEpochs,
+                           "Epochs of the rows of state_history, sharing memory with the simulator." )
+            .add_property( "dependent_variable_history", &getDependentVariableHistory,
+                           "Dependent variables of the last propagation as a read-only (N x number of variables)\n"
+                           "array, at the epochs of state_history (empty if none are saved), sharing memory with the\n"
+                           "simulator. The array stays valid when the simulator propagates again." )
+            .add_property( "profile", &getProfile,
+                           "Profile of the last propagation, as a dict with the calls, total_ns and mean_ns of each\n"
+                           "acceleration model (in 'accelerations'), of 'environment_update', 'integrator_stages' and\n"
+                           "'output', and the 'accepted_steps', 'rejected_steps' and 'total_ns' of the propagation.\n"
+                           "Acceleration calls count updates; their time includes the evaluations. Rejected steps\n"
+                           "are derived from the number of stage evaluations, and are 0 for multi-step integrators." )
+            .add_property( "profile_report", &getProfileReport, "Profile of the last propagation as a table." )
+            ;
+
+    def( "propagate_fixed_size_translational", &propagateFixedSize,
+         ( arg( "body_map" ), arg( "integrator_settings" ), arg( "propagator_settings" ) ),
+         "Propagate translational dynamics of up to four bodies with fixed-size states and an allocation-free\n"
+         "integration loop, with the GIL released unless SPICE is used. Supports Cowell propagation with time\n"
+         "termination, without dependent variables, and the Euler, RK4 and variable step Runge-Kutta\n"
+         "integrators (other settings raise RuntimeError). Returns a StateHistory.\n\n"
+         "As with SingleArcDynamicsSimulator, the propagation ends on the first step reaching the termination\n"
+         "time. With terminate_exactly_on_final_condition, the last step is shortened to end on it, whereas\n"
+         "Tudat redoes the last step; the final state of variable step integrators may then differ slightly." );
+
+    class_< ChunkedOutputReader, std::shared_ptr< ChunkedOutputReader >, boost::noncopyable >(
+                "ChunkedOutputFile",
+                "Reader of a file written by SingleArcDynamicsSimulator.integrate_equations_of_motion_to_file.\n\n"
+                "Columns are numbered with the epochs first, followed by the state entries and the dependent\n"
+                "variables.",
+                init< std::string >( arg( "file_path" ) ) )
+            .add_property( "state_size", &ChunkedOutputReader::getStateSize )
+            .add_property( "dependent_variable_size", &ChunkedOutputReader::getDependentVariableSize )
+            .add_property( "number_of_chunks", &getNumberOfChunks )
+            .def( "__len__", &ChunkedOutputReader::getNumberOfEpochs )
+            .def( "read_chunk", &readChunk, arg( "chunk" ),
+                  "Epochs, (N x state size) states and (N x dependent variable size) dependent variables of a chunk." )
+            .def( "read_column", &readColumn, arg( "column" ), "A single column over all chunks." )
+            ;
+}
+
+} // namespace tudatpy
@@ -0,0 +1,157 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_DYNAMICS_SIMULATOR_H
+#define TUDATPY_DYNAMICS_SIMULATOR_H
+
+#include <memory>
+
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+#include "DependentVariables.h"
+#include "PropagationCheckpoint.h"
+#include "PropagationLoop.h"
+#include "StateHistory.h"
+
+namespace tudatpy
+{
+
+//! Ways in which a SingleArcSimulation stores its propagation history.
+enum HistoryStorage
+{
+    //! History stored by the Tudat simulator (a std::map), and flattened when first requested.
+    map_history_storage,
+
+    //! History appended directly to contiguous buffers during the propagation (see propagateToSink).
+    contiguous_history_storage
+};
+
+//! Single-arc dynamics simulator as exposed to Python.
+/*!
+ *  Wraps a Tudat SingleArcDynamicsSimulator, and keeps a contiguous copy of its state history. With map storage, the
+ *  copy is created from the history of the Tudat simulator (once per propagation) when it is first requested. With
+ *  contiguous storage, the propagation appends directly to the copy, and the history of the Tudat simulator stays
+ *  empty. Every propagation stores its history in newly created StateHistory objects, so that the histories of
+ *  earlier propagations remain valid for as long as they are referenced (e.g. by NumPy views).
+ *
+ *  With deferred dependent variables, the Tudat simulator is created without them, so that the environment models
+ *  they require are not updated at the integrator stages; the dependent variables are computed from the stored states
+ *  at the end of each propagation (see DependentVariableReconstructor), while the environment is still that of the
+ *  propagation.
+ */
+class SingleArcSimulation
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param bodyMap Bodies used in the propagation.
+     *  \param integratorSettings Settings of the numerical integrator.
+     *  \param propagatorSettings Settings of the propagation.
+     *  \param areEquationsOfMotionToBeIntegrated Whether the propagation is to be run upon construction.
+     *  \param historyStorage Way in which the propagation history is stored.
+     *  \param isProfiled Whether the propagations are instrumented (see PropagationProfiler), which implies that they
+     *  are run by propagateToSink.
+     *  \param areDependentVariablesDeferred Whether the dependent variables are computed after the propagation, at the
+     *  stored epochs only (translational dynamics only).
+     */
+    SingleArcSimulation(
+            const tudat::simulation_setup::NamedBodyMap& bodyMap,
+            const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+            const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings,
+            const bool areEquationsOfMotionToBeIntegrated = true,
+            const HistoryStorage historyStorage = map_history_storage,
+            const bool isProfiled = false,
+            const bool areDependentVariablesDeferred = false );
+
+    //! Propagate the equations of motion from the given initial state.
+    void integrateEquationsOfMotion( const Eigen::VectorXd& initialStates );
+
+    //! Propagate the equations of motion from the given initial state, passing the output to a sink.
+    /*!
+     *  The output is not stored in the simulator, so that the memory used only depends on the sink (see
+     *  propagateToSink). Does not touch any Python object, so that it may be called with the GIL released.
+     */
+    void integrateEquationsOfMotion( const Eigen::VectorXd& initialStates, PropagationOutputSink& outputSink );
+
+    //! Propagate the equations of motion from the given initial state, writing checkpoints to resume it from.
+    /*!
+     *  If the checkpoint file holds checkpoints of the same propagation, it is resumed from the last one instead. The
+     *  history is stored contiguously, regardless of the history storage of the simulation (see propagateToSink and
+     *  PropagationCheckpointer). Does not touch any Python object, so that it may be called with the GIL released.
+     */
+    void integrateEquationsOfMotion( const Eigen::VectorXd& initialStates, PropagationCheckpointer& checkpointer );
+
+    //! Propagated (conventional) state history, flattened on first access after each propagation.
+    std::shared_ptr< const StateHistory > getStateHistory( );
+
+    //! Dependent variable history, flattened on first access after each propagation.
+    std::shared_ptr< const StateHistory > getDependentVariableHistory( );
+
+    //! Wrapped Tudat simulator.
+    std::shared_ptr< tudat::propagators::SingleArcDynamicsSimulator< double, double > > getSimulator( ) const
+    {
+        return simulator_;
+    }
+
+    //! Bodies used in the propagation.
+    const tudat::simulation_setup::NamedBodyMap& getBodyMap( ) const
+    {
+        return bodyMap_;
+    }
+
+    //! Profiler of the propagations (nullptr if they are not profiled).
+    std::shared_ptr< PropagationProfiler > getProfiler( ) const
+    {
+        return profiler_;
+    }
+
+    //! Whether the propagation was run upon construction.
+    bool isPropagatedUponConstruction( ) const
+    {
+        return isPropagatedUponConstruction_;
+    }
+
+private:
+
+    //! Compute the deferred dependent variables (if any) from the state history of the last propagation.
+    void computeDeferredDependentVariables( );
+
+    //! Bodies used in the propagation.
+    tudat::simulation_setup::NamedBodyMap bodyMap_;
+
+    //! Wrapped Tudat simulator.
+    std::shared_ptr< tudat::propagators::SingleArcDynamicsSimulator< double, double > > simulator_;
+
+    //! Way in which the propagation history is stored.
+    HistoryStorage historyStorage_;
+
+    //! Whether the propagation was run upon construction.
+    bool isPropagatedUponConstruction_;
+
+    //! Profiler of the propagations (nullptr if they are not profiled).
+    std::shared_ptr< PropagationProfiler > profiler_;
+
+    //! Computation of the deferred dependent variables (nullptr if they are not deferred, or none are saved).
+    std::shared_ptr< DependentVariableReconstructor > dependentVariableReconstructor_;
+
+    //! Contiguous copy of the state history of the last propagation.
+    std::shared_ptr< StateHistory > stateHistory_;
+
+    //! Contiguous copy of the dependent variable history of the last propagation.
+    std::shared_ptr< StateHistory > dependentVariableHistory_;
+
+    //! Whether stateHistory_ and dependentVariableHistory_ correspond to the last propagation.
+    bool isStateHistoryUpToDate_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_DYNAMICS_SIMULATOR_H
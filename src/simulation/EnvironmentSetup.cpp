@@ -0,0 +1,177 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <boost/python.hpp>
+
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/defaultBodies.h"
+
+#include "Conversions.h"
+#include "EphemerisCache.h"
+#include "FrozenBodyMap.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+void loadStandardSpiceKernels( )
+{
+    tudat::spice_interface::loadStandardSpiceKernels( );
+}
+
+dict getDefaultBodySettings( const list& bodyNames )
+{
+    return createDict( tudat::simulation_setup::getDefaultBodySettings( extractList< std::string >( bodyNames ) ) );
+}
+
+dict getDefaultTabulatedBodySettings( const list& bodyNames, const double initialTime, const double finalTime,
+                                      const double timeStep )
+{
+    return createDict( tudat::simulation_setup::getDefaultBodySettings(
+                           extractList< std::string >( bodyNames ), initialTime, finalTime, timeStep ) );
+}
+
+NamedBodyMap createBodiesFromSettings( const dict& bodySettings, const std::string& globalFrameOrigin,
+                                       const std::string& globalFrameOrientation )
+{
+    NamedBodyMap bodyMap = createBodies( extractMap< std::shared_ptr< BodySettings > >( bodySettings ) );
+    setGlobalFrameBodyEphemerides( bodyMap, globalFrameOrigin, globalFrameOrientation );
+    return bodyMap;
+}
+
+void addGroundStationSettings( BodySettings& bodySettings,
+                               const std::shared_ptr< GroundStationSettings > groundStationSettings )
+{
+    bodySettings.groundStationSettings.push_back( groundStationSettings );
+}
+
+dict getRadiationPressureInterfaces( Body& body )
+{
+    return createDict( body.getRadiationPressureInterfaces( ) );
+}
+
+std::shared_ptr< Body > getBody( const NamedBodyMap& bodyMap, const std::string& bodyName )
+{
+    auto bodyIterator = bodyMap.find( bodyName );
+    if( bodyIterator == bodyMap.end( ) )
+    {
+        PyErr_SetString( PyExc_KeyError, bodyName.c_str( ) );
+        throw_error_already_set( );
+    }
+    return bodyIterator->second;
+}
+
+bool hasBody( const NamedBodyMap& bodyMap, const std::string& bodyName )
+{
+    return bodyMap.count( bodyName ) > 0;
+}
+
+std::size_t getNumberOfBodies( const NamedBodyMap& bodyMap )
+{
+    return bodyMap.size( );
+}
+
+list getBodyNames( const NamedBodyMap& bodyMap )
+{
+    list bodyNames;
+    for( auto bodyIterator = bodyMap.begin( ); bodyIterator != bodyMap.end( ); bodyIterator++ )
+    {
+        bodyNames.append( bodyIterator->first );
+    }
+    return bodyNames;
+}
+
+std::shared_ptr< FrozenBodyMap > createFrozenBodyMap( const dict& bodySettings, const std::string& globalFrameOrigin,
+                                                     const std::string& globalFrameOrientation,
+                                                     const object& ephemerisCache )
+{
+    return std::make_shared< FrozenBodyMap >(
+                extractMap< std::shared_ptr< BodySettings > >( bodySettings ), globalFrameOrigin,
+                globalFrameOrientation, ephemerisCache.is_none( ) ? std::shared_ptr< EphemerisCache >( ) :
+                                                                    extract< std::shared_ptr< EphemerisCache > >(
+                                                                        ephemerisCache )( ) );
+}
+
+} // namespace
+
+void exposeEnvironmentSetup( )
+{
+    class_< BodySettings, std::shared_ptr< BodySettings > >( "BodySettings" )
+            .add_property( "constant_mass", &BodySettings::constantMass )
+            .add_property( "atmosphere_settings",
+                           make_getter( &BodySettings::atmosphereSettings, return_value_policy< return_by_value >( ) ),
+                           make_setter( &BodySettings::atmosphereSettings ) )
+            .add_property( "ephemeris_settings",
+                           make_getter( &BodySettings::ephemerisSettings, return_value_policy< return_by_value >( ) ),
+                           make_setter( &BodySettings::ephemerisSettings ) )
+            .add_property( "gravity_field_settings",
+                           make_getter( &BodySettings::gravityFieldSettings,
+                                        return_value_policy< return_by_value >( ) ),
+                           make_setter( &BodySettings::gravityFieldSettings ) )
+            .add_property( "rotation_model_settings", &BodySettings::rotationModelSettings )
+            .add_property( "shape_model_settings", &BodySettings::shapeModelSettings )
+            .add_property( "radiation_pressure_settings", &BodySettings::radiationPressureSettings )
+            .add_property( "aerodynamic_coefficient_settings", &BodySettings::aerodynamicCoefficientSettings )
+            .add_property( "gravity_field_variation_settings", &BodySettings::gravityFieldVariationSettings )
+            .add_property( "ground_station_settings", &BodySettings::groundStationSettings )
+            .def( "add_ground_station_settings", &addGroundStationSettings, arg( "ground_station_settings" ),
+                  "Add a ground station, created with the body by create_bodies." )
+            ;
+
+    class_< Body, std::shared_ptr< Body >, boost::noncopyable >( "Body", no_init )
+            .add_property( "ephemeris", &Body::getEphemeris )
+            .add_property( "atmosphere_model", &Body::getAtmosphereModel )
+            .add_property( "gravity_field_model", &Body::getGravityFieldModel )
+            .add_property( "rotation_model", &Body::getRotationalEphemeris )
+            .add_property( "shape_model", &Body::getShapeModel )
+            .add_property( "radiation_pressure_interfaces", &getRadiationPressureInterfaces )
+            ;
+
+    class_< NamedBodyMap >( "NamedBodyMap" )
+            .def( "__getitem__", &getBody )
+            .def( "__contains__", &hasBody )
+            .def( "__len__", &getNumberOfBodies )
+            .def( "keys", &getBodyNames )
+            ;
+
+    class_< FrozenBodyMap, std::shared_ptr< FrozenBodyMap >, boost::noncopyable >(
+                "FrozenBodyMap",
+                "Environment created once from a dict of BodySettings, from which body maps sharing its immutable\n"
+                "models (ephemerides, gravity fields, exponential atmospheres, rotation and shape models) are created\n"
+                "cheaply. Models holding the state of their last evaluation (the interpolators of tabulated\n"
+                "ephemerides, and other atmospheres) are copied for every body map.",
+                no_init )
+            .def( "__init__", make_constructor(
+                      &createFrozenBodyMap, default_call_policies( ),
+                      ( arg( "body_settings" ), arg( "global_frame_origin" ) = "SSB",
+                        arg( "global_frame_orientation" ) = "ECLIPJ2000", arg( "ephemeris_cache" ) = object( ) ) ) )
+            .def( "create_body_map", &FrozenBodyMap::createBodyMap,
+                  "Create a new body map, with its own body states, sharing the environment models of the snapshot." )
+            ;
+
+    def( "load_standard_spice_kernels", &loadStandardSpiceKernels );
+    def( "get_default_body_settings", &getDefaultBodySettings, arg( "body_names" ) );
+    def( "get_default_body_settings", &getDefaultTabulatedBodySettings,
+         ( arg( "body_names" ), arg( "initial_time" ), arg( "final_time" ), arg( "time_step" ) = 300.0 ) );
+    def( "create_bodies", &createBodiesFromSettings,
+         ( arg( "body_settings" ), arg( "global_frame_origin" ) = "SSB",
+           arg( "global_frame_orientation" ) = "ECLIPJ2000" ),
+         "Create the bodies from a dict of BodySettings, and set the global frame of their ephemerides." );
+}
+
+} // namespace tudatpy
@@ -0,0 +1,181 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createEphemeris.h"
+
+#include "Conversions.h"
+#include "Ephemerides.h"
+#include "EphemerisCache.h"
+#include "FrozenBodyMap.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::ephemerides;
+
+namespace tudatpy
+{
+
+void computeCartesianStates( Ephemeris& ephemeris, const double* epochs, const std::size_t numberOfEpochs,
+                             double* states )
+{
+    for( std::size_t i = 0; i < numberOfEpochs; i++ )
+    {
+        Eigen::Map< Eigen::Vector6d >( states + 6 * i ) = ephemeris.getCartesianState( epochs[ i ] );
+    }
+}
+
+namespace
+{
+
+object getCartesianState( const std::shared_ptr< Ephemeris > ephemeris, const object& secondsSinceEpoch )
+{
+    extract< double > scalarEpoch( secondsSinceEpoch );
+    if( scalarEpoch.check( ) && !extract< numpy::ndarray >( secondsSinceEpoch ).check( ) )
+    {
+        return createArray( ephemeris->getCartesianState( scalarEpoch( ) ) );
+    }
+
+    const ContiguousArray epochs( secondsSinceEpoch );
+    numpy::ndarray states = createArray( epochs.size( ), 6 );
+    double* stateData = getArrayData( states );
+    {
+        // SPICE is not thread-safe, so models that may call it are evaluated with the GIL held.
+        ScopedGilRelease gilRelease( !usesSpice( ephemeris ) );
+        computeCartesianStates( *ephemeris, epochs.data( ), epochs.size( ), stateData );
+    }
+    return states;
+}
+
+std::shared_ptr< InterpolatedSpiceEphemerisSettings > createInterpolatedSpiceEphemerisSettings(
+        const double initialTime, const double finalTime, const double timeStep, const std::string& frameOrigin,
+        const std::string& frameOrientation, const int interpolationOrder )
+{
+    return std::make_shared< InterpolatedSpiceEphemerisSettings >(
+                initialTime, finalTime, timeStep, frameOrigin, frameOrientation,
+                std::make_shared< tudat::interpolators::LagrangeInterpolatorSettings >( interpolationOrder ) );
+}
+
+std::shared_ptr< ConstantEphemerisSettings > createConstantEphemerisSettings(
+        const object& constantState, const std::string& frameOrigin, const std::string& frameOrientation )
+{
+    const Eigen::VectorXd state = extractVector( constantState );
+    if( state.size( ) != 6 )
+    {
+        throw std::runtime_error( "Error when creating constant ephemeris settings, the state must have 6 elements" );
+    }
+    return std::make_shared< ConstantEphemerisSettings >( state, frameOrigin, frameOrientation );
+}
+
+void generateEphemerisCache( const std::string& filePath, const list& bodyNames, const double initialTime,
+                             const double finalTime, const double timeStep, const std::string& frameOrigin,
+                             const std::string& frameOrientation )
+{
+    writeEphemerisCache( filePath, extractList< std::string >( bodyNames ), initialTime, finalTime, timeStep,
+                         frameOrigin, frameOrientation );
+}
+
+list getCachedBodyNames( const EphemerisCache& ephemerisCache )
+{
+    list bodyNames;
+    const std::vector< std::string > cachedBodyNames = ephemerisCache.getBodyNames( );
+    for( unsigned int i = 0; i < cachedBodyNames.size( ); i++ )
+    {
+        bodyNames.append( cachedBodyNames.at( i ) );
+    }
+    return bodyNames;
+}
+
+void setCachedEphemerides( const EphemerisCache& ephemerisCache, NamedBodyMap& bodyMap,
+                           const std::string& globalFrameOrigin, const std::string& globalFrameOrientation )
+{
+    ephemerisCache.setEphemerides( bodyMap );
+    setGlobalFrameBodyEphemerides( bodyMap, globalFrameOrigin, globalFrameOrientation );
+}
+
+} // namespace
+
+void exposeEphemerides( )
+{
+    class_< Ephemeris, std::shared_ptr< Ephemeris >, boost::noncopyable >( "Ephemeris", no_init )
+            .def( "get_cartesian_state", &getCartesianState, arg( "seconds_since_epoch" ),
+                  "Cartesian state at an epoch, or, for an array of N epochs, an (N x 6) array of states evaluated\n"
+                  "in a single native loop with the GIL released (unless the ephemeris may call SPICE, which is not\n"
+                  "thread-safe)." )
+            .add_property( "frame_origin", &Ephemeris::getReferenceFrameOrigin )
+            .add_property( "frame_orientation", &Ephemeris::getReferenceFrameOrientation )
+            ;
+
+    class_< EphemerisSettings, std::shared_ptr< EphemerisSettings >, boost::noncopyable >(
+                "EphemerisSettings", no_init )
+            ;
+
+    class_< DirectSpiceEphemerisSettings, std::shared_ptr< DirectSpiceEphemerisSettings >,
+            bases< EphemerisSettings >, boost::noncopyable >(
+                "DirectSpiceEphemerisSettings",
+                init< optional< std::string, std::string > >(
+                    ( arg( "frame_origin" ) = "SSB", arg( "frame_orientation" ) = "ECLIPJ2000" ) ) )
+            ;
+
+    class_< InterpolatedSpiceEphemerisSettings, std::shared_ptr< InterpolatedSpiceEphemerisSettings >,
+            bases< DirectSpiceEphemerisSettings >, boost::noncopyable >(
+                "InterpolatedSpiceEphemerisSettings",
+                "Ephemeris tabulated from SPICE upon body creation, and interpolated during the propagation.",
+                no_init )
+            .def( "__init__", make_constructor(
+                      &createInterpolatedSpiceEphemerisSettings, default_call_policies( ),
+                      ( arg( "initial_time" ), arg( "final_time" ), arg( "time_step" ),
+                        arg( "frame_origin" ) = "SSB", arg( "frame_orientation" ) = "ECLIPJ2000",
+                        arg( "interpolation_order" ) = 6 ) ) )
+            ;
+
+    class_< ConstantEphemerisSettings, std::shared_ptr< ConstantEphemerisSettings >, bases< EphemerisSettings >,
+            boost::noncopyable >(
+                "ConstantEphemerisSettings", "Ephemeris with a constant Cartesian state.", no_init )
+            .def( "__init__", make_constructor(
+                      &createConstantEphemerisSettings, default_call_policies( ),
+                      ( arg( "constant_state" ), arg( "frame_origin" ) = "SSB",
+                        arg( "frame_orientation" ) = "ECLIPJ2000" ) ) )
+            ;
+
+    def( "create_body_ephemeris", &createBodyEphemeris, ( arg( "ephemeris_settings" ), arg( "body_name" ) ) );
+
+    class_< MappedTabulatedEphemeris, std::shared_ptr< MappedTabulatedEphemeris >, bases< Ephemeris >,
+            boost::noncopyable >( "MappedTabulatedEphemeris", no_init )
+            ;
+
+    class_< EphemerisCache, std::shared_ptr< EphemerisCache >, boost::noncopyable >(
+                "EphemerisCache",
+                "Memory-mapped ephemeris cache file, written by generate_ephemeris_cache.\n\n"
+                "The file is mapped read-only, so that all processes loading the same cache share its pages.",
+                init< std::string, optional< int > >( ( arg( "file_path" ), arg( "interpolation_order" ) ) ) )
+            .add_property( "body_names", &getCachedBodyNames )
+            .add_property( "initial_time", &EphemerisCache::getInitialTime )
+            .add_property( "final_time", &EphemerisCache::getFinalTime )
+            .def( "get_ephemeris", &EphemerisCache::getEphemeris, arg( "body_name" ) )
+            .def( "set_ephemerides", &setCachedEphemerides,
+                  ( arg( "body_map" ), arg( "global_frame_origin" ) = "SSB",
+                    arg( "global_frame_orientation" ) = "ECLIPJ2000" ),
+                  "Replace the ephemerides of all cached bodies in body_map, and reset its global frame." )
+            ;
+
+    def( "generate_ephemeris_cache", &generateEphemerisCache,
+         ( arg( "file_path" ), arg( "body_names" ), arg( "initial_time" ), arg( "final_time" ), arg( "time_step" ),
+           arg( "frame_origin" ) = "SSB", arg( "frame_orientation" ) = "ECLIPJ2000" ),
+         "Tabulate the SPICE states of body_names on a uniform grid, and write them to an ephemeris cache file." );
+}
+
+} // namespace tudatpy
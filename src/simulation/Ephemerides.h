@@ -0,0 +1,34 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_EPHEMERIDES_H
+#define TUDATPY_EPHEMERIDES_H
+
+#include <cstddef>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+
+namespace tudatpy
+{
+
+//! Evaluate the Cartesian state of an ephemeris at a series of epochs.
+/*!
+ *  Does not touch any Python object, so that it may be called with the GIL released.
+ *  \param ephemeris Ephemeris to evaluate.
+ *  \param epochs Epochs at which the ephemeris is evaluated.
+ *  \param numberOfEpochs Number of epochs.
+ *  \param states Row-major (numberOfEpochs x 6) block to which the states are written.
+ */
+void computeCartesianStates( tudat::ephemerides::Ephemeris& ephemeris, const double* epochs,
+                             const std::size_t numberOfEpochs, double* states );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_EPHEMERIDES_H
@@ -0,0 +1,294 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+
+#include "EphemerisCache.h"
+#include "FileUtilities.h"
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Identifier at the start of every ephemeris cache file (including the format version).
+const char ephemerisCacheIdentifier[ 8 ] = { 'T', 'P', 'Y', 'E', 'P', 'H', '0', '1' };
+
+//! Maximum length of the names stored in an ephemeris cache file (including the terminating null character).
+const std::size_t maximumNameLength = 64;
+
+//! Alignment (in bytes) of the state blocks in an ephemeris cache file.
+const std::size_t dataAlignment = 64;
+
+//! Maximum number of nodes used for the interpolation of a cached ephemeris.
+const int maximumInterpolationOrder = 16;
+
+//! Header of an ephemeris cache file.
+struct EphemerisCacheHeader
+{
+    char identifier[ 8 ];
+    std::uint64_t numberOfBodies;
+    std::uint64_t numberOfEpochs;
+    double initialTime;
+    double timeStep;
+    char frameOrigin[ maximumNameLength ];
+    char frameOrientation[ maximumNameLength ];
+};
+
+//! Entry of the body table of an ephemeris cache file.
+struct EphemerisCacheBodyEntry
+{
+    char bodyName[ maximumNameLength ];
+    std::uint64_t dataOffset;
+};
+
+std::size_t alignOffset( const std::size_t offset )
+{
+    return ( ( offset + dataAlignment - 1 ) / dataAlignment ) * dataAlignment;
+}
+
+void copyName( char* target, const std::string& name )
+{
+    if( name.size( ) >= maximumNameLength )
+    {
+        throw std::runtime_error( "Error when writing ephemeris cache, name " + name + " is too long" );
+    }
+    std::memset( target, 0, maximumNameLength );
+    std::memcpy( target, name.c_str( ), name.size( ) );
+}
+
+std::string readName( const char* source )
+{
+    return std::string( source, strnlen( source, maximumNameLength ) );
+}
+
+} // namespace
+
+void writeEphemerisCache( const std::string& filePath, const std::vector< std::string >& bodyNames,
+                          const double initialTime, const double finalTime, const double timeStep,
+                          const std::string& frameOrigin, const std::string& frameOrientation )
+{
+    if( !( timeStep > 0.0 ) || !( finalTime > initialTime ) )
+    {
+        throw std::runtime_error( "Error when writing ephemeris cache, time grid is invalid" );
+    }
+
+    EphemerisCacheHeader header;
+    std::memcpy( header.identifier, ephemerisCacheIdentifier, sizeof( ephemerisCacheIdentifier ) );
+    header.numberOfBodies = bodyNames.size( );
+    header.numberOfEpochs = static_cast< std::uint64_t >( std::ceil( ( finalTime - initialTime ) / timeStep ) ) + 1;
+    header.initialTime = initialTime;
+    header.timeStep = timeStep;
+    copyName( header.frameOrigin, frameOrigin );
+    copyName( header.frameOrientation, frameOrientation );
+
+    const std::size_t blockSize = alignOffset( header.numberOfEpochs * 6 * sizeof( double ) );
+    std::vector< EphemerisCacheBodyEntry > bodyEntries( bodyNames.size( ) );
+    std::size_t dataOffset = alignOffset( sizeof( EphemerisCacheHeader ) +
+                                          bodyNames.size( ) * sizeof( EphemerisCacheBodyEntry ) );
+    for( unsigned int i = 0; i < bodyNames.size( ); i++ )
+    {
+        copyName( bodyEntries.at( i ).bodyName, bodyNames.at( i ) );
+        bodyEntries.at( i ).dataOffset = dataOffset;
+        dataOffset += blockSize;
+    }
+
+    // The cache is written to a temporary file that then replaces the existing one, so that processes that mapped the
+    // existing file keep reading valid (old) data, and a failed write leaves the existing file intact.
+    const std::string temporaryFilePath = getTemporaryFilePath( filePath );
+    std::ofstream file( temporaryFilePath.c_str( ), std::ios::binary | std::ios::trunc );
+    if( !file )
+    {
+        throw std::runtime_error( "Error when writing ephemeris cache, could not open " + temporaryFilePath );
+    }
+    try
+    {
+        file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+        file.write( reinterpret_cast< const char* >( bodyEntries.data( ) ),
+                    bodyEntries.size( ) * sizeof( EphemerisCacheBodyEntry ) );
+
+        std::vector< double > states( blockSize / sizeof( double ), 0.0 );
+        for( unsigned int i = 0; i < bodyNames.size( ); i++ )
+        {
+            for( std::uint64_t j = 0; j < header.numberOfEpochs; j++ )
+            {
+                Eigen::Map< Eigen::Vector6d >( states.data( ) + 6 * j ) =
+                        tudat::spice_interface::getBodyCartesianStateAtEpoch(
+                            bodyNames.at( i ), frameOrigin, frameOrientation, "NONE",
+                            initialTime + timeStep * static_cast< double >( j ) );
+            }
+            file.seekp( bodyEntries.at( i ).dataOffset );
+            file.write( reinterpret_cast< const char* >( states.data( ) ), blockSize );
+        }
+    }
+    catch( ... )
+    {
+        file.close( );
+        std::remove( temporaryFilePath.c_str( ) );
+        throw;
+    }
+
+    file.close( );
+    if( !file )
+    {
+        std::remove( temporaryFilePath.c_str( ) );
+        throw std::runtime_error( "Error when writing ephemeris cache " + filePath );
+    }
+    synchronizeFile( temporaryFilePath );
+    replaceFile( temporaryFilePath, filePath );
+}
+
+MappedTabulatedEphemeris::MappedTabulatedEphemeris(
+        const std::shared_ptr< const MappedEphemerisCacheFile > mappedFile, const double* states,
+        const std::size_t numberOfEpochs, const double initialTime, const double timeStep,
+        const int interpolationOrder, const std::string& frameOrigin, const std::string& frameOrientation ):
+    tudat::ephemerides::Ephemeris( frameOrigin, frameOrientation ),
+    mappedFile_( mappedFile ), states_( states ), numberOfEpochs_( numberOfEpochs ), initialTime_( initialTime ),
+    timeStep_( timeStep ), interpolationOrder_( interpolationOrder )
+{ }
+
+Eigen::Vector6d MappedTabulatedEphemeris::getCartesianState( const double secondsSinceEpoch )
+{
+    const double gridPosition = ( secondsSinceEpoch - initialTime_ ) / timeStep_;
+    if( !( gridPosition >= 0.0 ) || gridPosition > static_cast< double >( numberOfEpochs_ - 1 ) )
+    {
+        throw std::runtime_error( "Error in cached ephemeris, epoch is outside of the tabulated interval" );
+    }
+
+    // Center the interpolation nodes on the requested epoch, shifting them inwards at the edges of the grid.
+    long firstNode = static_cast< long >( std::floor( gridPosition ) ) - ( interpolationOrder_ / 2 - 1 );
+    firstNode = std::max( 0L, std::min( firstNode, static_cast< long >( numberOfEpochs_ ) - interpolationOrder_ ) );
+
+    double weights[ maximumInterpolationOrder ];
+    for( int i = 0; i < interpolationOrder_; i++ )
+    {
+        weights[ i ] = 1.0;
+        for( int j = 0; j < interpolationOrder_; j++ )
+        {
+            if( j != i )
+            {
+                weights[ i ] *= ( gridPosition - static_cast< double >( firstNode + j ) ) /
+                        static_cast< double >( i - j );
+            }
+        }
+    }
+
+    Eigen::Vector6d state = Eigen::Vector6d::Zero( );
+    const double* nodeStates = states_ + 6 * firstNode;
+    for( int i = 0; i < interpolationOrder_; i++ )
+    {
+        state += weights[ i ] * Eigen::Map< const Eigen::Vector6d >( nodeStates + 6 * i );
+    }
+    return state;
+}
+
+EphemerisCache::EphemerisCache( const std::string& filePath, const int interpolationOrder ):
+    mappedFile_( std::make_shared< MappedEphemerisCacheFile >( filePath ) ), interpolationOrder_( interpolationOrder )
+{
+    const char* data = static_cast< const char* >( mappedFile_->region.get_address( ) );
+    const std::size_t fileSize = mappedFile_->region.get_size( );
+
+    EphemerisCacheHeader header;
+    if( fileSize < sizeof( header ) )
+    {
+        throw std::runtime_error( "Error when reading ephemeris cache, " + filePath + " is too small" );
+    }
+    std::memcpy( &header, data, sizeof( header ) );
+    if( std::memcmp( header.identifier, ephemerisCacheIdentifier, sizeof( ephemerisCacheIdentifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when reading ephemeris cache, " + filePath +
+                                  " is not an ephemeris cache file of this version" );
+    }
+
+    if( !( header.timeStep > 0.0 ) || !std::isfinite( header.timeStep ) || !std::isfinite( header.initialTime ) )
+    {
+        throw std::runtime_error( "Error when reading ephemeris cache, " + filePath + " has an invalid time grid" );
+    }
+    if( header.numberOfEpochs > std::numeric_limits< std::size_t >::max( ) / ( 6 * sizeof( double ) ) )
+    {
+        throw std::runtime_error( "Error when reading ephemeris cache, " + filePath + " is truncated" );
+    }
+
+    numberOfEpochs_ = header.numberOfEpochs;
+    initialTime_ = header.initialTime;
+    timeStep_ = header.timeStep;
+    frameOrigin_ = readName( header.frameOrigin );
+    frameOrientation_ = readName( header.frameOrientation );
+
+    if( interpolationOrder_ < 2 || interpolationOrder_ > maximumInterpolationOrder ||
+            static_cast< std::size_t >( interpolationOrder_ ) > numberOfEpochs_ )
+    {
+        throw std::runtime_error( "Error when reading ephemeris cache, interpolation order is not supported" );
+    }
+
+    const std::size_t blockSize = numberOfEpochs_ * 6 * sizeof( double );
+    for( std::uint64_t i = 0; i < header.numberOfBodies; i++ )
+    {
+        EphemerisCacheBodyEntry bodyEntry;
+        const std::size_t entryOffset = sizeof( header ) + i * sizeof( bodyEntry );
+        if( entryOffset + sizeof( bodyEntry ) > fileSize )
+        {
+            throw std::runtime_error( "Error when reading ephemeris cache, " + filePath + " is truncated" );
+        }
+        std::memcpy( &bodyEntry, data + entryOffset, sizeof( bodyEntry ) );
+        if( bodyEntry.dataOffset > fileSize || blockSize > fileSize - bodyEntry.dataOffset ||
+                bodyEntry.dataOffset % dataAlignment != 0 )
+        {
+            throw std::runtime_error( "Error when reading ephemeris cache, " + filePath + " is truncated" );
+        }
+        bodyStates_[ readName( bodyEntry.bodyName ) ] =
+                reinterpret_cast< const double* >( data + bodyEntry.dataOffset );
+    }
+}
+
+std::vector< std::string > EphemerisCache::getBodyNames( ) const
+{
+    std::vector< std::string > bodyNames;
+    for( auto bodyIterator = bodyStates_.begin( ); bodyIterator != bodyStates_.end( ); bodyIterator++ )
+    {
+        bodyNames.push_back( bodyIterator->first );
+    }
+    return bodyNames;
+}
+
+std::shared_ptr< MappedTabulatedEphemeris > EphemerisCache::getEphemeris( const std::string& bodyName ) const
+{
+    auto bodyIterator = bodyStates_.find( bodyName );
+    if( bodyIterator == bodyStates_.end( ) )
+    {
+        throw std::runtime_error( "Error, ephemeris cache contains no states of " + bodyName );
+    }
+    return std::make_shared< MappedTabulatedEphemeris >(
+                mappedFile_, bodyIterator->second, numberOfEpochs_, initialTime_, timeStep_, interpolationOrder_,
+                frameOrigin_, frameOrientation_ );
+}
+
+void EphemerisCache::setEphemerides( tudat::simulation_setup::NamedBodyMap& bodyMap ) const
+{
+    for( auto bodyIterator = bodyStates_.begin( ); bodyIterator != bodyStates_.end( ); bodyIterator++ )
+    {
+        if( bodyMap.count( bodyIterator->first ) > 0 )
+        {
+            bodyMap.at( bodyIterator->first )->setEphemeris( getEphemeris( bodyIterator->first ) );
+        }
+    }
+}
+
+} // namespace tudatpy
@@ -0,0 +1,178 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_EPHEMERIS_CACHE_H
+#define TUDATPY_EPHEMERIS_CACHE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+
+namespace tudatpy
+{
+
+//! Tabulate SPICE states of a set of bodies on a uniform time grid, and write them to an ephemeris cache file.
+/*!
+ *  The file consists of a fixed-size header, a table of body names and data offsets, and for each body a row-major
+ *  (number of epochs x 6) block of Cartesian states, aligned to 64 bytes. Values are stored in native byte order, so
+ *  cache files can only be shared between machines of the same architecture. An existing file is replaced (see
+ *  replaceFile) rather than overwritten, so that processes using it are not affected.
+ *  \param filePath Path of the file to write.
+ *  \param bodyNames Names of the bodies to tabulate.
+ *  \param initialTime First epoch of the grid.
+ *  \param finalTime Last epoch of the grid (rounded up to a multiple of the time step).
+ *  \param timeStep Step of the grid.
+ *  \param frameOrigin Origin of the frame in which the states are tabulated.
+ *  \param frameOrientation Orientation of the frame in which the states are tabulated.
+ */
+void writeEphemerisCache( const std::string& filePath, const std::vector< std::string >& bodyNames,
+                          const double initialTime, const double finalTime, const double timeStep,
+                          const std::string& frameOrigin, const std::string& frameOrientation );
+
+//! Read-only memory mapping of an ephemeris cache file.
+struct MappedEphemerisCacheFile
+{
+    //! Constructor, mapping the whole file.
+    explicit MappedEphemerisCacheFile( const std::string& filePath ):
+        file( filePath.c_str( ), boost::interprocess::read_only ),
+        region( file, boost::interprocess::read_only )
+    { }
+
+    //! Mapping of the file.
+    boost::interprocess::file_mapping file;
+
+    //! Mapped region covering the whole file.
+    boost::interprocess::mapped_region region;
+};
+
+//! Ephemeris interpolating states from a memory-mapped ephemeris cache.
+/*!
+ *  States are interpolated component-wise with a Lagrange polynomial on the uniform grid of the cache. The node
+ *  lookup is computed directly from the epoch, so that the ephemeris holds no mutable state and may be used
+ *  concurrently by multiple threads.
+ */
+class MappedTabulatedEphemeris: public tudat::ephemerides::Ephemeris
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param mappedFile Mapped cache file, kept alive by the ephemeris.
+     *  \param states Row-major (numberOfEpochs x 6) block of states in the mapped file.
+     *  \param numberOfEpochs Number of epochs in the grid.
+     *  \param initialTime First epoch of the grid.
+     *  \param timeStep Step of the grid.
+     *  \param interpolationOrder Number of nodes used for the interpolation.
+     *  \param frameOrigin Origin of the frame in which the states are tabulated.
+     *  \param frameOrientation Orientation of the frame in which the states are tabulated.
+     */
+    MappedTabulatedEphemeris( const std::shared_ptr< const MappedEphemerisCacheFile > mappedFile,
+                              const double* states, const std::size_t numberOfEpochs,
+                              const double initialTime, const double timeStep, const int interpolationOrder,
+                              const std::string& frameOrigin, const std::string& frameOrientation );
+
+    //! Interpolated Cartesian state at the given epoch.
+    Eigen::Vector6d getCartesianState( const double secondsSinceEpoch );
+
+private:
+
+    //! Mapped cache file holding the states.
+    std::shared_ptr< const MappedEphemerisCacheFile > mappedFile_;
+
+    //! Row-major (numberOfEpochs x 6) block of states in the mapped file.
+    const double* states_;
+
+    //! Number of epochs in the grid.
+    std::size_t numberOfEpochs_;
+
+    //! First epoch of the grid.
+    double initialTime_;
+
+    //! Step of the grid.
+    double timeStep_;
+
+    //! Number of nodes used for the interpolation.
+    int interpolationOrder_;
+};
+
+//! Ephemeris cache file, memory-mapped so that its pages are shared by all processes using it.
+class EphemerisCache
+{
+public:
+
+    //! Constructor, mapping a file written by writeEphemerisCache.
+    /*!
+     *  \param filePath Path of the cache file.
+     *  \param interpolationOrder Number of nodes used for the interpolation of the states.
+     *  \throws std::runtime_error If the file is not a valid ephemeris cache, or has an invalid time grid.
+     */
+    EphemerisCache( const std::string& filePath, const int interpolationOrder = 8 );
+
+    //! Names of the tabulated bodies.
+    std::vector< std::string > getBodyNames( ) const;
+
+    //! Ephemeris of a tabulated body.
+    std::shared_ptr< MappedTabulatedEphemeris > getEphemeris( const std::string& bodyName ) const;
+
+    //! First epoch of the grid.
+    double getInitialTime( ) const
+    {
+        return initialTime_;
+    }
+
+    //! Last epoch of the grid.
+    double getFinalTime( ) const
+    {
+        return initialTime_ + timeStep_ * static_cast< double >( numberOfEpochs_ - 1 );
+    }
+
+    //! Replace the ephemerides of all tabulated bodies present in a body map by the cached ones.
+    /*!
+     *  The global frame of the body map must subsequently be (re)set with setGlobalFrameBodyEphemerides.
+     */
+    void setEphemerides( tudat::simulation_setup::NamedBodyMap& bodyMap ) const;
+
+private:
+
+    //! Mapped cache file.
+    std::shared_ptr< MappedEphemerisCacheFile > mappedFile_;
+
+    //! Pointer to the states of each tabulated body.
+    std::map< std::string, const double* > bodyStates_;
+
+    //! Number of epochs in the grid.
+    std::size_t numberOfEpochs_;
+
+    //! First epoch of the grid.
+    double initialTime_;
+
+    //! Step of the grid.
+    double timeStep_;
+
+    //! Origin of the frame in which the states are tabulated.
+    std::string frameOrigin_;
+
+    //! Orientation of the frame in which the states are tabulated.
+    std::string frameOrientation_;
+
+    //! Number of nodes used for the interpolation of the states.
+    int interpolationOrder_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_EPHEMERIS_CACHE_H
@@ -0,0 +1,77 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cstdio>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "FileUtilities.h"
+
+namespace tudatpy
+{
+
+std::string getTemporaryFilePath( const std::string& filePath )
+{
+#ifdef _WIN32
+    return filePath + ".tmp" + std::to_string( _getpid( ) );
+#else
+    return filePath + ".tmp" + std::to_string( getpid( ) );
+#endif
+}
+
+void synchronizeFile( const std::string& filePath )
+{
+#ifdef _WIN32
+    const int fileDescriptor = _open( filePath.c_str( ), _O_RDWR | _O_BINARY );
+    const bool isSynchronized = fileDescriptor >= 0 && _commit( fileDescriptor ) == 0;
+    if( fileDescriptor >= 0 )
+    {
+        _close( fileDescriptor );
+    }
+#else
+    const int fileDescriptor = open( filePath.c_str( ), O_RDONLY );
+    const bool isSynchronized = fileDescriptor >= 0 && fsync( fileDescriptor ) == 0;
+    if( fileDescriptor >= 0 )
+    {
+        close( fileDescriptor );
+    }
+#endif
+    if( !isSynchronized )
+    {
+        throw std::runtime_error( "Error when flushing file " + filePath + " to disk" );
+    }
+}
+
+void replaceFile( const std::string& sourceFilePath, const std::string& targetFilePath )
+{
+    if( std::rename( sourceFilePath.c_str( ), targetFilePath.c_str( ) ) != 0 )
+    {
+#ifdef _WIN32
+        // Renaming onto an existing file fails on Windows, where the file is then briefly absent.
+        std::remove( targetFilePath.c_str( ) );
+        if( std::rename( sourceFilePath.c_str( ), targetFilePath.c_str( ) ) == 0 )
+        {
+            return;
+        }
+#endif
+        std::remove( sourceFilePath.c_str( ) );
+        throw std::runtime_error( "Error when replacing file " + targetFilePath );
+    }
+}
+
+} // namespace tudatpy
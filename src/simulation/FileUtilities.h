@@ -0,0 +1,44 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_FILE_UTILITIES_H
+#define TUDATPY_FILE_UTILITIES_H
+
+#include <string>
+
+namespace tudatpy
+{
+
+//! Path of a temporary file, in the directory of a file, to which a replacement of the file can be written.
+/*!
+ *  The path includes the process identifier, so that processes replacing the same file do not write to the same
+ *  temporary file.
+ */
+std::string getTemporaryFilePath( const std::string& filePath );
+
+//! Flush the contents of a (closed) file to the storage device, so that they are not lost if the system crashes.
+/*!
+ *  \throws std::runtime_error If the file cannot be opened or flushed.
+ */
+void synchronizeFile( const std::string& filePath );
+
+//! Replace a file by another one in the same directory.
+/*!
+ *  On POSIX systems, the file is replaced atomically: processes that opened (or memory-mapped) the old file keep
+ *  reading it, and others open either the old or the new file, never a partially written one.
+ *  \param sourceFilePath Path of the new file, which is renamed.
+ *  \param targetFilePath Path of the file to replace (which need not exist).
+ *  \throws std::runtime_error If the file cannot be replaced.
+ */
+void replaceFile( const std::string& sourceFilePath, const std::string& targetFilePath );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_FILE_UTILITIES_H
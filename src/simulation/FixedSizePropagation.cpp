@@ -0,0 +1,374 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+
+#include "FixedSizePropagation.h"
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Coefficients of an explicit (embedded) Runge-Kutta method, with the settings of its step size control.
+struct ButcherTableau
+{
+    //! Coefficients of the stages.
+    Eigen::MatrixXd aCoefficients;
+
+    //! Fractions of the step at which the stages are evaluated.
+    Eigen::VectorXd cCoefficients;
+
+    //! Weights of the stages in the integrated estimate.
+    Eigen::VectorXd bCoefficients;
+
+    //! Weights of the stages in the error estimate (empty for fixed step methods).
+    Eigen::VectorXd errorCoefficients;
+
+    //! Order of the lower order estimate, which determines the step size control.
+    int lowerOrder;
+};
+
+ButcherTableau getButcherTableau( const IntegratorSettings< double >& integratorSettings )
+{
+    ButcherTableau tableau;
+    switch( integratorSettings.integratorType_ )
+    {
+    case euler:
+        tableau.aCoefficients = Eigen::MatrixXd::Zero( 1, 1 );
+        tableau.cCoefficients = Eigen::VectorXd::Zero( 1 );
+        tableau.bCoefficients = Eigen::VectorXd::Ones( 1 );
+        tableau.lowerOrder = 1;
+        break;
+    case rungeKutta4:
+        tableau.aCoefficients = Eigen::MatrixXd::Zero( 4, 4 );
+        tableau.aCoefficients( 1, 0 ) = 0.5;
+        tableau.aCoefficients( 2, 1 ) = 0.5;
+        tableau.aCoefficients( 3, 2 ) = 1.0;
+        tableau.cCoefficients = ( Eigen::VectorXd( 4 ) << 0.0, 0.5, 0.5, 1.0 ).finished( );
+        tableau.bCoefficients = ( Eigen::VectorXd( 4 ) << 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 ).finished( );
+        tableau.lowerOrder = 4;
+        break;
+    case rungeKuttaVariableStepSize:
+    {
+        const RungeKuttaCoefficients& coefficients = RungeKuttaCoefficients::get(
+                    dynamic_cast< const RungeKuttaVariableStepSizeSettings< double >& >(
+                        integratorSettings ).coefficientSet_ );
+        tableau.aCoefficients = coefficients.aCoefficients;
+        tableau.cCoefficients = coefficients.cCoefficients;
+        tableau.bCoefficients = coefficients.bCoefficients.row(
+                    coefficients.orderEstimateToIntegrate == RungeKuttaCoefficients::lower ? 0 : 1 ).transpose( );
+        tableau.errorCoefficients = ( coefficients.bCoefficients.row( 1 ) -
+                                      coefficients.bCoefficients.row( 0 ) ).transpose( );
+        tableau.lowerOrder = coefficients.lowerOrder;
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error in fixed-size propagation, integrator type is not supported" );
+    }
+    return tableau;
+}
+
+//! Translational (Cowell) state derivative of a fixed number of bodies, with fixed-size states.
+template< int NumberOfBodies >
+class FixedSizeTranslationalDynamics
+{
+public:
+
+    //! Size of the propagated state.
+    static const int stateSize = 6 * NumberOfBodies;
+
+    //! Type of the propagated state.
+    typedef Eigen::Matrix< double, stateSize, 1 > StateType;
+
+    //! Constructor, collecting the environment models to update and the acceleration models to evaluate.
+    FixedSizeTranslationalDynamics( const NamedBodyMap& bodyMap,
+                                    const TranslationalStatePropagatorSettings< double >& propagatorSettings )
+    {
+        const std::vector< std::string >& bodiesToPropagate = propagatorSettings.bodiesToIntegrate_;
+        for( unsigned int i = 0; i < bodiesToPropagate.size( ); i++ )
+        {
+            const std::string& centralBody = propagatorSettings.centralBodies_.at( i );
+            if( std::find( bodiesToPropagate.begin( ), bodiesToPropagate.end( ), centralBody ) !=
+                    bodiesToPropagate.end( ) )
+            {
+                throw std::runtime_error( "Error in fixed-size propagation, central body " + centralBody +
+                                          " is propagated" );
+            }
+
+            const std::shared_ptr< Body > body = bodyMap.at( bodiesToPropagate.at( i ) );
+            propagatedBodies_.push_back( body );
+            centralBodies_.push_back( bodyMap.count( centralBody ) > 0 ? bodyMap.at( centralBody ) : nullptr );
+            if( body->getFlightConditions( ) != nullptr )
+            {
+                flightConditions_.push_back( body->getFlightConditions( ) );
+            }
+            const auto radiationPressureInterfaces = body->getRadiationPressureInterfaces( );
+            for( auto interfaceIterator = radiationPressureInterfaces.begin( );
+                 interfaceIterator != radiationPressureInterfaces.end( ); interfaceIterator++ )
+            {
+                radiationPressureInterfaces_.push_back( interfaceIterator->second );
+            }
+
+            accelerationModels_.push_back( std::vector< std::shared_ptr<
+                                           tudat::basic_astrodynamics::AccelerationModel3d > >( ) );
+            if( propagatorSettings.accelerationsMap_.count( bodiesToPropagate.at( i ) ) > 0 )
+            {
+                const auto& accelerationsOnBody = propagatorSettings.accelerationsMap_.at( bodiesToPropagate.at( i ) );
+                for( auto exertingIterator = accelerationsOnBody.begin( );
+                     exertingIterator != accelerationsOnBody.end( ); exertingIterator++ )
+                {
+                    accelerationModels_.back( ).insert( accelerationModels_.back( ).end( ),
+                                                        exertingIterator->second.begin( ),
+                                                        exertingIterator->second.end( ) );
+                }
+            }
+        }
+
+        for( auto bodyIterator = bodyMap.begin( ); bodyIterator != bodyMap.end( ); bodyIterator++ )
+        {
+            if( std::find( bodiesToPropagate.begin( ), bodiesToPropagate.end( ), bodyIterator->first ) ==
+                    bodiesToPropagate.end( ) && bodyIterator->second->getEphemeris( ) != nullptr )
+            {
+                ephemerisBodies_.push_back( bodyIterator->second );
+            }
+            if( bodyIterator->second->getRotationalEphemeris( ) != nullptr )
+            {
+                rotatingBodies_.push_back( bodyIterator->second );
+            }
+        }
+    }
+
+    //! Compute the state derivative, after updating the environment to the given time and state.
+    void computeStateDerivative( const double time, const StateType& state, StateType& stateDerivative )
+    {
+        updateEnvironment( time, state );
+        for( int i = 0; i < NumberOfBodies; i++ )
+        {
+            Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+            for( unsigned int j = 0; j < accelerationModels_[ i ].size( ); j++ )
+            {
+                accelerationModels_[ i ][ j ]->resetTime( TUDAT_NAN );
+                accelerationModels_[ i ][ j ]->updateMembers( time );
+                acceleration += accelerationModels_[ i ][ j ]->getAcceleration( );
+            }
+            stateDerivative.template segment< 3 >( 6 * i ) = state.template segment< 3 >( 6 * i + 3 );
+            stateDerivative.template segment< 3 >( 6 * i + 3 ) = acceleration;
+        }
+    }
+
+private:
+
+    //! Update the environment models on which the accelerations depend.
+    void updateEnvironment( const double time, const StateType& state )
+    {
+        for( unsigned int i = 0; i < ephemerisBodies_.size( ); i++ )
+        {
+            ephemerisBodies_[ i ]->template setStateFromEphemeris< double, double >( time );
+        }
+        for( unsigned int i = 0; i < rotatingBodies_.size( ); i++ )
+        {
+            rotatingBodies_[ i ]->setCurrentRotationalStateToLocalFrameFromEphemeris( time );
+        }
+        for( int i = 0; i < NumberOfBodies; i++ )
+        {
+            Eigen::Vector6d globalState = state.template segment< 6 >( 6 * i );
+            if( centralBodies_[ i ] != nullptr )
+            {
+                globalState += centralBodies_[ i ]->getState( );
+            }
+            propagatedBodies_[ i ]->setState( globalState );
+        }
+        for( unsigned int i = 0; i < flightConditions_.size( ); i++ )
+        {
+            flightConditions_[ i ]->resetCurrentTime( );
+            flightConditions_[ i ]->updateConditions( time );
+        }
+        for( unsigned int i = 0; i < radiationPressureInterfaces_.size( ); i++ )
+        {
+            radiationPressureInterfaces_[ i ]->updateInterface( time );
+        }
+    }
+
+    //! Propagated bodies.
+    std::vector< std::shared_ptr< Body > > propagatedBodies_;
+
+    //! Central body of each propagated body (nullptr for the global frame origin).
+    std::vector< std::shared_ptr< Body > > centralBodies_;
+
+    //! Bodies of which the state is set from their ephemeris.
+    std::vector< std::shared_ptr< Body > > ephemerisBodies_;
+
+    //! Bodies of which the rotation is set from their rotational ephemeris.
+    std::vector< std::shared_ptr< Body > > rotatingBodies_;
+
+    //! Flight conditions of the propagated bodies.
+    std::vector< std::shared_ptr< tudat::aerodynamics::FlightConditions > > flightConditions_;
+
+    //! Radiation pressure interfaces of the propagated bodies.
+    std::vector< std::shared_ptr< tudat::electromagnetism::RadiationPressureInterface > > radiationPressureInterfaces_;
+
+    //! Acceleration models acting on each propagated body.
+    std::vector< std::vector< std::shared_ptr< tudat::basic_astrodynamics::AccelerationModel3d > > >
+    accelerationModels_;
+};
+
+template< int NumberOfBodies >
+StateHistory propagateFixedSize(
+        const NamedBodyMap& bodyMap, const IntegratorSettings< double >& integratorSettings,
+        const TranslationalStatePropagatorSettings< double >& propagatorSettings, const Eigen::VectorXd& initialStates,
+        const double terminationTime, const bool isLastStepShortened )
+{
+    typedef typename FixedSizeTranslationalDynamics< NumberOfBodies >::StateType StateType;
+
+    FixedSizeTranslationalDynamics< NumberOfBodies > dynamics( bodyMap, propagatorSettings );
+    const ButcherTableau tableau = getButcherTableau( integratorSettings );
+    const RungeKuttaVariableStepSizeSettings< double >* variableStepSettings =
+            tableau.errorCoefficients.rows( ) > 0 ?
+                dynamic_cast< const RungeKuttaVariableStepSizeSettings< double >* >( &integratorSettings ) : nullptr;
+
+    // All work arrays are allocated once; the integration loop itself does not allocate.
+    const int numberOfStages = static_cast< int >( tableau.bCoefficients.rows( ) );
+    std::vector< StateType, Eigen::aligned_allocator< StateType > > stageDerivatives( numberOfStages );
+    StateType stageState, candidateState, errorEstimate;
+
+    double currentTime = integratorSettings.initialTime_;
+    StateType currentState = initialStates;
+    double stepSize = integratorSettings.initialTimeStep_;
+    const double direction = stepSize > 0.0 ? 1.0 : -1.0;
+
+    StateHistory stateHistory;
+    stateHistory.append( currentTime, currentState.data( ), StateType::RowsAtCompileTime );
+    while( direction * ( terminationTime - currentTime ) > 0.0 )
+    {
+        const double currentStepSize = isLastStepShortened ?
+                    direction * std::min( std::fabs( stepSize ), std::fabs( terminationTime - currentTime ) ) :
+                    stepSize;
+        for( int i = 0; i < numberOfStages; i++ )
+        {
+            stageState = currentState;
+            for( int j = 0; j < i; j++ )
+            {
+                stageState += currentStepSize * tableau.aCoefficients( i, j ) * stageDerivatives[ j ];
+            }
+            dynamics.computeStateDerivative( currentTime + tableau.cCoefficients( i ) * currentStepSize, stageState,
+                                             stageDerivatives[ i ] );
+        }
+        candidateState = currentState;
+        for( int i = 0; i < numberOfStages; i++ )
+        {
+            candidateState += currentStepSize * tableau.bCoefficients( i ) * stageDerivatives[ i ];
+        }
+
+        if( variableStepSettings != nullptr )
+        {
+            errorEstimate.setZero( );
+            for( int i = 0; i < numberOfStages; i++ )
+            {
+                errorEstimate += currentStepSize * tableau.errorCoefficients( i ) * stageDerivatives[ i ];
+            }
+            const double relativeError = ( errorEstimate.array( ).abs( ) / (
+                                               variableStepSettings->absoluteErrorTolerance_ +
+                                               variableStepSettings->relativeErrorTolerance_ *
+                                               candidateState.array( ).abs( ) ) ).maxCoeff( );
+            const double stepFactor = std::max(
+                        variableStepSettings->minimumFactorDecreaseForNextStepSize_,
+                        std::min( variableStepSettings->maximumFactorIncreaseForNextStepSize_,
+                                  variableStepSettings->safetyFactorForNextStepSize_ *
+                                  std::pow( 1.0 / relativeError, 1.0 / ( tableau.lowerOrder + 1.0 ) ) ) );
+            const double newStepSize = std::min( variableStepSettings->maximumStepSize_,
+                                                 std::fabs( currentStepSize ) * stepFactor );
+            if( newStepSize < variableStepSettings->minimumStepSize_ )
+            {
+                throw std::runtime_error( "Error in fixed-size propagation, step size below minimum at t = " +
+                                          std::to_string( currentTime ) );
+            }
+            stepSize = direction * newStepSize;
+            if( relativeError > 1.0 )
+            {
+                continue;
+            }
+        }
+
+        currentTime += currentStepSize;
+        currentState = candidateState;
+        if( !currentState.allFinite( ) )
+        {
+            throw std::runtime_error( "Error in fixed-size propagation, state is not finite at t = " +
+                                      std::to_string( currentTime ) );
+        }
+        stateHistory.append( currentTime, currentState.data( ), StateType::RowsAtCompileTime );
+    }
+    return stateHistory;
+}
+
+} // namespace
+
+StateHistory propagateFixedSizeTranslationalDynamics(
+        const NamedBodyMap& bodyMap, const std::shared_ptr< IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings )
+{
+    if( propagatorSettings->propagator_ != cowell )
+    {
+        throw std::runtime_error( "Error in fixed-size propagation, only the Cowell propagator is supported" );
+    }
+    const std::shared_ptr< PropagationTimeTerminationSettings > terminationSettings =
+            std::dynamic_pointer_cast< PropagationTimeTerminationSettings >(
+                propagatorSettings->getTerminationSettings( ) );
+    if( terminationSettings == nullptr )
+    {
+        throw std::runtime_error( "Error in fixed-size propagation, only time termination settings are supported" );
+    }
+    if( propagatorSettings->getDependentVariablesToSave( ) != nullptr &&
+            !propagatorSettings->getDependentVariablesToSave( )->dependentVariables_.empty( ) )
+    {
+        throw std::runtime_error( "Error in fixed-size propagation, dependent variables are not supported" );
+    }
+    const Eigen::VectorXd initialStates = propagatorSettings->getInitialStates( );
+    if( static_cast< std::size_t >( initialStates.rows( ) ) != 6 * propagatorSettings->bodiesToIntegrate_.size( ) )
+    {
+        throw std::runtime_error( "Error in fixed-size propagation, size of initial states is inconsistent" );
+    }
+
+    // As in Tudat, the propagation ends on the first step reaching the termination time, unless it is to end on it.
+    const double terminationTime = terminationSettings->terminationTime_;
+    const bool isLastStepShortened = terminationSettings->terminateExactlyOnFinalCondition_;
+    switch( propagatorSettings->bodiesToIntegrate_.size( ) )
+    {
+    case 1:
+        return propagateFixedSize< 1 >( bodyMap, *integratorSettings, *propagatorSettings, initialStates,
+                                          terminationTime, isLastStepShortened );
+    case 2:
+        return propagateFixedSize< 2 >( bodyMap, *integratorSettings, *propagatorSettings, initialStates,
+                                          terminationTime, isLastStepShortened );
+    case 3:
+        return propagateFixedSize< 3 >( bodyMap, *integratorSettings, *propagatorSettings, initialStates,
+                                          terminationTime, isLastStepShortened );
+    case 4:
+        return propagateFixedSize< 4 >( bodyMap, *integratorSettings, *propagatorSettings, initialStates,
+                                          terminationTime, isLastStepShortened );
+    default:
+        throw std::runtime_error( "Error in fixed-size propagation, at most " +
+                                  std::to_string( maximumNumberOfFixedSizeBodies ) +
+                                  " bodies can be propagated" );
+    }
+}
+
+} // namespace tudatpy
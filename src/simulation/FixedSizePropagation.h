@@ -0,0 +1,54 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_FIXED_SIZE_PROPAGATION_H
+#define TUDATPY_FIXED_SIZE_PROPAGATION_H
+
+#include <memory>
+
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+#include "StateHistory.h"
+
+namespace tudatpy
+{
+
+//! Maximum number of propagated bodies for which a fixed-size propagation is compiled.
+const int maximumNumberOfFixedSizeBodies = 4;
+
+//! Propagate translational (Cowell) dynamics with fixed-size states, without heap allocations per step.
+/*!
+ *  The state of the NumberOfBodies propagated bodies is held in an Eigen::Matrix< double, 6 * NumberOfBodies, 1 >,
+ *  for which an integrator and a state derivative are compiled for each supported number of bodies. Per evaluation,
+ *  the environment is updated directly (ephemerides and rotation of the other bodies, states of the propagated bodies,
+ *  flight conditions and radiation pressure interfaces), and the accelerations are summed as 3-vectors.
+ *
+ *  Only the subset of settings for which this is exact is supported: Cowell propagation, central bodies that are not
+ *  propagated themselves, time termination settings, no dependent variables, and the Euler, RK4 and variable step
+ *  Runge-Kutta integrators.
+ *  As with the Tudat simulator, the propagation ends on the first step that reaches the termination time. If the
+ *  propagation is to terminate exactly on the termination time, the last step is instead shortened to end on it;
+ *  Tudat then redoes the last step to the termination time, so that the final state may differ slightly (within the
+ *  integration error) for variable step integrators, whose shortened step is still subject to step size control.
+ *  \param bodyMap Bodies used in the propagation.
+ *  \param integratorSettings Settings of the numerical integrator.
+ *  \param propagatorSettings Settings of the propagation, for at most maximumNumberOfFixedSizeBodies bodies.
+ *  \return Propagated states (relative to the central bodies).
+ *  \throws std::runtime_error For settings outside the supported subset.
+ */
+StateHistory propagateFixedSizeTranslationalDynamics(
+        const tudat::simulation_setup::NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< tudat::propagators::TranslationalStatePropagatorSettings< double > >
+        propagatorSettings );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_FIXED_SIZE_PROPAGATION_H
@@ -0,0 +1,216 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/Aerodynamics/exponentialAtmosphere.h"
+#include "Tudat/Astrodynamics/Ephemerides/constantEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/keplerEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/simpleRotationalEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
+#include "Tudat/Mathematics/Interpolators/createInterpolator.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createAerodynamicCoefficientInterface.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createAtmosphereModel.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createEphemeris.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createGroundStations.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createRadiationPressureInterface.h"
+
+#include "FrozenBodyMap.h"
+#include "RotationModels.h"
+
+using namespace tudat::simulation_setup;
+using namespace tudat::ephemerides;
+
+namespace tudatpy
+{
+
+bool usesSpice( const std::shared_ptr< Ephemeris > ephemeris )
+{
+    return ephemeris != nullptr &&
+            std::dynamic_pointer_cast< ConstantEphemeris >( ephemeris ) == nullptr &&
+            std::dynamic_pointer_cast< KeplerEphemeris >( ephemeris ) == nullptr &&
+            std::dynamic_pointer_cast< TabulatedCartesianEphemeris< > >( ephemeris ) == nullptr &&
+            std::dynamic_pointer_cast< MappedTabulatedEphemeris >( ephemeris ) == nullptr;
+}
+
+bool usesSpice( const std::shared_ptr< RotationalEphemeris > rotationModel )
+{
+    if( const std::shared_ptr< TabulatedRotationalEphemeris > tabulatedRotationModel =
+            std::dynamic_pointer_cast< TabulatedRotationalEphemeris >( rotationModel ) )
+    {
+        return usesSpice( tabulatedRotationModel->getOriginalRotationModel( ) );
+    }
+    return rotationModel != nullptr &&
+            std::dynamic_pointer_cast< SimpleRotationalEphemeris >( rotationModel ) == nullptr;
+}
+
+bool usesSpice( const NamedBodyMap& bodyMap )
+{
+    for( auto bodyIterator = bodyMap.begin( ); bodyIterator != bodyMap.end( ); bodyIterator++ )
+    {
+        if( usesSpice( bodyIterator->second->getEphemeris( ) ) ||
+                usesSpice( bodyIterator->second->getRotationalEphemeris( ) ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+NamedBodyMap createBodyMapSerialized(
+        const std::map< std::string, std::shared_ptr< BodySettings > >& bodySettings,
+        const std::string& globalFrameOrigin, const std::string& globalFrameOrientation )
+{
+    static std::mutex environmentCreationMutex;
+    std::lock_guard< std::mutex > lock( environmentCreationMutex );
+
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    setGlobalFrameBodyEphemerides( bodyMap, globalFrameOrigin, globalFrameOrientation );
+    return bodyMap;
+}
+
+FrozenBodyMap::FrozenBodyMap(
+        const std::map< std::string, std::shared_ptr< BodySettings > >& bodySettings,
+        const std::string& globalFrameOrigin, const std::string& globalFrameOrientation,
+        const std::shared_ptr< const EphemerisCache > ephemerisCache ):
+    bodySettings_( bodySettings ), globalFrameOrigin_( globalFrameOrigin ),
+    globalFrameOrientation_( globalFrameOrientation )
+{
+    for( auto settingsIterator = bodySettings_.begin( ); settingsIterator != bodySettings_.end( );
+         settingsIterator++ )
+    {
+        if( !settingsIterator->second->gravityFieldVariationSettings.empty( ) )
+        {
+            throw std::runtime_error( "Error when creating frozen body map, gravity field variations of " +
+                                      settingsIterator->first + " are time-dependent and cannot be shared" );
+        }
+    }
+
+    prototypeBodyMap_ = createBodyMapSerialized( bodySettings_, globalFrameOrigin_, globalFrameOrientation_ );
+    if( ephemerisCache != nullptr )
+    {
+        ephemerisCache->setEphemerides( prototypeBodyMap_ );
+        setGlobalFrameBodyEphemerides( prototypeBodyMap_, globalFrameOrigin_, globalFrameOrientation_ );
+    }
+
+    // The tables of interpolated SPICE ephemerides are kept, so that body maps copy them instead of querying SPICE.
+    for( auto bodyIterator = prototypeBodyMap_.begin( ); bodyIterator != prototypeBodyMap_.end( ); bodyIterator++ )
+    {
+        const std::shared_ptr< TabulatedCartesianEphemeris< > > tabulatedEphemeris =
+                std::dynamic_pointer_cast< TabulatedCartesianEphemeris< > >( bodyIterator->second->getEphemeris( ) );
+        if( tabulatedEphemeris == nullptr )
+        {
+            continue;
+        }
+        const std::shared_ptr< EphemerisSettings > ephemerisSettings =
+                bodySettings_.at( bodyIterator->first )->ephemerisSettings;
+        if( std::dynamic_pointer_cast< InterpolatedSpiceEphemerisSettings >( ephemerisSettings ) != nullptr )
+        {
+            const std::vector< double > epochs = tabulatedEphemeris->getInterpolator( )->getIndependentValues( );
+            const std::vector< Eigen::Vector6d > states = tabulatedEphemeris->getInterpolator( )->getDependentValues( );
+            std::map< double, Eigen::Vector6d >& ephemerisTable = ephemerisTables_[ bodyIterator->first ];
+            for( std::size_t i = 0; i < epochs.size( ); i++ )
+            {
+                ephemerisTable[ epochs.at( i ) ] = states.at( i );
+            }
+        }
+        else if( std::dynamic_pointer_cast< TabulatedEphemerisSettings >( ephemerisSettings ) == nullptr )
+        {
+            throw std::runtime_error( "Error when creating frozen body map, tabulated ephemeris of " +
+                                      bodyIterator->first + " cannot be copied" );
+        }
+    }
+}
+
+NamedBodyMap FrozenBodyMap::createBodyMap( ) const
+{
+    NamedBodyMap bodyMap;
+
+    // Share the stateless environment models, and copy the others.
+    for( auto bodyIterator = prototypeBodyMap_.begin( ); bodyIterator != prototypeBodyMap_.end( ); bodyIterator++ )
+    {
+        const std::shared_ptr< Body > prototypeBody = bodyIterator->second;
+        const std::shared_ptr< BodySettings > settings = bodySettings_.at( bodyIterator->first );
+
+        std::shared_ptr< Body > body = std::make_shared< Body >( );
+        if( !std::isnan( settings->constantMass ) )
+        {
+            body->setConstantBodyMass( settings->constantMass );
+        }
+        if( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< > >( prototypeBody->getEphemeris( ) ) == nullptr )
+        {
+            body->setEphemeris( prototypeBody->getEphemeris( ) );
+        }
+        else if( ephemerisTables_.count( bodyIterator->first ) > 0 )
+        {
+            body->setEphemeris( std::make_shared< TabulatedCartesianEphemeris< > >(
+                                    tudat::interpolators::createOneDimensionalInterpolator(
+                                        ephemerisTables_.at( bodyIterator->first ),
+                                        std::dynamic_pointer_cast< InterpolatedSpiceEphemerisSettings >(
+                                            settings->ephemerisSettings )->getInterpolatorSettings( ) ),
+                                    prototypeBody->getEphemeris( )->getReferenceFrameOrigin( ),
+                                    prototypeBody->getEphemeris( )->getReferenceFrameOrientation( ) ) );
+        }
+        else
+        {
+            body->setEphemeris( createBodyEphemeris( settings->ephemerisSettings, bodyIterator->first ) );
+        }
+        body->setGravityFieldModel( prototypeBody->getGravityFieldModel( ) );
+        if( prototypeBody->getAtmosphereModel( ) == nullptr ||
+                std::dynamic_pointer_cast< tudat::aerodynamics::ExponentialAtmosphere >(
+                    prototypeBody->getAtmosphereModel( ) ) != nullptr )
+        {
+            body->setAtmosphereModel( prototypeBody->getAtmosphereModel( ) );
+        }
+        else
+        {
+            body->setAtmosphereModel( createAtmosphereModel( settings->atmosphereSettings, bodyIterator->first ) );
+        }
+        body->setShapeModel( prototypeBody->getShapeModel( ) );
+        body->setRotationalEphemeris( prototypeBody->getRotationalEphemeris( ) );
+        bodyMap[ bodyIterator->first ] = body;
+    }
+
+    // Re-create the models holding per-propagation state, which may refer to other bodies in the new map.
+    std::map< std::string, std::vector< std::shared_ptr< GroundStationSettings > > > groundStationSettings;
+    for( auto settingsIterator = bodySettings_.begin( ); settingsIterator != bodySettings_.end( );
+         settingsIterator++ )
+    {
+        const std::string& bodyName = settingsIterator->first;
+        const std::shared_ptr< BodySettings > settings = settingsIterator->second;
+
+        if( settings->aerodynamicCoefficientSettings != nullptr )
+        {
+            bodyMap.at( bodyName )->setAerodynamicCoefficientInterface(
+                        createAerodynamicCoefficientInterface( settings->aerodynamicCoefficientSettings, bodyName ) );
+        }
+
+        for( auto radiationIterator = settings->radiationPressureSettings.begin( );
+             radiationIterator != settings->radiationPressureSettings.end( ); radiationIterator++ )
+        {
+            bodyMap.at( bodyName )->setRadiationPressureInterface(
+                        radiationIterator->first, createRadiationPressureInterface(
+                            radiationIterator->second, bodyName, bodyMap ) );
+        }
+
+        if( !settings->groundStationSettings.empty( ) )
+        {
+            groundStationSettings[ bodyName ] = settings->groundStationSettings;
+        }
+    }
+    createGroundStations( bodyMap, groundStationSettings );
+
+    setGlobalFrameBodyEphemerides( bodyMap, globalFrameOrigin_, globalFrameOrientation_ );
+    return bodyMap;
+}
+
+} // namespace tudatpy
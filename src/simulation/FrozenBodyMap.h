@@ -0,0 +1,121 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_FROZEN_BODY_MAP_H
+#define TUDATPY_FROZEN_BODY_MAP_H
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+
+#include "EphemerisCache.h"
+
+namespace tudatpy
+{
+
+//! Create a body map from settings, serialized with all other environment creation done by tudatpy.
+/*!
+ *  Creating bodies may query SPICE (e.g. for interpolated SPICE ephemerides), which is not thread-safe; bodies that
+ *  may be created outside the Python thread must therefore be created through this function.
+ */
+tudat::simulation_setup::NamedBodyMap createBodyMapSerialized(
+        const std::map< std::string, std::shared_ptr< tudat::simulation_setup::BodySettings > >& bodySettings,
+        const std::string& globalFrameOrigin, const std::string& globalFrameOrientation );
+
+//! Whether evaluating an ephemeris may call SPICE, which is not thread-safe.
+/*!
+ *  Only ephemerides known to be analytic or tabulated (constant, Kepler, tabulated and memory-mapped tabulated
+ *  ephemerides) are considered not to; the ephemerides of direct SPICE settings, and of any other type, may.
+ */
+bool usesSpice( const std::shared_ptr< tudat::ephemerides::Ephemeris > ephemeris );
+
+//! Whether evaluating a rotation model may call SPICE (see above).
+/*!
+ *  Simple rotation models do not; tabulated rotation models do not if the model they were tabulated from does not
+ *  (as it is evaluated outside the grid).
+ */
+bool usesSpice( const std::shared_ptr< tudat::ephemerides::RotationalEphemeris > rotationModel );
+
+//! Whether the ephemeris or rotation model of any of the bodies may call SPICE (see above).
+/*!
+ *  Propagations and model evaluations using such bodies must keep the GIL, which serializes them with all other
+ *  SPICE calls made from Python, and must not run concurrently on several threads.
+ */
+bool usesSpice( const tudat::simulation_setup::NamedBodyMap& bodyMap );
+
+//! Immutable snapshot of an environment, from which body maps can be created cheaply.
+/*!
+ *  The bodies are created from their settings once. Body maps created from the snapshot contain new Body objects,
+ *  holding their own current state, that share the immutable environment models (ephemerides, gravity fields,
+ *  exponential atmospheres, rotation and shape models) of the snapshot. Models that hold per-propagation state
+ *  (radiation pressure and aerodynamic coefficient interfaces, ground stations, and flight conditions created with the
+ *  acceleration models) are re-created for every body map, from the settings. So are the models that hold the state
+ *  of their last evaluation: the interpolators of tabulated ephemerides (which store the interval found by their last
+ *  lookup) are copied, from the table of the snapshot, and all atmospheres other than exponential ones (e.g.
+ *  tabulated atmospheres, whose interpolators do the same) are created anew.
+ *
+ *  Body maps created from one snapshot can therefore be used concurrently by different threads, provided that none of
+ *  the shared models calls SPICE during the propagation (use tabulated ephemerides for multi-threaded runs).
+ */
+class FrozenBodyMap
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param bodySettings Settings of the bodies; gravity field variations are not supported.
+     *  \param globalFrameOrigin Origin of the global frame of the body ephemerides.
+     *  \param globalFrameOrientation Orientation of the global frame of the body ephemerides.
+     *  \param ephemerisCache Cache replacing the ephemerides created from the settings for all bodies it contains
+     *  (none if nullptr). Using direct SPICE ephemeris settings for those bodies avoids tabulating them upon creation.
+     */
+    FrozenBodyMap(
+            const std::map< std::string, std::shared_ptr< tudat::simulation_setup::BodySettings > >& bodySettings,
+            const std::string& globalFrameOrigin = "SSB", const std::string& globalFrameOrientation = "ECLIPJ2000",
+            const std::shared_ptr< const EphemerisCache > ephemerisCache = nullptr );
+
+    //! Create a new body map, sharing the immutable environment models of the snapshot.
+    tudat::simulation_setup::NamedBodyMap createBodyMap( ) const;
+
+    //! Settings from which the snapshot was created.
+    const std::map< std::string, std::shared_ptr< tudat::simulation_setup::BodySettings > >& getBodySettings( ) const
+    {
+        return bodySettings_;
+    }
+
+    //! Bodies created from the settings, holding the shared environment models.
+    const tudat::simulation_setup::NamedBodyMap& getPrototypeBodyMap( ) const
+    {
+        return prototypeBodyMap_;
+    }
+
+private:
+
+    //! Settings from which the snapshot was created.
+    std::map< std::string, std::shared_ptr< tudat::simulation_setup::BodySettings > > bodySettings_;
+
+    //! Origin of the global frame of the body ephemerides.
+    std::string globalFrameOrigin_;
+
+    //! Orientation of the global frame of the body ephemerides.
+    std::string globalFrameOrientation_;
+
+    //! Bodies created from the settings, holding the shared environment models.
+    tudat::simulation_setup::NamedBodyMap prototypeBodyMap_;
+
+    //! Tables of the tabulated ephemerides of the snapshot, from which every body map creates its own interpolators.
+    std::map< std::string, std::map< double, Eigen::Vector6d > > ephemerisTables_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_FROZEN_BODY_MAP_H
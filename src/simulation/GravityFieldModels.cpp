@@ -0,0 +1,182 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityField.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createGravityField.h"
+
+#include "Conversions.h"
+#include "GravityFieldModels.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::gravitation;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Number of points evaluated by a worker thread per task.
+const std::size_t pointsPerTask = 256;
+
+} // namespace
+
+void computeSphericalHarmonicAccelerations(
+        const double gravitationalParameter, const double referenceRadius, const Eigen::MatrixXd& cosineCoefficients,
+        const Eigen::MatrixXd& sineCoefficients, const std::size_t numberOfPoints, const double* positions,
+        double* accelerations, const unsigned int numberOfThreads )
+{
+    const std::size_t numberOfTasks = ( numberOfPoints + pointsPerTask - 1 ) / pointsPerTask;
+    const unsigned int numberOfWorkers = getNumberOfThreads( numberOfThreads, numberOfTasks );
+
+    // Caches are created up front, so that each is allocated once and reused for all points of its thread.
+    const int cacheSize = static_cast< int >( cosineCoefficients.rows( ) ) + 1;
+    std::vector< std::shared_ptr< tudat::basic_mathematics::SphericalHarmonicsCache > > caches;
+    std::vector< std::map< std::pair< int, int >, Eigen::Vector3d > > accelerationsPerTerm( numberOfWorkers );
+    for( unsigned int i = 0; i < numberOfWorkers; i++ )
+    {
+        caches.push_back( std::make_shared< tudat::basic_mathematics::SphericalHarmonicsCache >(
+                              cacheSize, cacheSize ) );
+    }
+
+    parallelFor( numberOfTasks, numberOfWorkers, [ & ]( const std::size_t taskIndex, const unsigned int threadIndex )
+    {
+        const std::size_t lastPoint = std::min( numberOfPoints, ( taskIndex + 1 ) * pointsPerTask );
+        for( std::size_t i = taskIndex * pointsPerTask; i < lastPoint; i++ )
+        {
+            Eigen::Map< Eigen::Vector3d >( accelerations + 3 * i ) =
+                    computeGeodesyNormalizedGravitationalAccelerationSum(
+                        Eigen::Map< const Eigen::Vector3d >( positions + 3 * i ), gravitationalParameter,
+                        referenceRadius, cosineCoefficients, sineCoefficients, caches.at( threadIndex ),
+                        accelerationsPerTerm.at( threadIndex ) );
+        }
+    } );
+}
+
+namespace
+{
+
+object getSphericalHarmonicAccelerations(
+        SphericalHarmonicsGravityField& gravityField, const object& positions, const int maximumDegree,
+        const int maximumOrder, const unsigned int numberOfThreads )
+{
+    const ContiguousArray positionArray( positions, 2 );
+    if( positionArray.columns( ) != 3 )
+    {
+        throw std::runtime_error( "Error when evaluating gravity field, positions must be an (N x 3) array" );
+    }
+
+    const Eigen::MatrixXd cosineCoefficients = gravityField.getCosineCoefficients( );
+    const Eigen::MatrixXd sineCoefficients = gravityField.getSineCoefficients( );
+    const int degree = maximumDegree < 0 ? static_cast< int >( cosineCoefficients.rows( ) ) - 1 : maximumDegree;
+    const int order = maximumOrder < 0 ? static_cast< int >( cosineCoefficients.cols( ) ) - 1 : maximumOrder;
+    if( degree >= cosineCoefficients.rows( ) || order >= cosineCoefficients.cols( ) || order > degree )
+    {
+        throw std::runtime_error( "Error when evaluating gravity field, degree and order are not available" );
+    }
+
+    numpy::ndarray accelerations = createArray( positionArray.rows( ), 3 );
+    double* accelerationData = getArrayData( accelerations );
+    {
+        ScopedGilRelease gilRelease;
+        computeSphericalHarmonicAccelerations(
+                    gravityField.getGravitationalParameter( ), gravityField.getReferenceRadius( ),
+                    cosineCoefficients.block( 0, 0, degree + 1, order + 1 ),
+                    sineCoefficients.block( 0, 0, degree + 1, order + 1 ),
+                    positionArray.rows( ), positionArray.data( ), accelerationData, numberOfThreads );
+    }
+    return accelerations;
+}
+
+object getGravitationalAcceleration( GravityFieldModel& gravityField, const object& position )
+{
+    return createArray( gravityField.getGravitationalAcceleration( extractVector( position ) ) );
+}
+
+std::shared_ptr< SphericalHarmonicsGravityFieldSettings > createSphericalHarmonicsGravityFieldSettings(
+        const double gravitationalParameter, const double referenceRadius, const object& cosineCoefficients,
+        const object& sineCoefficients, const std::string& associatedReferenceFrame )
+{
+    const ContiguousArray cosineArray( cosineCoefficients, 2 );
+    const ContiguousArray sineArray( sineCoefficients, 2 );
+    if( cosineArray.rows( ) != sineArray.rows( ) || cosineArray.columns( ) != sineArray.columns( ) )
+    {
+        throw std::runtime_error( "Error when creating gravity field settings, coefficient sizes are inconsistent" );
+    }
+    typedef Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor > RowMajorMatrix;
+    return std::make_shared< SphericalHarmonicsGravityFieldSettings >(
+                gravitationalParameter, referenceRadius,
+                Eigen::Map< const RowMajorMatrix >( cosineArray.data( ), cosineArray.rows( ), cosineArray.columns( ) ),
+                Eigen::Map< const RowMajorMatrix >( sineArray.data( ), sineArray.rows( ), sineArray.columns( ) ),
+                associatedReferenceFrame );
+}
+
+std::shared_ptr< GravityFieldModel > createBodyGravityFieldModel(
+        const std::shared_ptr< GravityFieldSettings > gravityFieldSettings, const std::string& body )
+{
+    return createGravityFieldModel( gravityFieldSettings, body );
+}
+
+} // namespace
+
+void exposeGravityFieldModels( )
+{
+    class_< GravityFieldSettings, std::shared_ptr< GravityFieldSettings >, boost::noncopyable >(
+                "GravityFieldSettings", no_init )
+            ;
+
+    class_< CentralGravityFieldSettings, std::shared_ptr< CentralGravityFieldSettings >,
+            bases< GravityFieldSettings >, boost::noncopyable >(
+                "CentralGravityFieldSettings", init< double >( arg( "gravitational_parameter" ) ) )
+            ;
+
+    class_< SphericalHarmonicsGravityFieldSettings, std::shared_ptr< SphericalHarmonicsGravityFieldSettings >,
+            bases< GravityFieldSettings >, boost::noncopyable >(
+                "SphericalHarmonicsGravityFieldSettings",
+                "Spherical harmonic gravity field with geodesy-normalized (degree x order) coefficient arrays.",
+                no_init )
+            .def( "__init__", make_constructor(
+                      &createSphericalHarmonicsGravityFieldSettings, default_call_policies( ),
+                      ( arg( "gravitational_parameter" ), arg( "reference_radius" ), arg( "cosine_coefficients" ),
+                        arg( "sine_coefficients" ), arg( "associated_reference_frame" ) ) ) )
+            ;
+
+    def( "create_gravity_field_model", &createBodyGravityFieldModel,
+         ( arg( "gravity_field_settings" ), arg( "body_name" ) ) );
+
+    class_< GravityFieldModel, std::shared_ptr< GravityFieldModel >, boost::noncopyable >(
+                "GravityFieldModel", no_init )
+            .add_property( "gravitational_parameter", &GravityFieldModel::getGravitationalParameter )
+            .def( "get_gravitational_acceleration", &getGravitationalAcceleration, arg( "body_fixed_position" ) )
+            ;
+
+    class_< SphericalHarmonicsGravityField, std::shared_ptr< SphericalHarmonicsGravityField >,
+            bases< GravityFieldModel >, boost::noncopyable >( "SphericalHarmonicsGravityField", no_init )
+            .add_property( "reference_radius", &SphericalHarmonicsGravityField::getReferenceRadius )
+            .def( "get_accelerations", &getSphericalHarmonicAccelerations,
+                  ( arg( "body_fixed_positions" ), arg( "maximum_degree" ) = -1, arg( "maximum_order" ) = -1,
+                    arg( "number_of_threads" ) = 0 ),
+                  "Accelerations at an (N x 3) array of body-fixed positions, evaluated natively with the GIL\n"
+                  "released on number_of_threads threads (0 for all hardware threads). A negative maximum degree or\n"
+                  "order selects the full expansion." )
+            ;
+}
+
+} // namespace tudatpy
@@ -0,0 +1,42 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_GRAVITY_FIELD_MODELS_H
+#define TUDATPY_GRAVITY_FIELD_MODELS_H
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+namespace tudatpy
+{
+
+//! Compute spherical harmonic gravitational accelerations at a series of body-fixed positions.
+/*!
+ *  The points are split into blocks that are distributed over the worker threads. Each thread allocates a single
+ *  Legendre polynomial cache, sized for the requested degree and order, which is reused for all points it evaluates.
+ *  Does not touch any Python object, so that it may be called with the GIL released.
+ *  \param gravitationalParameter Gravitational parameter of the body.
+ *  \param referenceRadius Reference radius of the spherical harmonic expansion.
+ *  \param cosineCoefficients Geodesy-normalized cosine coefficients, truncated to the degree and order to evaluate.
+ *  \param sineCoefficients Geodesy-normalized sine coefficients, truncated to the degree and order to evaluate.
+ *  \param numberOfPoints Number of points.
+ *  \param positions Row-major (numberOfPoints x 3) block of body-fixed positions.
+ *  \param accelerations Row-major (numberOfPoints x 3) block to which the body-fixed accelerations are written.
+ *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+ */
+void computeSphericalHarmonicAccelerations(
+        const double gravitationalParameter, const double referenceRadius, const Eigen::MatrixXd& cosineCoefficients,
+        const Eigen::MatrixXd& sineCoefficients, const std::size_t numberOfPoints, const double* positions,
+        double* accelerations, const unsigned int numberOfThreads );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_GRAVITY_FIELD_MODELS_H
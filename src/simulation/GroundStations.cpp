@@ -0,0 +1,286 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createGroundStations.h"
+
+#include "Conversions.h"
+#include "GroundStations.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Number of epochs evaluated by a worker thread per task.
+const std::size_t epochsPerTask = 1024;
+
+} // namespace
+
+GroundStationFrame createGroundStationFrame( const Eigen::Vector3d& position, const double geodeticLatitude,
+                                             const double longitude )
+{
+    const double sineLatitude = std::sin( geodeticLatitude );
+    const double cosineLatitude = std::cos( geodeticLatitude );
+    const double sineLongitude = std::sin( longitude );
+    const double cosineLongitude = std::cos( longitude );
+
+    GroundStationFrame frame;
+    frame.position = position;
+    frame.rotationToTopocentricFrame <<
+            -sineLongitude, cosineLongitude, 0.0,
+            -sineLatitude * cosineLongitude, -sineLatitude * sineLongitude, cosineLatitude,
+            cosineLatitude * cosineLongitude, cosineLatitude * sineLongitude, sineLatitude;
+    return frame;
+}
+
+void computeGroundStationGeometry(
+        const std::vector< GroundStationFrame >& stations, const std::size_t numberOfEpochs,
+        const std::vector< Eigen::Matrix3d >& rotationsToBaseFrame,
+        const std::vector< Eigen::Matrix3d >& rotationDerivatives, const double* states, double* elevations,
+        double* azimuths, double* ranges, double* rangeRates, const unsigned int numberOfThreads )
+{
+    const std::size_t numberOfTasks = ( numberOfEpochs + epochsPerTask - 1 ) / epochsPerTask;
+    parallelFor( numberOfTasks, getNumberOfThreads( numberOfThreads, numberOfTasks ),
+                 [ & ]( const std::size_t taskIndex, const unsigned int )
+    {
+        const std::size_t lastEpoch = std::min( numberOfEpochs, ( taskIndex + 1 ) * epochsPerTask );
+        for( std::size_t j = taskIndex * epochsPerTask; j < lastEpoch; j++ )
+        {
+            const Eigen::Map< const Eigen::Vector3d > position( states + 6 * j );
+            const Eigen::Map< const Eigen::Vector3d > velocity( states + 6 * j + 3 );
+            const Eigen::Vector3d bodyFixedPosition = rotationsToBaseFrame[ j ].transpose( ) * position;
+            for( std::size_t i = 0; i < stations.size( ); i++ )
+            {
+                const std::size_t index = i * numberOfEpochs + j;
+                const Eigen::Vector3d topocentricPosition = stations[ i ].rotationToTopocentricFrame *
+                        ( bodyFixedPosition - stations[ i ].position );
+                const double range = topocentricPosition.norm( );
+
+                // Relative velocity in the base frame, including the velocity of the station due to the rotation.
+                const Eigen::Vector3d relativePosition = position - rotationsToBaseFrame[ j ] * stations[ i ].position;
+                const Eigen::Vector3d relativeVelocity = velocity - rotationDerivatives[ j ] * stations[ i ].position;
+
+                ranges[ index ] = range;
+                rangeRates[ index ] = relativePosition.dot( relativeVelocity ) / range;
+                elevations[ index ] = std::asin( topocentricPosition.z( ) / range );
+                const double azimuth = std::atan2( topocentricPosition.x( ), topocentricPosition.y( ) );
+                azimuths[ index ] = azimuth < 0.0 ? azimuth + 2.0 * M_PI : azimuth;
+            }
+        }
+    } );
+}
+
+std::vector< std::pair< double, double > > computeVisibilityWindows(
+        const std::size_t numberOfEpochs, const double* epochs, const double* elevations,
+        const double minimumElevation )
+{
+    // Epoch between two samples at which the elevation crosses the minimum elevation.
+    const auto getCrossingEpoch = [ & ]( const std::size_t index )
+    {
+        const double fraction = ( minimumElevation - elevations[ index ] ) /
+                ( elevations[ index + 1 ] - elevations[ index ] );
+        return epochs[ index ] + fraction * ( epochs[ index + 1 ] - epochs[ index ] );
+    };
+
+    std::vector< std::pair< double, double > > windows;
+    bool isVisible = false;
+    double windowStart = 0.0;
+    for( std::size_t i = 0; i < numberOfEpochs; i++ )
+    {
+        const bool isVisibleAtEpoch = elevations[ i ] >= minimumElevation;
+        if( isVisibleAtEpoch && !isVisible )
+        {
+            windowStart = i == 0 ? epochs[ 0 ] : getCrossingEpoch( i - 1 );
+        }
+        else if( !isVisibleAtEpoch && isVisible )
+        {
+            windows.push_back( std::make_pair( windowStart, getCrossingEpoch( i - 1 ) ) );
+        }
+        isVisible = isVisibleAtEpoch;
+    }
+    if( isVisible )
+    {
+        windows.push_back( std::make_pair( windowStart, epochs[ numberOfEpochs - 1 ] ) );
+    }
+    return windows;
+}
+
+namespace
+{
+
+dict computeGroundStationGeometryFromPython(
+        const NamedBodyMap& bodyMap, const std::string& bodyName, const object& epochs, const object& states,
+        const object& stationNames, const double minimumElevation, const unsigned int numberOfThreads )
+{
+    if( bodyMap.count( bodyName ) == 0 )
+    {
+        throw std::runtime_error( "Error when computing ground station geometry, body " + bodyName +
+                                  " does not exist" );
+    }
+    const std::shared_ptr< Body > body = bodyMap.at( bodyName );
+    const std::shared_ptr< tudat::ephemerides::RotationalEphemeris > rotationModel = body->getRotationalEphemeris( );
+    if( rotationModel == nullptr )
+    {
+        throw std::runtime_error( "Error when computing ground station geometry, body " + bodyName +
+                                  " has no rotation model" );
+    }
+
+    const ContiguousArray epochArray( epochs );
+    const ContiguousArray stateArray( states, 2 );
+    if( stateArray.columns( ) != 6 || stateArray.rows( ) != epochArray.size( ) )
+    {
+        throw std::runtime_error( "Error when computing ground station geometry, states must be an (N x 6) array "
+                                  "at the N epochs" );
+    }
+    const std::size_t numberOfEpochs = epochArray.size( );
+    // The visibility windows are interpolated between consecutive epochs.
+    for( std::size_t j = 1; j < numberOfEpochs; j++ )
+    {
+        if( !( epochArray.data( )[ j ] > epochArray.data( )[ j - 1 ] ) )
+        {
+            throw std::runtime_error( "Error when computing ground station geometry, epochs must be strictly "
+                                      "increasing" );
+        }
+    }
+
+    const auto groundStationMap = body->getGroundStationMap( );
+    const std::vector< std::string > selectedStations = stationNames.is_none( ) ?
+                std::vector< std::string >( ) : extractList< std::string >( stationNames );
+    list selectedStationNames;
+    std::vector< GroundStationFrame > stations;
+    for( auto stationIterator = groundStationMap.begin( ); stationIterator != groundStationMap.end( );
+         stationIterator++ )
+    {
+        if( stationNames.is_none( ) || std::find( selectedStations.begin( ), selectedStations.end( ),
+                                                  stationIterator->first ) != selectedStations.end( ) )
+        {
+            const std::shared_ptr< tudat::ground_stations::GroundStationState > stationState =
+                    stationIterator->second->getNominalStationState( );
+            const Eigen::Vector3d geodeticPosition = stationState->getNominalGeodeticPosition( );
+            stations.push_back( createGroundStationFrame( stationState->getNominalCartesianPosition( ),
+                                                          geodeticPosition( 1 ), geodeticPosition( 2 ) ) );
+            selectedStationNames.append( stationIterator->first );
+        }
+    }
+    if( !stationNames.is_none( ) && stations.size( ) != selectedStations.size( ) )
+    {
+        throw std::runtime_error( "Error when computing ground station geometry, not all stations exist on body " +
+                                  bodyName );
+    }
+
+    // The rotation model is evaluated serially (it may call SPICE), once per epoch for all stations.
+    std::vector< Eigen::Matrix3d > rotationsToBaseFrame( numberOfEpochs );
+    std::vector< Eigen::Matrix3d > rotationDerivatives( numberOfEpochs );
+    for( std::size_t j = 0; j < numberOfEpochs; j++ )
+    {
+        const double epoch = epochArray.data( )[ j ];
+        rotationsToBaseFrame[ j ] = rotationModel->getRotationToBaseFrame( epoch ).toRotationMatrix( );
+        rotationDerivatives[ j ] = rotationModel->getDerivativeOfRotationToBaseFrame( epoch );
+    }
+
+    numpy::ndarray elevations = createArray( stations.size( ), numberOfEpochs );
+    numpy::ndarray azimuths = createArray( stations.size( ), numberOfEpochs );
+    numpy::ndarray ranges = createArray( stations.size( ), numberOfEpochs );
+    numpy::ndarray rangeRates = createArray( stations.size( ), numberOfEpochs );
+    double* elevationData = getArrayData( elevations );
+    double* azimuthData = getArrayData( azimuths );
+    double* rangeData = getArrayData( ranges );
+    double* rangeRateData = getArrayData( rangeRates );
+    std::vector< std::vector< std::pair< double, double > > > windows( stations.size( ) );
+    {
+        ScopedGilRelease gilRelease;
+        computeGroundStationGeometry( stations, numberOfEpochs, rotationsToBaseFrame, rotationDerivatives,
+                                      stateArray.data( ), elevationData, azimuthData, rangeData, rangeRateData,
+                                      numberOfThreads );
+        for( std::size_t i = 0; i < stations.size( ); i++ )
+        {
+            windows[ i ] = computeVisibilityWindows( numberOfEpochs, epochArray.data( ),
+                                                     elevationData + i * numberOfEpochs, minimumElevation );
+        }
+    }
+
+    dict visibilityWindows;
+    for( std::size_t i = 0; i < stations.size( ); i++ )
+    {
+        numpy::ndarray stationWindows = createArray( windows[ i ].size( ), 2 );
+        double* windowData = getArrayData( stationWindows );
+        for( std::size_t k = 0; k < windows[ i ].size( ); k++ )
+        {
+            windowData[ 2 * k ] = windows[ i ][ k ].first;
+            windowData[ 2 * k + 1 ] = windows[ i ][ k ].second;
+        }
+        visibilityWindows[ selectedStationNames[ i ] ] = stationWindows;
+    }
+
+    dict geometry;
+    geometry[ "station_names" ] = selectedStationNames;
+    geometry[ "elevation" ] = elevations;
+    geometry[ "azimuth" ] = azimuths;
+    geometry[ "range" ] = ranges;
+    geometry[ "range_rate" ] = rangeRates;
+    geometry[ "visibility_windows" ] = visibilityWindows;
+    return geometry;
+}
+
+std::shared_ptr< GroundStationSettings > createGroundStationSettings(
+        const std::string& stationName, const object& position,
+        const tudat::coordinate_conversions::PositionElementTypes positionElementType )
+{
+    return std::make_shared< GroundStationSettings >( stationName, extractVector( position ), positionElementType );
+}
+
+} // namespace
+
+void exposeGroundStations( )
+{
+    enum_< tudat::coordinate_conversions::PositionElementTypes >( "PositionElementTypes" )
+            .value( "cartesian_position", tudat::coordinate_conversions::cartesian_position )
+            .value( "spherical_position", tudat::coordinate_conversions::spherical_position )
+            .value( "geodetic_position", tudat::coordinate_conversions::geodetic_position )
+            ;
+
+    class_< GroundStationSettings, std::shared_ptr< GroundStationSettings >, boost::noncopyable >(
+                "GroundStationSettings", no_init )
+            .def( "__init__", make_constructor(
+                      &createGroundStationSettings, default_call_policies( ),
+                      ( arg( "station_name" ), arg( "station_position" ),
+                        arg( "position_element_type" ) = tudat::coordinate_conversions::cartesian_position ) ),
+                  "Ground station at a body-fixed position, given as Cartesian coordinates, as (radius, latitude,\n"
+                  "longitude), or as (altitude, geodetic latitude, longitude)." )
+            .add_property( "station_name", &GroundStationSettings::getStationName )
+            ;
+
+    def( "compute_ground_station_geometry", &computeGroundStationGeometryFromPython,
+         ( arg( "body_map" ), arg( "body_name" ), arg( "epochs" ), arg( "states" ), arg( "station_names" ) = object( ),
+           arg( "minimum_elevation" ) = 0.0, arg( "number_of_threads" ) = 0 ),
+         "Link geometry between the ground stations of a body and a spacecraft, given by an (N x 6) array of\n"
+         "states relative to the body (in the base frame of its rotation model) at N strictly increasing epochs\n"
+         "(else RuntimeError is raised), as computed by a propagation with the body as central body.\n\n"
+         "Returns a dict with the 'station_names' (all stations of the body, or those given), the\n"
+         "(stations x N) arrays 'elevation', 'azimuth' (from north, towards east), 'range' and 'range_rate', and\n"
+         "the 'visibility_windows' of each station as a (windows x 2) array of start and end epochs at which the\n"
+         "elevation is at least minimum_elevation (interpolated linearly between the epochs). The geometry is\n"
+         "computed natively on number_of_threads threads (0 for all hardware threads) with the GIL released." );
+}
+
+} // namespace tudatpy
@@ -0,0 +1,76 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_GROUND_STATIONS_H
+#define TUDATPY_GROUND_STATIONS_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudatpy
+{
+
+//! Position and local horizon of a ground station, fixed to its body.
+struct GroundStationFrame
+{
+    //! Body-fixed Cartesian position.
+    Eigen::Vector3d position;
+
+    //! Rotation from the body-fixed to the topocentric (east, north, up) frame, with the up axis normal to the
+    //! reference ellipsoid.
+    Eigen::Matrix3d rotationToTopocentricFrame;
+};
+
+//! Create the frame of a ground station from its body-fixed position and geodetic latitude and longitude.
+GroundStationFrame createGroundStationFrame( const Eigen::Vector3d& position, const double geodeticLatitude,
+                                             const double longitude );
+
+//! Compute the link geometry between a set of ground stations and a spacecraft at a series of epochs.
+/*!
+ *  The epochs are split into blocks that are distributed over the worker threads. Does not touch any Python object,
+ *  so that it may be called with the GIL released.
+ *  \param stations Frames of the ground stations.
+ *  \param numberOfEpochs Number of epochs.
+ *  \param rotationsToBaseFrame Rotation matrices from the body-fixed to the base frame at each epoch.
+ *  \param rotationDerivatives Time derivatives of rotationsToBaseFrame at each epoch.
+ *  \param states Row-major (numberOfEpochs x 6) block of spacecraft states relative to the body of the stations, in
+ *  the base frame of its rotation model.
+ *  \param elevations Row-major (number of stations x numberOfEpochs) block to which the elevations are written.
+ *  \param azimuths Block to which the azimuths (from north, positive towards east) are written, as elevations.
+ *  \param ranges Block to which the ranges are written, as elevations.
+ *  \param rangeRates Block to which the range rates are written, as elevations.
+ *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+ */
+void computeGroundStationGeometry(
+        const std::vector< GroundStationFrame >& stations, const std::size_t numberOfEpochs,
+        const std::vector< Eigen::Matrix3d >& rotationsToBaseFrame,
+        const std::vector< Eigen::Matrix3d >& rotationDerivatives, const double* states, double* elevations,
+        double* azimuths, double* ranges, double* rangeRates, const unsigned int numberOfThreads );
+
+//! Determine the intervals in which an elevation series exceeds a minimum elevation.
+/*!
+ *  The start and end of each interval are found by linear interpolation of the elevation between the epochs around
+ *  the crossing; intervals that are open at the start or end of the series begin or end at its first or last epoch.
+ *  \param numberOfEpochs Number of epochs.
+ *  \param epochs Epochs, in strictly increasing order (so that no interpolation interval has zero length).
+ *  \param elevations Elevations at the epochs.
+ *  \param minimumElevation Minimum elevation at which the station is considered visible.
+ *  \return Start and end epoch of each visibility window.
+ */
+std::vector< std::pair< double, double > > computeVisibilityWindows(
+        const std::size_t numberOfEpochs, const double* epochs, const double* elevations,
+        const double minimumElevation );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_GROUND_STATIONS_H
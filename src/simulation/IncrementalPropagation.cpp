@@ -0,0 +1,310 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Conversions.h"
+#include "FrozenBodyMap.h"
+#include "IncrementalPropagation.h"
+#include "Parallel.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+BaselineCheckpointRecorder::BaselineCheckpointRecorder( const std::size_t stepsPerCheckpoint ):
+    stepsPerCheckpoint_( stepsPerCheckpoint ), initialTime_( 0.0 ), integratorType_( 0 ), dependentVariableSize_( 0 ),
+    numberOfRows_( 0 )
+{
+    if( stepsPerCheckpoint_ == 0 )
+    {
+        throw std::runtime_error( "Error when creating baseline checkpoints, number of steps between checkpoints "
+                                  "must be positive" );
+    }
+}
+
+void BaselineCheckpointRecorder::start( const double initialTime, const Eigen::VectorXd& initialStates,
+                                        const int integratorType, const std::size_t dependentVariableSize )
+{
+    initialTime_ = initialTime;
+    initialStates_ = initialStates;
+    integratorType_ = integratorType;
+    dependentVariableSize_ = dependentVariableSize;
+    numberOfRows_ = 0;
+    checkpoints_.clear( );
+}
+
+void BaselineCheckpointRecorder::writeCheckpoint( const PropagationLoopState& loopState )
+{
+    // The checkpoint at the end of the propagation may coincide with the last one that was due.
+    if( checkpoints_.empty( ) || checkpoints_.back( ).numberOfRows != numberOfRows_ )
+    {
+        checkpoints_.push_back( BaselineCheckpoint{ numberOfRows_, loopState } );
+    }
+}
+
+bool BaselinePrefixResumer::resume( const double initialTime, const Eigen::VectorXd& initialStates,
+                                    const int integratorType, PropagationOutputSink& outputSink,
+                                    PropagationLoopState& loopState )
+{
+    const std::vector< BaselineCheckpoint >& checkpoints = recorder_.getCheckpoints( );
+    if( checkpoints.empty( ) )
+    {
+        return false;
+    }
+    if( initialTime != recorder_.getInitialTime( ) || integratorType != recorder_.getIntegratorType( ) ||
+            initialStates.rows( ) != recorder_.getInitialStates( ).rows( ) ||
+            initialStates != recorder_.getInitialStates( ) )
+    {
+        throw std::runtime_error( "Error when propagating variation of baseline, initial epoch, initial states and "
+                                  "integrator must equal those of the baseline" );
+    }
+
+    // Checkpoint epochs are monotonic in the direction of propagation.
+    const bool isForward = checkpoints.front( ).loopState.currentTime > initialTime;
+    resumedCheckpoint_ = nullptr;
+    for( std::size_t i = 0; i < checkpoints.size( ); i++ )
+    {
+        const double checkpointTime = checkpoints.at( i ).loopState.currentTime;
+        if( isForward ? !( checkpointTime < unchangedUntil_ ) : !( checkpointTime > unchangedUntil_ ) )
+        {
+            break;
+        }
+        resumedCheckpoint_ = &checkpoints.at( i );
+    }
+    if( resumedCheckpoint_ == nullptr )
+    {
+        return false;
+    }
+
+    const std::size_t dependentVariableSize = recorder_.getDependentVariableSize( );
+    outputSink.initialize( stateHistory_.getStateSize( ), dependentVariableSize );
+    Eigen::VectorXd state( stateHistory_.getStateSize( ) );
+    Eigen::VectorXd dependentVariables( dependentVariableSize );
+    for( std::size_t i = 0; i < resumedCheckpoint_->numberOfRows; i++ )
+    {
+        std::copy( stateHistory_.getState( i ), stateHistory_.getState( i ) + state.rows( ), state.data( ) );
+        if( dependentVariableSize > 0 )
+        {
+            std::copy( dependentVariableHistory_.getState( i ),
+                       dependentVariableHistory_.getState( i ) + dependentVariableSize, dependentVariables.data( ) );
+        }
+        outputSink.append( stateHistory_.getEpochs( )[ i ], state, dependentVariables );
+    }
+    loopState = resumedCheckpoint_->loopState;
+    return true;
+}
+
+IncrementalPropagation::IncrementalPropagation(
+        const NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+        const std::size_t stepsPerCheckpoint ):
+    bodyMap_( bodyMap ), integratorSettings_( integratorSettings ),
+    baseline_( std::make_shared< SingleArcSimulation >( bodyMap, integratorSettings, propagatorSettings, false,
+                                                        contiguous_history_storage ) ),
+    recorder_( stepsPerCheckpoint )
+{
+    // Fails early for integrators that cannot be resumed.
+    createRestartIntegratorSettings( integratorSettings_, PropagationLoopState( ) );
+}
+
+namespace
+{
+
+//! Whether two propagator settings save the same dependent variables, in the same order.
+bool haveEqualDependentVariables( const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+                                  const std::shared_ptr< PropagatorSettings< double > > otherPropagatorSettings )
+{
+    const std::shared_ptr< SingleArcPropagatorSettings< double > > singleArcSettings =
+            std::dynamic_pointer_cast< SingleArcPropagatorSettings< double > >( propagatorSettings );
+    const std::shared_ptr< SingleArcPropagatorSettings< double > > otherSingleArcSettings =
+            std::dynamic_pointer_cast< SingleArcPropagatorSettings< double > >( otherPropagatorSettings );
+    if( singleArcSettings == nullptr || otherSingleArcSettings == nullptr )
+    {
+        return false;
+    }
+
+    const std::shared_ptr< DependentVariableSaveSettings > dependentVariableSettings =
+            singleArcSettings->getDependentVariablesToSave( );
+    const std::shared_ptr< DependentVariableSaveSettings > otherDependentVariableSettings =
+            otherSingleArcSettings->getDependentVariablesToSave( );
+    const std::size_t numberOfVariables =
+            dependentVariableSettings == nullptr ? 0 : dependentVariableSettings->dependentVariables_.size( );
+    const std::size_t otherNumberOfVariables =
+            otherDependentVariableSettings == nullptr ? 0 : otherDependentVariableSettings->dependentVariables_.size( );
+    if( numberOfVariables != otherNumberOfVariables )
+    {
+        return false;
+    }
+    for( std::size_t i = 0; i < numberOfVariables; i++ )
+    {
+        const std::shared_ptr< SingleDependentVariableSaveSettings > variableSettings =
+                dependentVariableSettings->dependentVariables_.at( i );
+        const std::shared_ptr< SingleDependentVariableSaveSettings > otherVariableSettings =
+                otherDependentVariableSettings->dependentVariables_.at( i );
+        if( variableSettings->dependentVariableType_ != otherVariableSettings->dependentVariableType_ ||
+                variableSettings->associatedBody_ != otherVariableSettings->associatedBody_ ||
+                variableSettings->secondaryBody_ != otherVariableSettings->secondaryBody_ )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void IncrementalPropagation::propagateBaseline( )
+{
+    std::lock_guard< std::mutex > lock( propagationMutex_ );
+    baseline_->integrateEquationsOfMotion( baseline_->getSimulator( )->getPropagatorSettings( )->getInitialStates( ),
+                                           recorder_ );
+}
+
+std::shared_ptr< SingleArcSimulation > IncrementalPropagation::propagate(
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings, const double unchangedUntil,
+        double& resumedEpoch ) const
+{
+    std::lock_guard< std::mutex > lock( propagationMutex_ );
+    if( !haveEqualDependentVariables( propagatorSettings, baseline_->getSimulator( )->getPropagatorSettings( ) ) )
+    {
+        throw std::runtime_error( "Error when propagating variation of baseline, dependent variables must equal "
+                                  "those of the baseline" );
+    }
+
+    const std::shared_ptr< SingleArcSimulation > simulation = std::make_shared< SingleArcSimulation >(
+                bodyMap_, integratorSettings_, propagatorSettings, false, contiguous_history_storage );
+    BaselinePrefixResumer resumer( recorder_, *baseline_->getStateHistory( ),
+                                   *baseline_->getDependentVariableHistory( ), unchangedUntil );
+    simulation->integrateEquationsOfMotion( propagatorSettings->getInitialStates( ), resumer );
+
+    // The sizes of the dependent variables may still differ (e.g. for variables of bodies with other models).
+    const StateHistory& stateHistory = *simulation->getStateHistory( );
+    const StateHistory& dependentVariableHistory = *simulation->getDependentVariableHistory( );
+    const std::size_t dependentVariableSize = recorder_.getDependentVariableSize( );
+    if( dependentVariableHistory.size( ) != ( dependentVariableSize > 0 ? stateHistory.size( ) : 0 ) ||
+            ( dependentVariableSize > 0 && dependentVariableHistory.getStateSize( ) != dependentVariableSize ) )
+    {
+        throw std::runtime_error( "Error when propagating variation of baseline, dependent variables must equal "
+                                  "those of the baseline" );
+    }
+    resumedEpoch = resumer.getResumedCheckpoint( ) != nullptr ?
+                resumer.getResumedCheckpoint( )->loopState.currentTime : integratorSettings_->initialTime_;
+    return simulation;
+}
+
+namespace
+{
+
+std::shared_ptr< IncrementalPropagation > createIncrementalPropagation(
+        const NamedBodyMap& bodyMap,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+        const std::size_t stepsPerCheckpoint )
+{
+    const std::shared_ptr< IncrementalPropagation > propagation = std::make_shared< IncrementalPropagation >(
+                bodyMap, integratorSettings, propagatorSettings, stepsPerCheckpoint );
+    {
+        ScopedGilRelease gilRelease( !usesSpice( bodyMap ) );
+        propagation->propagateBaseline( );
+    }
+    return propagation;
+}
+
+object propagateVariation( const IncrementalPropagation& propagation,
+                           const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+                           const double unchangedUntil )
+{
+    std::shared_ptr< SingleArcSimulation > simulation;
+    double resumedEpoch;
+    {
+        ScopedGilRelease gilRelease( !usesSpice( propagation.getBodyMap( ) ) );
+        simulation = propagation.propagate( propagatorSettings, unchangedUntil, resumedEpoch );
+    }
+    return boost::python::make_tuple( simulation, resumedEpoch );
+}
+
+object getCheckpointEpochs( const IncrementalPropagation& propagation )
+{
+    const std::vector< BaselineCheckpoint >& checkpoints = propagation.getCheckpoints( );
+    numpy::ndarray epochs = createArray( checkpoints.size( ) );
+    double* epochData = getArrayData( epochs );
+    for( std::size_t i = 0; i < checkpoints.size( ); i++ )
+    {
+        epochData[ i ] = checkpoints.at( i ).loopState.currentTime;
+    }
+    return epochs;
+}
+
+// As for the histories of a SingleArcDynamicsSimulator, the owner of the views is the history they reference.
+object getBaselineStateHistory( const IncrementalPropagation& propagation )
+{
+    const std::shared_ptr< const StateHistory > stateHistory = propagation.getBaselineStateHistory( );
+    return createArrayView( stateHistory->getStates( ).data( ), stateHistory->size( ), stateHistory->getStateSize( ),
+                            object( stateHistory ) );
+}
+
+object getBaselineStateHistoryEpochs( const IncrementalPropagation& propagation )
+{
+    const std::shared_ptr< const StateHistory > stateHistory = propagation.getBaselineStateHistory( );
+    return createVectorView( stateHistory->getEpochs( ).data( ), stateHistory->size( ), object( stateHistory ) );
+}
+
+object getBaselineDependentVariableHistory( const IncrementalPropagation& propagation )
+{
+    const std::shared_ptr< const StateHistory > dependentVariableHistory =
+            propagation.getBaselineDependentVariableHistory( );
+    return createArrayView( dependentVariableHistory->getStates( ).data( ), dependentVariableHistory->size( ),
+                            dependentVariableHistory->getStateSize( ), object( dependentVariableHistory ) );
+}
+
+} // namespace
+
+void exposeIncrementalPropagation( )
+{
+    class_< IncrementalPropagation, std::shared_ptr< IncrementalPropagation >, boost::noncopyable >(
+                "IncrementalPropagation", no_init )
+            .def( "__init__", make_constructor(
+                      &createIncrementalPropagation, default_call_policies( ),
+                      ( arg( "body_map" ), arg( "integrator_settings" ), arg( "propagator_settings" ),
+                        arg( "steps_per_checkpoint" ) = 100 ) ),
+                  "Propagate a baseline (with the GIL released unless SPICE is used), keeping its integrator state\n"
+                  "in memory every steps_per_checkpoint steps, so that variations of it are resumed from the last\n"
+                  "checkpoint before they diverge instead of from the initial epoch. The integrator must be Euler,\n"
+                  "RK4 or variable step Runge-Kutta. Histories are stored contiguously." )
+            .def( "propagate", &propagateVariation, ( arg( "propagator_settings" ), arg( "unchanged_until" ) ),
+                  "Propagate a variation of the baseline (with the GIL released unless SPICE is used), returning a\n"
+                  "tuple of its SingleArcDynamicsSimulator and the epoch from which it was resumed. The settings must\n"
+                  "have the initial epoch, initial states and dependent variables of the baseline (else RuntimeError\n"
+                  "is raised), and give the same accelerations and termination before unchanged_until (e.g. the\n"
+                  "epoch of an added maneuver, or of an earlier termination). The output before the resumed epoch is\n"
+                  "that of the baseline, and the rest is bit-for-bit that of a complete propagation of the variation.\n"
+                  "The bodies and integrator settings are those of the baseline; bodies modified for the variation\n"
+                  "must not change the environment before unchanged_until. Propagations from several threads are run\n"
+                  "one at a time." )
+            .add_property( "baseline_state_history", &getBaselineStateHistory,
+                           "Read-only state history of the baseline (one row per epoch)." )
+            .add_property( "baseline_state_history_epochs", &getBaselineStateHistoryEpochs,
+                           "Read-only epochs of the rows of baseline_state_history." )
+            .add_property( "baseline_dependent_variable_history", &getBaselineDependentVariableHistory,
+                           "Read-only dependent variable history of the baseline (one row per epoch)." )
+            .add_property( "checkpoint_epochs", &getCheckpointEpochs, "Epochs of the checkpoints of the baseline." )
+            ;
+}
+
+} // namespace tudatpy
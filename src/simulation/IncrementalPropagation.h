@@ -0,0 +1,285 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_INCREMENTAL_PROPAGATION_H
+#define TUDATPY_INCREMENTAL_PROPAGATION_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "DynamicsSimulator.h"
+#include "PropagationCheckpoint.h"
+
+namespace tudatpy
+{
+
+//! Loop state at an epoch of a baseline propagation.
+struct BaselineCheckpoint
+{
+    //! Number of output rows up to and including the epoch of the checkpoint.
+    std::size_t numberOfRows;
+
+    //! Loop state at the epoch.
+    PropagationLoopState loopState;
+};
+
+//! Checkpointer keeping the loop state of a propagation in memory, every number of integration steps.
+class BaselineCheckpointRecorder: public PropagationCheckpointer
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param stepsPerCheckpoint Number of integration steps between checkpoints.
+     */
+    explicit BaselineCheckpointRecorder( const std::size_t stepsPerCheckpoint );
+
+    //! A recorded propagation is always started from its initial states.
+    bool resume( const double /*initialTime*/, const Eigen::VectorXd& /*initialStates*/,
+                 const int /*integratorType*/, PropagationOutputSink& /*outputSink*/,
+                 PropagationLoopState& /*loopState*/ )
+    {
+        return false;
+    }
+
+    void start( const double initialTime, const Eigen::VectorXd& initialStates, const int integratorType,
+                const std::size_t dependentVariableSize );
+
+    void append( const double /*epoch*/, const Eigen::VectorXd& /*state*/,
+                 const Eigen::VectorXd& /*dependentVariables*/ )
+    {
+        numberOfRows_++;
+    }
+
+    bool isCheckpointDue( ) const
+    {
+        return numberOfRows_ - ( checkpoints_.empty( ) ? 1 : checkpoints_.back( ).numberOfRows ) >=
+                stepsPerCheckpoint_;
+    }
+
+    void writeCheckpoint( const PropagationLoopState& loopState );
+
+    //! Initial epoch of the recorded propagation.
+    double getInitialTime( ) const
+    {
+        return initialTime_;
+    }
+
+    //! Conventional initial states of the recorded propagation.
+    const Eigen::VectorXd& getInitialStates( ) const
+    {
+        return initialStates_;
+    }
+
+    //! Type of the numerical integrator of the recorded propagation.
+    int getIntegratorType( ) const
+    {
+        return integratorType_;
+    }
+
+    //! Size of the dependent variables computed during the recorded propagation (0 if none, or deferred).
+    std::size_t getDependentVariableSize( ) const
+    {
+        return dependentVariableSize_;
+    }
+
+    //! Recorded checkpoints, in the order of the propagation.
+    const std::vector< BaselineCheckpoint >& getCheckpoints( ) const
+    {
+        return checkpoints_;
+    }
+
+private:
+
+    //! Number of integration steps between checkpoints.
+    std::size_t stepsPerCheckpoint_;
+
+    //! Initial epoch of the recorded propagation.
+    double initialTime_;
+
+    //! Conventional initial states of the recorded propagation.
+    Eigen::VectorXd initialStates_;
+
+    //! Type of the numerical integrator of the recorded propagation.
+    int integratorType_;
+
+    //! Size of the dependent variables computed during the recorded propagation.
+    std::size_t dependentVariableSize_;
+
+    //! Number of output rows appended so far.
+    std::size_t numberOfRows_;
+
+    //! Recorded checkpoints.
+    std::vector< BaselineCheckpoint > checkpoints_;
+};
+
+//! Checkpointer resuming a propagation from the last checkpoint of a baseline propagation before a given epoch.
+/*!
+ *  The output of the baseline up to the checkpoint is passed to the output sink. No checkpoints are recorded.
+ */
+class BaselinePrefixResumer: public PropagationCheckpointer
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param recorder Checkpoints of the baseline propagation.
+     *  \param stateHistory State history of the baseline propagation.
+     *  \param dependentVariableHistory Dependent variable history of the baseline propagation.
+     *  \param unchangedUntil Epoch before which the propagation to resume equals the baseline propagation.
+     */
+    BaselinePrefixResumer( const BaselineCheckpointRecorder& recorder, const StateHistory& stateHistory,
+                           const StateHistory& dependentVariableHistory, const double unchangedUntil ):
+        recorder_( recorder ), stateHistory_( stateHistory ), dependentVariableHistory_( dependentVariableHistory ),
+        unchangedUntil_( unchangedUntil ), resumedCheckpoint_( nullptr )
+    { }
+
+    //! Resume from the last checkpoint strictly before (or, for a backward propagation, after) unchangedUntil.
+    /*!
+     *  \return Whether there is such a checkpoint.
+     *  \throws std::runtime_error If the initial epoch, initial states or integrator type differ from the baseline.
+     */
+    bool resume( const double initialTime, const Eigen::VectorXd& initialStates, const int integratorType,
+                 PropagationOutputSink& outputSink, PropagationLoopState& loopState );
+
+    void start( const double /*initialTime*/, const Eigen::VectorXd& /*initialStates*/,
+                const int /*integratorType*/, const std::size_t /*dependentVariableSize*/ ) { }
+
+    void append( const double /*epoch*/, const Eigen::VectorXd& /*state*/,
+                 const Eigen::VectorXd& /*dependentVariables*/ ) { }
+
+    bool isCheckpointDue( ) const
+    {
+        return false;
+    }
+
+    void writeCheckpoint( const PropagationLoopState& /*loopState*/ ) { }
+
+    //! Checkpoint from which the propagation was resumed (nullptr if it was started from the initial states).
+    const BaselineCheckpoint* getResumedCheckpoint( ) const
+    {
+        return resumedCheckpoint_;
+    }
+
+private:
+
+    //! Checkpoints of the baseline propagation.
+    const BaselineCheckpointRecorder& recorder_;
+
+    //! State history of the baseline propagation.
+    const StateHistory& stateHistory_;
+
+    //! Dependent variable history of the baseline propagation.
+    const StateHistory& dependentVariableHistory_;
+
+    //! Epoch before which the propagation to resume equals the baseline propagation.
+    double unchangedUntil_;
+
+    //! Checkpoint from which the propagation was resumed.
+    const BaselineCheckpoint* resumedCheckpoint_;
+};
+
+//! Baseline propagation with checkpoints, from which variations of it are propagated without repeating their prefix.
+/*!
+ *  The baseline is propagated with the loop of propagateToSink, recording its loop state every number of steps. A
+ *  variation of the baseline, with propagator settings that give the same dynamics (and termination) up to an epoch,
+ *  is resumed from the last checkpoint before that epoch, its output up to the checkpoint being copied from the
+ *  baseline. As for checkpoint files (see PropagationCheckpointer), the result is then bit-for-bit that of a
+ *  propagation of the variation from its initial states. The bodies and integrator settings are those of the baseline.
+ *  Propagations share the bodies, and are therefore run one at a time.
+ */
+class IncrementalPropagation
+{
+public:
+
+    //! Constructor, creating (but not propagating) the baseline.
+    /*!
+     *  \param bodyMap Bodies used in the propagations.
+     *  \param integratorSettings Settings of the numerical integrator, which must be a single-step integrator.
+     *  \param propagatorSettings Settings of the baseline propagation.
+     *  \param stepsPerCheckpoint Number of integration steps between checkpoints.
+     */
+    IncrementalPropagation(
+            const tudat::simulation_setup::NamedBodyMap& bodyMap,
+            const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+            const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings,
+            const std::size_t stepsPerCheckpoint );
+
+    //! Propagate the baseline, recording its checkpoints.
+    /*!
+     *  Does not touch any Python object, so that it may be called with the GIL released. Waits for propagations of
+     *  variations being run by other threads.
+     */
+    void propagateBaseline( );
+
+    //! Propagate a variation of the baseline.
+    /*!
+     *  Does not touch any Python object, so that it may be called with the GIL released. Waits for propagations being
+     *  run by other threads.
+     *  \param propagatorSettings Settings of the variation, with the same initial epoch and states, and the same
+     *  dependent variables, as the baseline.
+     *  \param unchangedUntil Epoch before which the settings give the same dynamics and termination as the baseline.
+     *  \param resumedEpoch Epoch from which the variation was resumed (its initial epoch if it was not).
+     *  \return Simulation holding the history of the variation (stored contiguously).
+     *  \throws std::runtime_error If the dependent variables of the variation differ from those of the baseline.
+     */
+    std::shared_ptr< SingleArcSimulation > propagate(
+            const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings,
+            const double unchangedUntil, double& resumedEpoch ) const;
+
+    //! Bodies used in the propagations.
+    const tudat::simulation_setup::NamedBodyMap& getBodyMap( ) const
+    {
+        return bodyMap_;
+    }
+
+    //! State history of the baseline.
+    std::shared_ptr< const StateHistory > getBaselineStateHistory( ) const
+    {
+        std::lock_guard< std::mutex > lock( propagationMutex_ );
+        return baseline_->getStateHistory( );
+    }
+
+    //! Dependent variable history of the baseline.
+    std::shared_ptr< const StateHistory > getBaselineDependentVariableHistory( ) const
+    {
+        std::lock_guard< std::mutex > lock( propagationMutex_ );
+        return baseline_->getDependentVariableHistory( );
+    }
+
+    //! Checkpoints of the baseline.
+    const std::vector< BaselineCheckpoint >& getCheckpoints( ) const
+    {
+        return recorder_.getCheckpoints( );
+    }
+
+private:
+
+    //! Bodies used in the propagations.
+    tudat::simulation_setup::NamedBodyMap bodyMap_;
+
+    //! Settings of the numerical integrator.
+    std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings_;
+
+    //! Simulation of the baseline.
+    std::shared_ptr< SingleArcSimulation > baseline_;
+
+    //! Checkpoints of the baseline.
+    BaselineCheckpointRecorder recorder_;
+
+    //! Mutex held during the propagations, which share the bodies and the baseline.
+    mutable std::mutex propagationMutex_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_INCREMENTAL_PROPAGATION_H
@@ -0,0 +1,388 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/SimulationSetup/EnvironmentSetup/createAerodynamicCoefficientInterface.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createRadiationPressureInterface.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createAccelerationModels.h"
+
+#include "Conversions.h"
+#include "MonteCarlo.h"
+#include "Parallel.h"
+#include "PropagationSetup.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+std::shared_ptr< ConstantAerodynamicCoefficientSettings > getConstantAerodynamicCoefficientSettings(
+        const BodySettings& bodySettings, const std::string& bodyName )
+{
+    std::shared_ptr< ConstantAerodynamicCoefficientSettings > aerodynamicCoefficientSettings =
+            std::dynamic_pointer_cast< ConstantAerodynamicCoefficientSettings >(
+                bodySettings.aerodynamicCoefficientSettings );
+    if( aerodynamicCoefficientSettings == nullptr )
+    {
+        throw std::runtime_error( "Error when perturbing drag coefficient of " + bodyName +
+                                  ", body has no constant aerodynamic coefficients" );
+    }
+    return aerodynamicCoefficientSettings;
+}
+
+std::shared_ptr< CannonBallRadiationPressureInterfaceSettings > getCannonBallRadiationPressureSettings(
+        const std::shared_ptr< RadiationPressureInterfaceSettings > radiationPressureSettings,
+        const std::string& bodyName )
+{
+    std::shared_ptr< CannonBallRadiationPressureInterfaceSettings > cannonBallSettings =
+            std::dynamic_pointer_cast< CannonBallRadiationPressureInterfaceSettings >( radiationPressureSettings );
+    if( cannonBallSettings == nullptr )
+    {
+        throw std::runtime_error( "Error when perturbing radiation pressure area of " + bodyName +
+                                  ", body has radiation pressure settings other than cannon-ball" );
+    }
+    return cannonBallSettings;
+}
+
+double getNominalValue( const BodySettings& bodySettings, const std::string& bodyName,
+                        const MonteCarloParameter parameter )
+{
+    switch( parameter )
+    {
+    case constant_mass:
+        if( std::isnan( bodySettings.constantMass ) )
+        {
+            throw std::runtime_error( "Error when perturbing mass of " + bodyName + ", body has no constant mass" );
+        }
+        return bodySettings.constantMass;
+    case drag_coefficient:
+        return getConstantAerodynamicCoefficientSettings( bodySettings, bodyName )->getConstantForceCoefficient( )( 0 );
+    case radiation_pressure_area:
+        if( bodySettings.radiationPressureSettings.empty( ) )
+        {
+            throw std::runtime_error( "Error when perturbing radiation pressure area of " + bodyName +
+                                      ", body has no radiation pressure settings" );
+        }
+        return getCannonBallRadiationPressureSettings(
+                    bodySettings.radiationPressureSettings.begin( )->second, bodyName )->getArea( );
+    }
+    throw std::runtime_error( "Error when perturbing parameter of " + bodyName + ", parameter is not supported" );
+}
+
+//! Apply a sampled parameter value to a body, re-creating the environment models that depend on it.
+void applyPerturbation( const MonteCarloPerturbation& perturbation, const double value,
+                        const BodySettings& bodySettings, const NamedBodyMap& bodyMap )
+{
+    const std::shared_ptr< Body > body = bodyMap.at( perturbation.bodyName );
+    switch( perturbation.parameter )
+    {
+    case constant_mass:
+    {
+        body->setConstantBodyMass( value );
+        break;
+    }
+    case drag_coefficient:
+    {
+        const std::shared_ptr< ConstantAerodynamicCoefficientSettings > nominalSettings =
+                getConstantAerodynamicCoefficientSettings( bodySettings, perturbation.bodyName );
+        Eigen::Vector3d forceCoefficients = nominalSettings->getConstantForceCoefficient( );
+        forceCoefficients( 0 ) = value;
+        body->setAerodynamicCoefficientInterface(
+                    createAerodynamicCoefficientInterface(
+                        std::make_shared< ConstantAerodynamicCoefficientSettings >(
+                            nominalSettings->getReferenceLength( ), nominalSettings->getReferenceArea( ),
+                            nominalSettings->getReferenceLateralLength( ),
+                            nominalSettings->getMomentReferencePoint( ), forceCoefficients,
+                            nominalSettings->getConstantMomentCoefficient( ),
+                            nominalSettings->getAreCoefficientsInAerodynamicFrame( ),
+                            nominalSettings->getAreCoefficientsInNegativeAxisDirection( ) ),
+                        perturbation.bodyName ) );
+        break;
+    }
+    case radiation_pressure_area:
+    {
+        for( auto settingsIterator = bodySettings.radiationPressureSettings.begin( );
+             settingsIterator != bodySettings.radiationPressureSettings.end( ); settingsIterator++ )
+        {
+            const std::shared_ptr< CannonBallRadiationPressureInterfaceSettings > nominalSettings =
+                    getCannonBallRadiationPressureSettings( settingsIterator->second, perturbation.bodyName );
+            body->setRadiationPressureInterface(
+                        settingsIterator->first, createRadiationPressureInterface(
+                            std::make_shared< CannonBallRadiationPressureInterfaceSettings >(
+                                nominalSettings->getSourceBody( ), value,
+                                nominalSettings->getRadiationPressureCoefficient( ),
+                                nominalSettings->getOccultingBodies( ) ),
+                            perturbation.bodyName, bodyMap ) );
+        }
+        break;
+    }
+    }
+}
+
+//! Draw the parameter values of a sample, from a generator seeded with the seed of the run and the sample index.
+void drawParameterValues( const std::vector< MonteCarloPerturbation >& perturbations, const std::uint64_t seed,
+                          const std::size_t sampleIndex, double* parameterValues )
+{
+    std::seed_seq seedSequence{ static_cast< std::uint32_t >( seed ), static_cast< std::uint32_t >( seed >> 32 ),
+                                static_cast< std::uint32_t >( sampleIndex ),
+                                static_cast< std::uint32_t >( static_cast< std::uint64_t >( sampleIndex ) >> 32 ) };
+    std::mt19937_64 generator( seedSequence );
+    for( unsigned int i = 0; i < perturbations.size( ); i++ )
+    {
+        const MonteCarloPerturbation& perturbation = perturbations.at( i );
+        if( perturbation.spread == 0.0 )
+        {
+            parameterValues[ i ] = perturbation.nominalValue;
+        }
+        else if( perturbation.distribution == gaussian_distribution )
+        {
+            parameterValues[ i ] = std::normal_distribution< double >(
+                        perturbation.nominalValue, perturbation.spread )( generator );
+        }
+        else
+        {
+            parameterValues[ i ] = std::uniform_real_distribution< double >(
+                        perturbation.nominalValue - perturbation.spread,
+                        perturbation.nominalValue + perturbation.spread )( generator );
+        }
+    }
+}
+
+} // namespace
+
+MonteCarloRunner::MonteCarloRunner( const BatchPropagationSettings& settings ):
+    settings_( settings )
+{ }
+
+void MonteCarloRunner::addPerturbation( const std::string& bodyName, const MonteCarloParameter parameter,
+                                        const double spread, const MonteCarloDistribution distribution )
+{
+    const std::map< std::string, std::shared_ptr< BodySettings > >& bodySettings =
+            settings_.bodies->getBodySettings( );
+    if( bodySettings.count( bodyName ) == 0 )
+    {
+        throw std::runtime_error( "Error when adding Monte Carlo perturbation, no settings for body " + bodyName );
+    }
+    if( !( spread >= 0.0 ) )
+    {
+        throw std::runtime_error( "Error when adding Monte Carlo perturbation, spread must be non-negative" );
+    }
+
+    MonteCarloPerturbation perturbation;
+    perturbation.bodyName = bodyName;
+    perturbation.parameter = parameter;
+    perturbation.distribution = distribution;
+    perturbation.spread = spread;
+    perturbation.nominalValue = getNominalValue( *bodySettings.at( bodyName ), bodyName, parameter );
+    perturbations_.push_back( perturbation );
+}
+
+MonteCarloResults MonteCarloRunner::run( const double* initialStates, const std::size_t numberOfInitialStates,
+                                         const std::size_t stateSize, const std::size_t numberOfSamples,
+                                         const std::uint64_t seed, const unsigned int numberOfThreads ) const
+{
+    if( numberOfInitialStates != 1 && numberOfInitialStates != numberOfSamples )
+    {
+        throw std::runtime_error( "Error when running Monte Carlo analysis, number of initial states must be 1 or "
+                                  "equal to the number of samples" );
+    }
+
+    MonteCarloResults results;
+    results.stateSize = stateSize;
+    results.numberOfParameters = perturbations_.size( );
+    results.finalEpochs.resize( numberOfSamples );
+    results.finalStates.resize( numberOfSamples * stateSize );
+    results.parameterValues.resize( numberOfSamples * perturbations_.size( ) );
+
+    const std::map< std::string, std::shared_ptr< BodySettings > >& bodySettings =
+            settings_.bodies->getBodySettings( );
+    const unsigned int numberOfWorkers = getNumberOfThreads( numberOfThreads, numberOfSamples );
+    std::vector< NamedBodyMap > bodyMaps( numberOfWorkers );
+
+    // Every thread uses its own copies of the settings, which Tudat simulators may modify.
+    std::vector< std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > > integratorSettings;
+    std::vector< std::shared_ptr< PropagationTerminationSettings > > terminationSettings;
+    for( unsigned int i = 0; i < numberOfWorkers; i++ )
+    {
+        integratorSettings.push_back( copyIntegratorSettings( settings_.integratorSettings ) );
+        terminationSettings.push_back( copyTerminationSettings( settings_.terminationSettings ) );
+    }
+
+    parallelFor( numberOfSamples, numberOfThreads,
+                 [ & ]( const std::size_t sampleIndex, const unsigned int threadIndex )
+    {
+        NamedBodyMap& bodyMap = bodyMaps.at( threadIndex );
+        if( bodyMap.empty( ) )
+        {
+            bodyMap = settings_.bodies->createBodyMap( );
+        }
+
+        double* parameterValues = results.parameterValues.data( ) + sampleIndex * perturbations_.size( );
+        drawParameterValues( perturbations_, seed, sampleIndex, parameterValues );
+        for( unsigned int i = 0; i < perturbations_.size( ); i++ )
+        {
+            applyPerturbation( perturbations_.at( i ), parameterValues[ i ],
+                               *bodySettings.at( perturbations_.at( i ).bodyName ), bodyMap );
+        }
+
+        // Acceleration models bind the environment models of the bodies, so they are re-created for every sample.
+        const std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                    settings_.centralBodies, createAccelerationModelsMap(
+                        bodyMap, settings_.selectedAccelerations, settings_.bodiesToPropagate,
+                        settings_.centralBodies ),
+                    settings_.bodiesToPropagate,
+                    Eigen::Map< const Eigen::VectorXd >(
+                        initialStates + ( numberOfInitialStates == 1 ? 0 : sampleIndex ) * stateSize, stateSize ),
+                    terminationSettings.at( threadIndex ) );
+
+        SingleArcDynamicsSimulator< double, double > simulator(
+                    bodyMap, integratorSettings.at( threadIndex ), propagatorSettings );
+        const std::map< double, Eigen::VectorXd >& stateHistory = simulator.getEquationsOfMotionNumericalSolution( );
+        results.finalEpochs.at( sampleIndex ) = stateHistory.rbegin( )->first;
+        Eigen::Map< Eigen::VectorXd >( results.finalStates.data( ) + sampleIndex * stateSize, stateSize ) =
+                stateHistory.rbegin( )->second;
+    } );
+
+    return results;
+}
+
+namespace
+{
+
+std::shared_ptr< MonteCarloRunner > createMonteCarloRunner(
+        const dict& bodySettings, const dict& selectedAccelerations, const list& bodiesToPropagate,
+        const list& centralBodies, const std::shared_ptr< PropagationTerminationSettings > terminationSettings,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::string& globalFrameOrigin, const std::string& globalFrameOrientation,
+        const object& ephemerisCache )
+{
+    BatchPropagationSettings settings;
+    settings.bodies = std::make_shared< FrozenBodyMap >(
+                extractMap< std::shared_ptr< BodySettings > >( bodySettings ), globalFrameOrigin,
+                globalFrameOrientation, ephemerisCache.is_none( ) ? std::shared_ptr< EphemerisCache >( ) :
+                                                                    extract< std::shared_ptr< EphemerisCache > >(
+                                                                        ephemerisCache )( ) );
+    settings.selectedAccelerations = extractSelectedAccelerationMap( selectedAccelerations );
+    settings.bodiesToPropagate = extractList< std::string >( bodiesToPropagate );
+    settings.centralBodies = extractList< std::string >( centralBodies );
+    settings.terminationSettings = terminationSettings;
+    settings.integratorSettings = integratorSettings;
+    return std::make_shared< MonteCarloRunner >( settings );
+}
+
+std::shared_ptr< MonteCarloResults > runMonteCarlo(
+        const MonteCarloRunner& runner, const object& initialStates, const std::size_t numberOfSamples,
+        const std::uint64_t seed, const unsigned int numberOfThreads )
+{
+    const ContiguousArray initialStatesArray( initialStates, 2 );
+    const bool isSingleState = initialStatesArray.columns( ) == 1;
+
+    // Bodies whose models may call SPICE are propagated one at a time on this thread, with the GIL held.
+    const bool isSpiceUsed = usesSpice( runner.getSettings( ).bodies->getPrototypeBodyMap( ) );
+    std::shared_ptr< MonteCarloResults > results = std::make_shared< MonteCarloResults >( );
+    {
+        ScopedGilRelease gilRelease( !isSpiceUsed );
+        *results = runner.run( initialStatesArray.data( ), isSingleState ? 1 : initialStatesArray.rows( ),
+                               isSingleState ? initialStatesArray.rows( ) : initialStatesArray.columns( ),
+                               numberOfSamples, seed, isSpiceUsed ? 1 : numberOfThreads );
+    }
+    return results;
+}
+
+object getFinalEpochs( const object& self )
+{
+    const MonteCarloResults& results = extract< const MonteCarloResults& >( self )( );
+    return createVectorView( results.finalEpochs.data( ), results.finalEpochs.size( ), self );
+}
+
+object getFinalStates( const object& self )
+{
+    const MonteCarloResults& results = extract< const MonteCarloResults& >( self )( );
+    return createArrayView( results.finalStates.data( ), results.finalEpochs.size( ), results.stateSize, self );
+}
+
+object getParameterValues( const object& self )
+{
+    const MonteCarloResults& results = extract< const MonteCarloResults& >( self )( );
+    return createArrayView( results.parameterValues.data( ), results.finalEpochs.size( ),
+                            results.numberOfParameters, self );
+}
+
+std::size_t getNumberOfSamples( const MonteCarloResults& results )
+{
+    return results.finalEpochs.size( );
+}
+
+} // namespace
+
+void exposeMonteCarlo( )
+{
+    enum_< MonteCarloParameter >( "MonteCarloParameter" )
+            .value( "constant_mass", constant_mass )
+            .value( "drag_coefficient", drag_coefficient )
+            .value( "radiation_pressure_area", radiation_pressure_area )
+            ;
+
+    enum_< MonteCarloDistribution >( "MonteCarloDistribution" )
+            .value( "gaussian", gaussian_distribution )
+            .value( "uniform", uniform_distribution )
+            ;
+
+    class_< MonteCarloResults, std::shared_ptr< MonteCarloResults >, boost::noncopyable >(
+                "MonteCarloResults", no_init )
+            .add_property( "final_epochs", &getFinalEpochs, "Final epoch of each sample." )
+            .add_property( "final_states", &getFinalStates,
+                           "Final states as a read-only (samples x state size) array." )
+            .add_property( "parameter_values", &getParameterValues,
+                           "Sampled values as a read-only (samples x perturbations) array, with the columns in the\n"
+                           "order in which the perturbations were added." )
+            .def( "__len__", &getNumberOfSamples )
+            ;
+
+    class_< MonteCarloRunner, std::shared_ptr< MonteCarloRunner >, boost::noncopyable >(
+                "MonteCarloRunner",
+                "Monte Carlo analysis of a propagation, perturbing body parameters per sample.\n\n"
+                "The environment is created once from body_settings; all samples run on native threads with the GIL\n"
+                "released. Parallel runs require ephemerides and rotation models that do not call SPICE during the\n"
+                "propagation (pass an ephemeris_cache, or use tabulated models); otherwise the samples are run one\n"
+                "at a time, with the GIL held.",
+                no_init )
+            .def( "__init__", make_constructor(
+                      &createMonteCarloRunner, default_call_policies( ),
+                      ( arg( "body_settings" ), arg( "selected_acceleration_per_body" ), arg( "bodies_to_propagate" ),
+                        arg( "central_bodies" ), arg( "termination_settings" ), arg( "integrator_settings" ),
+                        arg( "global_frame_origin" ) = "SSB", arg( "global_frame_orientation" ) = "ECLIPJ2000",
+                        arg( "ephemeris_cache" ) = object( ) ) ) )
+            .def( "add_perturbation", &MonteCarloRunner::addPerturbation,
+                  ( arg( "body_name" ), arg( "parameter" ), arg( "spread" ),
+                    arg( "distribution" ) = gaussian_distribution ),
+                  "Perturb a parameter around its nominal value in the body settings; spread is the standard\n"
+                  "deviation (gaussian) or half-width (uniform) of the perturbation." )
+            .def( "run", &runMonteCarlo,
+                  ( arg( "initial_states" ), arg( "number_of_samples" ), arg( "seed" ) = 0,
+                    arg( "number_of_threads" ) = 0 ),
+                  "Propagate number_of_samples perturbed samples, from a single initial state or from one initial\n"
+                  "state per sample. Results do not depend on the number of threads." )
+            ;
+}
+
+} // namespace tudatpy
@@ -0,0 +1,146 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_MONTE_CARLO_H
+#define TUDATPY_MONTE_CARLO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BatchPropagation.h"
+
+namespace tudatpy
+{
+
+//! Body parameters that can be perturbed per Monte Carlo sample.
+enum MonteCarloParameter
+{
+    constant_mass,
+    drag_coefficient,
+    radiation_pressure_area
+};
+
+//! Distributions from which perturbations of Monte Carlo parameters are drawn.
+enum MonteCarloDistribution
+{
+    gaussian_distribution,
+    uniform_distribution
+};
+
+//! Perturbation of a single body parameter.
+struct MonteCarloPerturbation
+{
+    //! Name of the body of which the parameter is perturbed.
+    std::string bodyName;
+
+    //! Perturbed parameter.
+    MonteCarloParameter parameter;
+
+    //! Distribution of the perturbation.
+    MonteCarloDistribution distribution;
+
+    //! Standard deviation (Gaussian) or half-width (uniform) of the distribution, centered on the nominal value.
+    double spread;
+
+    //! Nominal value, taken from the body settings.
+    double nominalValue;
+};
+
+//! Results of a Monte Carlo run, stored in blocks that are allocated before the run and filled per sample.
+struct MonteCarloResults
+{
+    //! Final epoch of each sample.
+    std::vector< double > finalEpochs;
+
+    //! Row-major (number of samples x state size) block of final states.
+    std::vector< double > finalStates;
+
+    //! Row-major (number of samples x number of perturbations) block of sampled parameter values.
+    std::vector< double > parameterValues;
+
+    //! Size of a single state vector.
+    std::size_t stateSize;
+
+    //! Number of perturbed parameters.
+    std::size_t numberOfParameters;
+};
+
+//! Monte Carlo analysis of a propagation, perturbing body parameters per sample.
+/*!
+ *  The environment is created once from the nominal body settings (as a FrozenBodyMap). For each sample, every worker
+ *  thread applies the sampled parameter values to its own bodies: the constant mass is set directly, and the
+ *  aerodynamic coefficient and radiation pressure interfaces are re-created from perturbed copies of their settings,
+ *  after which the acceleration models are re-created. The shared environment models are never modified, and every
+ *  thread propagates with its own copies of the integrator and termination settings.
+ *
+ *  Samples are drawn from a random generator seeded with the seed of the run and the index of the sample, so that
+ *  results do not depend on the number of threads.
+ */
+class MonteCarloRunner
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param settings Settings of the nominal propagation.
+     */
+    explicit MonteCarloRunner( const BatchPropagationSettings& settings );
+
+    //! Add a perturbed parameter.
+    /*!
+     *  The body settings must define the nominal value: a constant mass, constant aerodynamic coefficients (of which
+     *  the first force coefficient is the drag coefficient), or cannon-ball radiation pressure settings.
+     *  \param bodyName Name of the body of which the parameter is perturbed.
+     *  \param parameter Perturbed parameter.
+     *  \param spread Standard deviation (Gaussian) or half-width (uniform) of the perturbation.
+     *  \param distribution Distribution of the perturbation.
+     */
+    void addPerturbation( const std::string& bodyName, const MonteCarloParameter parameter, const double spread,
+                          const MonteCarloDistribution distribution = gaussian_distribution );
+
+    //! Settings of the nominal propagation.
+    const BatchPropagationSettings& getSettings( ) const
+    {
+        return settings_;
+    }
+
+    //! Perturbed parameters, in the order of the columns of the sampled parameter values.
+    const std::vector< MonteCarloPerturbation >& getPerturbations( ) const
+    {
+        return perturbations_;
+    }
+
+    //! Propagate a number of samples in parallel.
+    /*!
+     *  \param initialStates Row-major block of initial states: a single state used by all samples, or one per sample.
+     *  \param numberOfInitialStates Number of initial states (1 or numberOfSamples).
+     *  \param stateSize Size of a single initial state.
+     *  \param numberOfSamples Number of samples.
+     *  \param seed Seed of the random generator.
+     *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+     *  \return Final states and sampled parameter values of all samples.
+     */
+    MonteCarloResults run( const double* initialStates, const std::size_t numberOfInitialStates,
+                           const std::size_t stateSize, const std::size_t numberOfSamples,
+                           const std::uint64_t seed, const unsigned int numberOfThreads ) const;
+
+private:
+
+    //! Settings of the nominal propagation.
+    BatchPropagationSettings settings_;
+
+    //! Perturbed parameters.
+    std::vector< MonteCarloPerturbation > perturbations_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_MONTE_CARLO_H
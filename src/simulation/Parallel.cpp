@@ -0,0 +1,142 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <utility>
+
+#include "Parallel.h"
+
+namespace tudatpy
+{
+
+unsigned int getNumberOfThreads( const unsigned int requestedNumberOfThreads, const std::size_t numberOfTasks )
+{
+    unsigned int numberOfThreads = requestedNumberOfThreads;
+    if( numberOfThreads == 0 )
+    {
+        numberOfThreads = std::max( std::thread::hardware_concurrency( ), 1u );
+    }
+    return static_cast< unsigned int >(
+                std::max< std::size_t >( std::min< std::size_t >( numberOfThreads, numberOfTasks ), 1 ) );
+}
+
+void parallelFor( const std::size_t numberOfTasks, const unsigned int numberOfThreads,
+                  const std::function< void( const std::size_t, const unsigned int ) >& task )
+{
+    const unsigned int numberOfWorkers = getNumberOfThreads( numberOfThreads, numberOfTasks );
+
+    std::atomic< std::size_t > nextTask( 0 );
+    std::atomic< bool > isFailed( false );
+    std::exception_ptr firstException;
+    std::mutex exceptionMutex;
+
+    auto worker = [ & ]( const unsigned int threadIndex )
+    {
+        std::size_t taskIndex;
+        while( !isFailed && ( taskIndex = nextTask++ ) < numberOfTasks )
+        {
+            try
+            {
+                task( taskIndex, threadIndex );
+            }
+            catch( ... )
+            {
+                std::lock_guard< std::mutex > lock( exceptionMutex );
+                if( !isFailed )
+                {
+                    firstException = std::current_exception( );
+                    isFailed = true;
+                }
+            }
+        }
+    };
+
+    // The calling thread acts as the first worker.
+    std::vector< std::thread > threads;
+    for( unsigned int i = 1; i < numberOfWorkers; i++ )
+    {
+        threads.push_back( std::thread( worker, i ) );
+    }
+    worker( 0 );
+    for( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads.at( i ).join( );
+    }
+
+    if( firstException )
+    {
+        std::rethrow_exception( firstException );
+    }
+}
+
+WorkerPool::WorkerPool( const unsigned int numberOfThreads ):
+    numberOfRunningTasks_( 0 ), isStopping_( false )
+{
+    const unsigned int numberOfWorkers =
+            numberOfThreads == 0 ? std::max( std::thread::hardware_concurrency( ), 1u ) : numberOfThreads;
+    for( unsigned int i = 0; i < numberOfWorkers; i++ )
+    {
+        threads_.push_back( std::thread( &WorkerPool::work, this ) );
+    }
+}
+
+WorkerPool::~WorkerPool( )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        isStopping_ = true;
+    }
+    taskAvailable_.notify_all( );
+    for( unsigned int i = 0; i < threads_.size( ); i++ )
+    {
+        threads_.at( i ).join( );
+    }
+}
+
+void WorkerPool::submit( const std::function< void( ) >& task )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        tasks_.push_back( task );
+    }
+    taskAvailable_.notify_one( );
+}
+
+void WorkerPool::waitUntilIdle( )
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    taskFinished_.wait( lock, [ this ]( ) { return tasks_.empty( ) && numberOfRunningTasks_ == 0; } );
+}
+
+void WorkerPool::work( )
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    while( true )
+    {
+        taskAvailable_.wait( lock, [ this ]( ) { return isStopping_ || !tasks_.empty( ); } );
+        if( tasks_.empty( ) )
+        {
+            return;
+        }
+
+        const std::function< void( ) > task = std::move( tasks_.front( ) );
+        tasks_.pop_front( );
+        numberOfRunningTasks_++;
+        lock.unlock( );
+        task( );
+        lock.lock( );
+        numberOfRunningTasks_--;
+        taskFinished_.notify_all( );
+    }
+}
+
+} // namespace tudatpy
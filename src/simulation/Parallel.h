@@ -0,0 +1,168 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PARALLEL_H
+#define TUDATPY_PARALLEL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Python.h>
+
+namespace tudatpy
+{
+
+//! Releases the Python GIL for the lifetime of the object.
+/*!
+ *  No Python objects (including boost::python::object and NumPy arrays) may be touched while an object of this type
+ *  is alive.
+ */
+class ScopedGilRelease
+{
+public:
+
+    //! Constructor, releasing the GIL.
+    /*!
+     *  \param isReleased Whether the GIL is released; if not, the object does nothing. Used to keep the GIL while
+     *  evaluating models that may call SPICE, which is not thread-safe (see usesSpice), or that store the state of
+     *  their last evaluation.
+     */
+    explicit ScopedGilRelease( const bool isReleased = true ):
+        threadState_( isReleased ? PyEval_SaveThread( ) : nullptr )
+    { }
+
+    //! Destructor, re-acquiring the GIL (if it was released).
+    ~ScopedGilRelease( )
+    {
+        if( threadState_ != nullptr )
+        {
+            PyEval_RestoreThread( threadState_ );
+        }
+    }
+
+private:
+
+    ScopedGilRelease( const ScopedGilRelease& );
+
+    ScopedGilRelease& operator=( const ScopedGilRelease& );
+
+    //! State of the thread that released the GIL (nullptr if it was not released).
+    PyThreadState* threadState_;
+};
+
+//! Acquires the Python GIL for the lifetime of the object, from a thread that may not be known to Python.
+class ScopedGilAcquire
+{
+public:
+
+    //! Constructor, acquiring the GIL.
+    ScopedGilAcquire( ): gilState_( PyGILState_Ensure( ) ) { }
+
+    //! Destructor, releasing the GIL.
+    ~ScopedGilAcquire( )
+    {
+        PyGILState_Release( gilState_ );
+    }
+
+private:
+
+    ScopedGilAcquire( const ScopedGilAcquire& );
+
+    ScopedGilAcquire& operator=( const ScopedGilAcquire& );
+
+    //! State of the GIL before it was acquired.
+    PyGILState_STATE gilState_;
+};
+
+//! Number of worker threads to use for a requested number (0 selects the number of hardware threads).
+unsigned int getNumberOfThreads( const unsigned int requestedNumberOfThreads, const std::size_t numberOfTasks );
+
+//! Execute a number of independent tasks on a set of worker threads.
+/*!
+ *  Tasks are handed out dynamically, so that threads finishing early pick up remaining work. The function returns
+ *  once all tasks have been executed. If any task throws, the remaining tasks are skipped and the first exception is
+ *  rethrown in the calling thread.
+ *  \param numberOfTasks Number of tasks to execute.
+ *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+ *  \param task Function executing a task, called as task( taskIndex, threadIndex ); the thread index is in
+ *  [0, numberOfThreads ) and can be used to index per-thread data.
+ */
+void parallelFor( const std::size_t numberOfTasks, const unsigned int numberOfThreads,
+                  const std::function< void( const std::size_t, const unsigned int ) >& task );
+
+//! Persistent set of worker threads executing queued tasks, for work that outlives the call that submits it.
+/*!
+ *  Unlike parallelFor, submitting a task returns immediately. Tasks are executed in order of submission, by whichever
+ *  thread is free first. Tasks must handle their own exceptions; an exception escaping a task terminates the process.
+ */
+class WorkerPool
+{
+public:
+
+    //! Constructor, starting the worker threads.
+    /*!
+     *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+     */
+    explicit WorkerPool( const unsigned int numberOfThreads );
+
+    //! Destructor, executing the tasks still queued and joining the worker threads.
+    ~WorkerPool( );
+
+    //! Queue a task for execution.
+    void submit( const std::function< void( ) >& task );
+
+    //! Block until the queue is empty and no task is running.
+    void waitUntilIdle( );
+
+    //! Number of worker threads.
+    unsigned int getNumberOfThreads( ) const
+    {
+        return static_cast< unsigned int >( threads_.size( ) );
+    }
+
+private:
+
+    WorkerPool( const WorkerPool& );
+
+    WorkerPool& operator=( const WorkerPool& );
+
+    //! Loop run by each worker thread.
+    void work( );
+
+    //! Worker threads.
+    std::vector< std::thread > threads_;
+
+    //! Tasks not yet started.
+    std::deque< std::function< void( ) > > tasks_;
+
+    //! Mutex guarding tasks_, numberOfRunningTasks_ and isStopping_.
+    std::mutex mutex_;
+
+    //! Signalled when a task is queued, or the pool is stopping.
+    std::condition_variable taskAvailable_;
+
+    //! Signalled when a task finishes.
+    std::condition_variable taskFinished_;
+
+    //! Number of tasks being executed.
+    std::size_t numberOfRunningTasks_;
+
+    //! Whether the worker threads are to exit once the queue is empty.
+    bool isStopping_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_PARALLEL_H
@@ -0,0 +1,299 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include "FileUtilities.h"
+#include "PropagationCheckpoint.h"
+#include "PropagationSetup.h"
+#include "SettingsSerialization.h"
+
+using namespace tudat::numerical_integrators;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Identifier at the start of every checkpoint file (including the format version).
+const char checkpointFileIdentifier[ 8 ] = { 'T', 'P', 'Y', 'C', 'K', 'P', '0', '2' };
+
+//! Identifier at the start and end of every checkpoint block.
+const char checkpointBlockIdentifier[ 8 ] = { 'T', 'P', 'Y', 'C', 'K', 'B', '0', '1' };
+
+//! Header of a checkpoint file, followed by the conventional initial states.
+struct CheckpointFileHeader
+{
+    char identifier[ 8 ];
+    std::uint64_t stateSize;
+    std::uint64_t dependentVariableSize;
+    std::int64_t integratorType;
+    double initialTime;
+    std::uint64_t settingsHash;
+};
+
+//! Header of a checkpoint block, followed by the output rows, the propagated state and the block identifier.
+struct CheckpointBlockHeader
+{
+    char identifier[ 8 ];
+    std::uint64_t numberOfRows;
+    std::uint64_t stateRows;
+    std::uint64_t stateColumns;
+    double currentTime;
+    double timeStep;
+};
+
+//! 64-bit FNV-1a hash of a string.
+std::uint64_t getHash( const std::string& data )
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for( std::size_t i = 0; i < data.size( ); i++ )
+    {
+        hash = ( hash ^ static_cast< unsigned char >( data[ i ] ) ) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+//! Read a block of values from a file, returning whether it was read completely.
+bool readValues( std::ifstream& file, void* values, const std::size_t size )
+{
+    file.read( reinterpret_cast< char* >( values ), static_cast< std::streamsize >( size ) );
+    return static_cast< bool >( file );
+}
+
+//! Replace a file by its first size bytes (written to a temporary file that then replaces it).
+void truncateFile( const std::string& filePath, const std::size_t size )
+{
+    const std::string temporaryFilePath = getTemporaryFilePath( filePath );
+    try
+    {
+        {
+            std::ifstream input( filePath.c_str( ), std::ios::binary );
+            std::ofstream output( temporaryFilePath.c_str( ), std::ios::binary | std::ios::trunc );
+            std::vector< char > buffer( 1 << 20 );
+            std::size_t remainingSize = size;
+            while( remainingSize > 0 && input )
+            {
+                const std::size_t blockSize = std::min( remainingSize, buffer.size( ) );
+                input.read( buffer.data( ), static_cast< std::streamsize >( blockSize ) );
+                output.write( buffer.data( ), input.gcount( ) );
+                remainingSize -= static_cast< std::size_t >( input.gcount( ) );
+            }
+            output.close( );
+            if( remainingSize > 0 || !output )
+            {
+                throw std::runtime_error( "Error when resuming propagation, could not truncate checkpoint file " +
+                                          filePath );
+            }
+        }
+        synchronizeFile( temporaryFilePath );
+    }
+    catch( ... )
+    {
+        std::remove( temporaryFilePath.c_str( ) );
+        throw;
+    }
+    replaceFile( temporaryFilePath, filePath );
+}
+
+} // namespace
+
+PropagationCheckpointFile::PropagationCheckpointFile(
+        const std::string& filePath, const double checkpointInterval,
+        const std::shared_ptr< IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings ):
+    filePath_( filePath ), checkpointInterval_( checkpointInterval ),
+    settingsHash_( getHash( serializePropagationSettings( integratorSettings, propagatorSettings ) ) ),
+    numberOfColumns_( 0 ), lastCheckpointTime_( std::chrono::steady_clock::now( ) )
+{
+    if( !( checkpointInterval_ >= 0.0 ) )
+    {
+        throw std::runtime_error( "Error when creating propagation checkpoints, interval must be non-negative" );
+    }
+}
+
+bool PropagationCheckpointFile::resume( const double initialTime, const Eigen::VectorXd& initialStates,
+                                        const int integratorType, PropagationOutputSink& outputSink,
+                                        PropagationLoopState& loopState )
+{
+    std::ifstream file( filePath_.c_str( ), std::ios::binary );
+    CheckpointFileHeader header;
+    std::vector< double > fileInitialStates( initialStates.rows( ) );
+    if( !file || !readValues( file, &header, sizeof( header ) ) ||
+            std::memcmp( header.identifier, checkpointFileIdentifier, sizeof( checkpointFileIdentifier ) ) != 0 )
+    {
+        return false;
+    }
+
+    if( header.stateSize != static_cast< std::uint64_t >( initialStates.rows( ) ) ||
+            !readValues( file, fileInitialStates.data( ), fileInitialStates.size( ) * sizeof( double ) ) ||
+            header.initialTime != initialTime || header.integratorType != integratorType ||
+            header.settingsHash != settingsHash_ ||
+            !std::equal( fileInitialStates.begin( ), fileInitialStates.end( ), initialStates.data( ) ) )
+    {
+        throw std::runtime_error( "Error when resuming propagation, " + filePath_ + " holds checkpoints of a "
+                                  "different propagation" );
+    }
+
+    // Complete blocks are passed on one at a time; reading stops at the first incomplete one.
+    numberOfColumns_ = 1 + header.stateSize + header.dependentVariableSize;
+    std::size_t validSize = static_cast< std::size_t >( file.tellg( ) );
+    bool isResumed = false;
+    CheckpointBlockHeader blockHeader;
+    std::vector< double > rows;
+    Eigen::MatrixXd currentState;
+    char blockEnd[ 8 ];
+    while( readValues( file, &blockHeader, sizeof( blockHeader ) ) &&
+           std::memcmp( blockHeader.identifier, checkpointBlockIdentifier, sizeof( checkpointBlockIdentifier ) ) == 0 )
+    {
+        rows.resize( blockHeader.numberOfRows * numberOfColumns_ );
+        currentState.resize( blockHeader.stateRows, blockHeader.stateColumns );
+        if( !readValues( file, rows.data( ), rows.size( ) * sizeof( double ) ) ||
+                !readValues( file, currentState.data( ), currentState.size( ) * sizeof( double ) ) ||
+                !readValues( file, blockEnd, sizeof( blockEnd ) ) ||
+                std::memcmp( blockEnd, checkpointBlockIdentifier, sizeof( checkpointBlockIdentifier ) ) != 0 )
+        {
+            break;
+        }
+
+        if( !isResumed )
+        {
+            outputSink.initialize( header.stateSize, header.dependentVariableSize );
+            isResumed = true;
+        }
+        Eigen::VectorXd state( header.stateSize );
+        Eigen::VectorXd dependentVariables( header.dependentVariableSize );
+        for( std::size_t i = 0; i < blockHeader.numberOfRows; i++ )
+        {
+            const double* row = rows.data( ) + i * numberOfColumns_;
+            std::copy( row + 1, row + 1 + header.stateSize, state.data( ) );
+            std::copy( row + 1 + header.stateSize, row + numberOfColumns_, dependentVariables.data( ) );
+            outputSink.append( row[ 0 ], state, dependentVariables );
+        }
+        loopState.currentTime = blockHeader.currentTime;
+        loopState.timeStep = blockHeader.timeStep;
+        loopState.currentState = currentState;
+        validSize = static_cast< std::size_t >( file.tellg( ) );
+    }
+    if( !isResumed )
+    {
+        return false;
+    }
+
+    // An incomplete block at the end is removed, so that new blocks directly follow the last complete one.
+    file.clear( );
+    file.seekg( 0, std::ios::end );
+    const std::size_t fileSize = static_cast< std::size_t >( file.tellg( ) );
+    file.close( );
+    if( fileSize != validSize )
+    {
+        truncateFile( filePath_, validSize );
+    }
+
+    file_.open( filePath_.c_str( ), std::ios::binary | std::ios::app );
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when resuming propagation, could not open " + filePath_ );
+    }
+    rowBuffer_.clear( );
+    lastCheckpointTime_ = std::chrono::steady_clock::now( );
+    return true;
+}
+
+void PropagationCheckpointFile::start( const double initialTime, const Eigen::VectorXd& initialStates,
+                                       const int integratorType, const std::size_t dependentVariableSize )
+{
+    file_.open( filePath_.c_str( ), std::ios::binary | std::ios::trunc );
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when creating propagation checkpoints, could not open " + filePath_ );
+    }
+
+    CheckpointFileHeader header;
+    std::memcpy( header.identifier, checkpointFileIdentifier, sizeof( checkpointFileIdentifier ) );
+    header.stateSize = initialStates.rows( );
+    header.dependentVariableSize = dependentVariableSize;
+    header.integratorType = integratorType;
+    header.initialTime = initialTime;
+    header.settingsHash = settingsHash_;
+    file_.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+    file_.write( reinterpret_cast< const char* >( initialStates.data( ) ), initialStates.rows( ) * sizeof( double ) );
+    file_.flush( );
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when creating propagation checkpoints, could not write " + filePath_ );
+    }
+    synchronizeFile( filePath_ );
+
+    numberOfColumns_ = 1 + initialStates.rows( ) + dependentVariableSize;
+    rowBuffer_.clear( );
+    lastCheckpointTime_ = std::chrono::steady_clock::now( );
+}
+
+void PropagationCheckpointFile::append( const double epoch, const Eigen::VectorXd& state,
+                                        const Eigen::VectorXd& dependentVariables )
+{
+    rowBuffer_.push_back( epoch );
+    rowBuffer_.insert( rowBuffer_.end( ), state.data( ), state.data( ) + state.rows( ) );
+    rowBuffer_.insert( rowBuffer_.end( ), dependentVariables.data( ),
+                       dependentVariables.data( ) + dependentVariables.rows( ) );
+}
+
+void PropagationCheckpointFile::writeCheckpoint( const PropagationLoopState& loopState )
+{
+    CheckpointBlockHeader blockHeader;
+    std::memcpy( blockHeader.identifier, checkpointBlockIdentifier, sizeof( checkpointBlockIdentifier ) );
+    blockHeader.numberOfRows = rowBuffer_.size( ) / numberOfColumns_;
+    blockHeader.stateRows = loopState.currentState.rows( );
+    blockHeader.stateColumns = loopState.currentState.cols( );
+    blockHeader.currentTime = loopState.currentTime;
+    blockHeader.timeStep = loopState.timeStep;
+
+    file_.write( reinterpret_cast< const char* >( &blockHeader ), sizeof( blockHeader ) );
+    file_.write( reinterpret_cast< const char* >( rowBuffer_.data( ) ), rowBuffer_.size( ) * sizeof( double ) );
+    file_.write( reinterpret_cast< const char* >( loopState.currentState.data( ) ),
+                 loopState.currentState.size( ) * sizeof( double ) );
+    file_.write( checkpointBlockIdentifier, sizeof( checkpointBlockIdentifier ) );
+    file_.flush( );
+    if( !file_ )
+    {
+        throw std::runtime_error( "Error when writing propagation checkpoint " + filePath_ );
+    }
+
+    // The block is only complete once it is on the storage device.
+    synchronizeFile( filePath_ );
+
+    rowBuffer_.clear( );
+    lastCheckpointTime_ = std::chrono::steady_clock::now( );
+}
+
+std::shared_ptr< IntegratorSettings< double > > createRestartIntegratorSettings(
+        const std::shared_ptr< IntegratorSettings< double > > integratorSettings,
+        const PropagationLoopState& loopState )
+{
+    if( integratorSettings->integratorType_ != euler && integratorSettings->integratorType_ != rungeKutta4 &&
+            integratorSettings->integratorType_ != rungeKuttaVariableStepSize )
+    {
+        throw std::runtime_error( "Error when resuming propagation, only the Euler, RK4 and variable step "
+                                  "Runge-Kutta integrators are supported" );
+    }
+    const std::shared_ptr< IntegratorSettings< double > > restartSettings =
+            copyIntegratorSettings( integratorSettings );
+    restartSettings->initialTime_ = loopState.currentTime;
+    restartSettings->initialTimeStep_ = loopState.timeStep;
+    return restartSettings;
+}
+
+} // namespace tudatpy
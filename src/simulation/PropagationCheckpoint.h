@@ -0,0 +1,179 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PROPAGATION_CHECKPOINT_H
+#define TUDATPY_PROPAGATION_CHECKPOINT_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+
+#include "PropagationLoop.h"
+
+namespace tudatpy
+{
+
+//! State of the integration loop of propagateToSink after an integrated epoch, from which it can be continued.
+struct PropagationLoopState
+{
+    //! Current epoch.
+    double currentTime;
+
+    //! Size of the next step, as proposed by the integrator.
+    double timeStep;
+
+    //! Current propagated (not conventional) state.
+    Eigen::MatrixXd currentState;
+};
+
+//! Receiver of the state of the integration loop of propagateToSink, from which the loop can also be resumed.
+/*!
+ *  The environment models are functions of the epoch and propagated state, and are updated from them at the first
+ *  integrator stage, so that the loop state is all that is needed to continue the propagation. With a single-step
+ *  integrator (Euler, RK4 or variable step Runge-Kutta), which only carries the state and the proposed step size from
+ *  one step to the next, a resumed propagation is then bit-for-bit identical to an uninterrupted one.
+ */
+class PropagationCheckpointer
+{
+public:
+
+    //! Destructor.
+    virtual ~PropagationCheckpointer( ) { }
+
+    //! Called before the propagation; resumes it from a checkpoint, if any is available.
+    /*!
+     *  \param initialTime Initial epoch of the propagation.
+     *  \param initialStates Conventional initial states of the propagation.
+     *  \param integratorType Type of the numerical integrator.
+     *  \param outputSink Sink, to be initialized and passed the output up to the checkpoint if the propagation is
+     *  resumed.
+     *  \param loopState Loop state at the checkpoint, set if the propagation is resumed.
+     *  \return Whether the propagation is resumed; if not, it is started from the initial states, and start is called.
+     */
+    virtual bool resume( const double initialTime, const Eigen::VectorXd& initialStates, const int integratorType,
+                         PropagationOutputSink& outputSink, PropagationLoopState& loopState ) = 0;
+
+    //! Called when the propagation is started from the initial states, before the output of the initial epoch.
+    /*!
+     *  \param initialTime Initial epoch of the propagation.
+     *  \param initialStates Conventional initial states of the propagation.
+     *  \param integratorType Type of the numerical integrator.
+     *  \param dependentVariableSize Size of the dependent variable vectors (0 if none are saved).
+     */
+    virtual void start( const double initialTime, const Eigen::VectorXd& initialStates, const int integratorType,
+                        const std::size_t dependentVariableSize ) = 0;
+
+    //! Called for the output passed to the sink for every integrated epoch (including the initial epoch, but not the
+    //! output passed on by resume).
+    virtual void append( const double epoch, const Eigen::VectorXd& state,
+                         const Eigen::VectorXd& dependentVariables ) = 0;
+
+    //! Whether a checkpoint is to be written after the last appended epoch.
+    virtual bool isCheckpointDue( ) const = 0;
+
+    //! Called with the loop state at the last appended epoch when a checkpoint is due, and at the end.
+    virtual void writeCheckpoint( const PropagationLoopState& loopState ) = 0;
+};
+
+//! Writer of the checkpoints of a propagation to a file, from which it can be resumed after an interruption.
+/*!
+ *  The checkpoint file consists of a header identifying the propagation (initial epoch, initial states, integrator
+ *  type, output sizes and a hash of the propagation settings, see serializePropagationSettings), followed by a block
+ *  per checkpoint. Each block holds the output appended since the previous checkpoint (as rows of epoch, state and
+ *  dependent variables) and the loop state at its last epoch, and ends with an identifier, so that a block that was
+ *  being written when the process was stopped is recognized and discarded. Every output row is thus written once, and
+ *  values are stored in native byte order. The file is synchronized to the storage device after every checkpoint.
+ */
+class PropagationCheckpointFile: public PropagationCheckpointer
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param filePath Path of the checkpoint file.
+     *  \param checkpointInterval Minimum wall-clock time between checkpoints (in seconds); 0 writes a checkpoint after
+     *  every step.
+     *  \param integratorSettings Settings of the numerical integrator of the propagation.
+     *  \param propagatorSettings Settings of the propagation.
+     */
+    PropagationCheckpointFile(
+            const std::string& filePath, const double checkpointInterval,
+            const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+            const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings );
+
+    //! Resume a propagation from the last complete checkpoint of the file, if any.
+    /*!
+     *  The file is truncated to the checkpoint, so that later checkpoints are appended to it.
+     *  \throws std::runtime_error If the file holds checkpoints of a different propagation.
+     */
+    bool resume( const double initialTime, const Eigen::VectorXd& initialStates, const int integratorType,
+                 PropagationOutputSink& outputSink, PropagationLoopState& loopState );
+
+    //! Start a new checkpoint file, replacing the existing one (if any).
+    void start( const double initialTime, const Eigen::VectorXd& initialStates, const int integratorType,
+                const std::size_t dependentVariableSize );
+
+    //! Buffer the output of an epoch, to be written with the next checkpoint.
+    void append( const double epoch, const Eigen::VectorXd& state, const Eigen::VectorXd& dependentVariables );
+
+    //! Whether the checkpoint interval has passed since the last checkpoint.
+    bool isCheckpointDue( ) const
+    {
+        return std::chrono::duration< double >( std::chrono::steady_clock::now( ) - lastCheckpointTime_ ).count( ) >=
+                checkpointInterval_;
+    }
+
+    //! Write the buffered output and the loop state at its last epoch to the file.
+    void writeCheckpoint( const PropagationLoopState& loopState );
+
+private:
+
+    //! Path of the checkpoint file.
+    std::string filePath_;
+
+    //! Minimum wall-clock time between checkpoints (in seconds).
+    double checkpointInterval_;
+
+    //! Hash of the serialized settings of the propagation.
+    std::uint64_t settingsHash_;
+
+    //! Checkpoint file, opened for appending.
+    std::ofstream file_;
+
+    //! Number of columns (epoch, states and dependent variables) of an output row.
+    std::size_t numberOfColumns_;
+
+    //! Row-major output rows appended since the last checkpoint.
+    std::vector< double > rowBuffer_;
+
+    //! Wall-clock time of the last checkpoint (or of the start of the propagation).
+    std::chrono::steady_clock::time_point lastCheckpointTime_;
+};
+
+//! Integrator settings with which a propagation is continued from a checkpoint.
+/*!
+ *  \param integratorSettings Settings of the propagation, which must be those of a single-step integrator.
+ *  \param loopState Loop state at the checkpoint, which sets the initial epoch and step size.
+ *  \return Copy of integratorSettings starting at the checkpoint.
+ *  \throws std::runtime_error For integrators that carry more than the state between steps.
+ */
+std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > createRestartIntegratorSettings(
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const PropagationLoopState& loopState );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_PROPAGATION_CHECKPOINT_H
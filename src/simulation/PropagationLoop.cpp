@@ -0,0 +1,187 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationTermination.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationOutput.h"
+
+#include "PropagationCheckpoint.h"
+#include "PropagationLoop.h"
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+
+namespace tudatpy
+{
+
+void propagateToSink( SingleArcDynamicsSimulator< double, double >& simulator, const NamedBodyMap& bodyMap,
+                      const Eigen::VectorXd& initialStates, PropagationOutputSink& outputSink,
+                      PropagationProfiler* profiler, PropagationCheckpointer* checkpointer )
+{
+    typedef Eigen::MatrixXd StateType;
+
+    const std::shared_ptr< DynamicsStateDerivativeModel< double, double > > stateDerivativeModel =
+            profiler != nullptr ? profiler->getStateDerivativeModel( ) : simulator.getDynamicsStateDerivative( );
+    const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings =
+            simulator.getIntegratorSettings( );
+    const std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings =
+            simulator.getPropagatorSettings( );
+
+    const std::function< StateType( const double, const StateType& ) > stateDerivativeFunction =
+            std::bind( &DynamicsStateDerivativeModel< double, double >::computeStateDerivative, stateDerivativeModel,
+                       std::placeholders::_1, std::placeholders::_2 );
+
+    // With a profiler, the evaluations of the integrator stages are timed separately from those for the output.
+    std::function< StateType( const double, const StateType& ) > integratorStateDerivativeFunction =
+            stateDerivativeFunction;
+    if( profiler != nullptr )
+    {
+        profiler->reset( );
+        integratorStateDerivativeFunction = [ profiler, stateDerivativeFunction ](
+                const double time, const StateType& state ) -> StateType
+        {
+            ScopedProfileTimer timer( profiler->getIntegratorStageCounter( ) );
+            return stateDerivativeFunction( time, state );
+        };
+    }
+
+    double currentTime = integratorSettings->initialTime_;
+    StateType currentState = stateDerivativeModel->convertFromOutputSolution( initialStates, currentTime );
+    double timeStep = integratorSettings->initialTimeStep_;
+
+    // Termination conditions and dependent variables use the models of the simulator (also when profiling, as they
+    // identify acceleration models by their type), which are updated through the instrumented models.
+    const auto originalStateDerivativeModels = simulator.getDynamicsStateDerivative( )->getStateDerivativeModels( );
+
+    const std::shared_ptr< PropagationTerminationCondition > terminationCondition =
+            createPropagationTerminationConditions(
+                propagatorSettings->getTerminationSettings( ), bodyMap, integratorSettings->initialTimeStep_,
+                originalStateDerivativeModels );
+
+    std::function< Eigen::VectorXd( ) > dependentVariableFunction;
+    if( propagatorSettings->getDependentVariablesToSave( ) != nullptr )
+    {
+        dependentVariableFunction = createDependentVariableListFunction< double, double >(
+                    propagatorSettings->getDependentVariablesToSave( ), bodyMap,
+                    originalStateDerivativeModels ).first;
+    }
+
+    // The conventional state of translational dynamics propagated with Cowell's method is the propagated state, which
+    // is then copied to the output vector instead of being converted (and returned in a newly allocated vector).
+    const std::shared_ptr< TranslationalStatePropagatorSettings< double > > translationalSettings =
+            std::dynamic_pointer_cast< TranslationalStatePropagatorSettings< double > >( propagatorSettings );
+    const bool isOutputPropagatedState =
+            translationalSettings != nullptr && translationalSettings->propagator_ == cowell;
+
+    // Output is created from the environment at the output epoch, which is updated by evaluating the derivative.
+    Eigen::VectorXd output( initialStates.rows( ) );
+    Eigen::VectorXd dependentVariables;
+    ProfileCounter unusedOutputCounter;
+    const auto computeOutput = [ & ]( )
+    {
+        ScopedProfileTimer timer( profiler != nullptr ? profiler->getOutputCounter( ) : unusedOutputCounter );
+        if( dependentVariableFunction )
+        {
+            stateDerivativeFunction( currentTime, currentState );
+            dependentVariables = dependentVariableFunction( );
+        }
+        if( isOutputPropagatedState )
+        {
+            output = currentState.col( 0 );
+        }
+        else
+        {
+            output = stateDerivativeModel->convertToOutputSolution( currentState, currentTime );
+        }
+    };
+
+    // A resumed propagation continues from its last checkpoint, of which the output has been passed to the sink.
+    PropagationLoopState loopState;
+    if( checkpointer != nullptr && checkpointer->resume( currentTime, initialStates,
+                                                         integratorSettings->integratorType_, outputSink, loopState ) )
+    {
+        currentTime = loopState.currentTime;
+        currentState = loopState.currentState;
+        timeStep = loopState.timeStep;
+
+        // As after an integrated step, the termination conditions see the environment updated to the current state.
+        stateDerivativeFunction( currentTime, currentState );
+    }
+    else
+    {
+        computeOutput( );
+        outputSink.initialize( output.rows( ), dependentVariables.rows( ) );
+        outputSink.append( currentTime, output, dependentVariables );
+        if( checkpointer != nullptr )
+        {
+            checkpointer->start( currentTime, initialStates, integratorSettings->integratorType_,
+                                 dependentVariables.rows( ) );
+            checkpointer->append( currentTime, output, dependentVariables );
+        }
+    }
+
+    // With checkpoints, the integrator is (also when starting) created from settings for the current loop state,
+    // which are only available for integrators of which that state is all that is carried between steps.
+    const std::shared_ptr< tudat::numerical_integrators::NumericalIntegrator< double, StateType, StateType > >
+            integrator = tudat::numerical_integrators::createIntegrator< double, StateType >(
+                integratorStateDerivativeFunction, currentState,
+                checkpointer != nullptr ? createRestartIntegratorSettings(
+                                              integratorSettings, { currentTime, timeStep, currentState } )
+                                        : integratorSettings );
+
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+    const auto getElapsedTime = [ & ]( )
+    {
+        return std::chrono::duration< double >( std::chrono::steady_clock::now( ) - startTime ).count( );
+    };
+
+    while( !terminationCondition->checkStopCondition( currentTime, getElapsedTime( ) ) )
+    {
+        currentState = integrator->performIntegrationStep( timeStep );
+        currentTime = integrator->getCurrentIndependentVariable( );
+        timeStep = integrator->getNextStepSize( );
+        if( !currentState.allFinite( ) )
+        {
+            throw std::runtime_error( "Error in propagation, state is not finite at t = " +
+                                      std::to_string( currentTime ) );
+        }
+        if( profiler != nullptr )
+        {
+            profiler->addAcceptedStep( );
+        }
+        computeOutput( );
+        outputSink.append( currentTime, output, dependentVariables );
+        if( checkpointer != nullptr )
+        {
+            checkpointer->append( currentTime, output, dependentVariables );
+            if( checkpointer->isCheckpointDue( ) )
+            {
+                checkpointer->writeCheckpoint( { currentTime, timeStep, currentState } );
+            }
+        }
+    }
+
+    if( checkpointer != nullptr )
+    {
+        checkpointer->writeCheckpoint( { currentTime, timeStep, currentState } );
+    }
+
+    if( profiler != nullptr )
+    {
+        profiler->setTotalTime( getNanosecondsSince( startTime ) );
+    }
+    outputSink.finalize( );
+}
+
+} // namespace tudatpy
@@ -0,0 +1,117 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PROPAGATION_LOOP_H
+#define TUDATPY_PROPAGATION_LOOP_H
+
+#include <cstddef>
+
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+#include "PropagationProfiler.h"
+#include "StateHistory.h"
+
+namespace tudatpy
+{
+
+class PropagationCheckpointer;
+
+//! Receiver of the output of a propagation, to which every integrated state is passed as soon as it is computed.
+class PropagationOutputSink
+{
+public:
+
+    //! Destructor.
+    virtual ~PropagationOutputSink( ) { }
+
+    //! Called once, before the first state is appended.
+    /*!
+     *  \param stateSize Size of the (conventional) state vectors.
+     *  \param dependentVariableSize Size of the dependent variable vectors (0 if none are saved).
+     */
+    virtual void initialize( const std::size_t stateSize, const std::size_t dependentVariableSize ) = 0;
+
+    //! Called for every integrated epoch, in order, starting with the initial epoch.
+    /*!
+     *  \param epoch Epoch of the state.
+     *  \param state Conventional state at the epoch.
+     *  \param dependentVariables Dependent variables at the epoch (empty if none are saved).
+     */
+    virtual void append( const double epoch, const Eigen::VectorXd& state,
+                         const Eigen::VectorXd& dependentVariables ) = 0;
+
+    //! Called once, after the last state has been appended.
+    virtual void finalize( ) { }
+};
+
+//! Output sink appending the states and dependent variables to contiguous histories.
+class HistoryOutputSink: public PropagationOutputSink
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param stateHistory History to which the states are appended.
+     *  \param dependentVariableHistory History to which the dependent variables (if any) are appended.
+     */
+    HistoryOutputSink( StateHistory& stateHistory, StateHistory& dependentVariableHistory ):
+        stateHistory_( stateHistory ), dependentVariableHistory_( dependentVariableHistory )
+    { }
+
+    void initialize( const std::size_t /*stateSize*/, const std::size_t /*dependentVariableSize*/ )
+    {
+        stateHistory_.clear( );
+        dependentVariableHistory_.clear( );
+    }
+
+    void append( const double epoch, const Eigen::VectorXd& state, const Eigen::VectorXd& dependentVariables )
+    {
+        stateHistory_.append( epoch, state );
+        if( dependentVariables.rows( ) > 0 )
+        {
+            dependentVariableHistory_.append( epoch, dependentVariables );
+        }
+    }
+
+private:
+
+    //! History to which the states are appended.
+    StateHistory& stateHistory_;
+
+    //! History to which the dependent variables are appended.
+    StateHistory& dependentVariableHistory_;
+};
+
+//! Propagate the equations of motion of a simulator, passing every integrated state to an output sink.
+/*!
+ *  The integration loop uses the integrator, state derivative model, termination and dependent variable settings of
+ *  the simulator, but stores nothing itself: the memory used depends only on the sink. The propagation ends on the
+ *  first step at which the termination condition is met (the final state is not interpolated to the condition).
+ *  The output state is passed in a vector that is reused for every epoch, and is filled without allocation for
+ *  translational dynamics propagated with Cowell's method. The Tudat integrator, state conversions and dependent
+ *  variables return their results by value, and thus still allocate at every step.
+ *  \param simulator Simulator, created without integrating its equations of motion.
+ *  \param bodyMap Bodies used by the simulator.
+ *  \param initialStates Conventional initial states.
+ *  \param outputSink Sink receiving the output.
+ *  \param profiler Profiler of the simulator, whose instrumented state derivative model is then used, and whose
+ *  counters are reset and filled (none if nullptr).
+ *  \param checkpointer Receiver of checkpoints of the propagation (none if nullptr). If it holds a checkpoint to
+ *  resume from, the output up to that checkpoint is passed to the sink, and the propagation continues from it (see
+ *  PropagationCheckpointer).
+ */
+void propagateToSink( tudat::propagators::SingleArcDynamicsSimulator< double, double >& simulator,
+                      const tudat::simulation_setup::NamedBodyMap& bodyMap, const Eigen::VectorXd& initialStates,
+                      PropagationOutputSink& outputSink, PropagationProfiler* profiler = nullptr,
+                      PropagationCheckpointer* checkpointer = nullptr );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_PROPAGATION_LOOP_H
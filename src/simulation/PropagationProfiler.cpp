@@ -0,0 +1,197 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModelTypes.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createStateDerivativeModel.h"
+
+#include "PropagationProfiler.h"
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::basic_astrodynamics;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Number of state derivative evaluations per step attempt of an integrator (0 if unknown).
+unsigned int getNumberOfStagesPerStep( const std::shared_ptr< IntegratorSettings< double > > integratorSettings )
+{
+    switch( integratorSettings->integratorType_ )
+    {
+    case euler:
+        return 1;
+    case rungeKutta4:
+        return 4;
+    case rungeKuttaVariableStepSize:
+    {
+        std::shared_ptr< RungeKuttaVariableStepSizeSettings< double > > variableStepSizeSettings =
+                std::dynamic_pointer_cast< RungeKuttaVariableStepSizeSettings< double > >( integratorSettings );
+        return variableStepSizeSettings == nullptr ?
+                    0 : RungeKuttaCoefficients::get( variableStepSizeSettings->coefficientSet_ ).cCoefficients.rows( );
+    }
+    default:
+        return 0;
+    }
+}
+
+void appendCounterRow( std::string& report, const std::string& name, const ProfileCounter& counter,
+                       const std::uint64_t totalNanoseconds )
+{
+    const double meanNanoseconds =
+            counter.numberOfCalls > 0 ? static_cast< double >( counter.nanoseconds ) / counter.numberOfCalls : 0.0;
+    char row[ 160 ];
+    std::snprintf( row, sizeof( row ), "%-48s %12llu %14.3f %12.1f %7.1f%%\n", name.c_str( ),
+                   static_cast< unsigned long long >( counter.numberOfCalls ), counter.nanoseconds * 1.0E-6,
+                   meanNanoseconds,
+                   totalNanoseconds > 0 ? 100.0 * counter.nanoseconds / totalNanoseconds : 0.0 );
+    report += row;
+}
+
+} // namespace
+
+PropagationProfiler::PropagationProfiler( SingleArcDynamicsSimulator< double, double >& simulator,
+                                          const NamedBodyMap& bodyMap ):
+    numberOfStagesPerStep_( getNumberOfStagesPerStep( simulator.getIntegratorSettings( ) ) )
+{
+    const std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            std::dynamic_pointer_cast< TranslationalStatePropagatorSettings< double > >(
+                simulator.getPropagatorSettings( ) );
+    if( propagatorSettings == nullptr )
+    {
+        throw std::runtime_error( "Error when profiling propagation, only translational dynamics are supported" );
+    }
+    // The propagated states are converted by the state derivative model of the simulator, whose non-Cowell
+    // propagators keep state (such as reference orbits) that would not match that of the timed model.
+    if( propagatorSettings->propagator_ != cowell )
+    {
+        throw std::runtime_error( "Error when profiling propagation, only the Cowell propagator is supported" );
+    }
+
+    // Replace every acceleration model by a timed one, in a copy of the acceleration map.
+    AccelerationMap profiledAccelerations;
+    for( auto accelerationIterator = propagatorSettings->accelerationsMap_.begin( );
+         accelerationIterator != propagatorSettings->accelerationsMap_.end( ); accelerationIterator++ )
+    {
+        for( auto exertingIterator = accelerationIterator->second.begin( );
+             exertingIterator != accelerationIterator->second.end( ); exertingIterator++ )
+        {
+            for( unsigned int i = 0; i < exertingIterator->second.size( ); i++ )
+            {
+                AccelerationProfile accelerationProfile;
+                accelerationProfile.bodyUndergoingAcceleration = accelerationIterator->first;
+                accelerationProfile.bodyExertingAcceleration = exertingIterator->first;
+                accelerationProfile.accelerationType = getAccelerationModelName(
+                            getAccelerationModelType( exertingIterator->second.at( i ) ) );
+                profile_.accelerations.push_back( accelerationProfile );
+
+                accelerationCounters_.push_back( std::make_shared< ProfileCounter >( ) );
+                profiledAccelerations[ accelerationIterator->first ][ exertingIterator->first ].push_back(
+                            std::make_shared< ProfiledAccelerationModel >(
+                                exertingIterator->second.at( i ), accelerationCounters_.back( ) ) );
+            }
+        }
+    }
+
+    const std::shared_ptr< TranslationalStatePropagatorSettings< double > > profiledPropagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                propagatorSettings->centralBodies_, profiledAccelerations, propagatorSettings->bodiesToIntegrate_,
+                propagatorSettings->getInitialStates( ), propagatorSettings->getTerminationSettings( ),
+                propagatorSettings->propagator_ );
+
+    // The environment is updated by the updater of the simulator, which was created from the original models.
+    const std::shared_ptr< EnvironmentUpdater< double, double > > environmentUpdater =
+            simulator.getEnvironmentUpdater( );
+    ProfileCounter* environmentUpdateCounter = &profile_.environmentUpdate;
+    const std::function< void( const double, const std::unordered_map< IntegratedStateType, Eigen::VectorXd >&,
+                               const std::vector< IntegratedStateType >& ) > environmentUpdateFunction =
+            [ environmentUpdater, environmentUpdateCounter ](
+            const double currentTime, const std::unordered_map< IntegratedStateType, Eigen::VectorXd >& states,
+            const std::vector< IntegratedStateType >& statesFromEnvironment )
+    {
+        ScopedProfileTimer timer( *environmentUpdateCounter );
+        environmentUpdater->updateEnvironment( currentTime, states, statesFromEnvironment );
+    };
+
+    stateDerivativeModel_ = std::make_shared< DynamicsStateDerivativeModel< double, double > >(
+                createStateDerivativeModels< double, double >(
+                    profiledPropagatorSettings, bodyMap, simulator.getIntegratorSettings( )->initialTime_ ),
+                environmentUpdateFunction );
+}
+
+void PropagationProfiler::reset( )
+{
+    for( unsigned int i = 0; i < accelerationCounters_.size( ); i++ )
+    {
+        accelerationCounters_.at( i )->reset( );
+    }
+    profile_.environmentUpdate.reset( );
+    profile_.integratorStages.reset( );
+    profile_.output.reset( );
+    profile_.numberOfAcceptedSteps = 0;
+    profile_.numberOfRejectedSteps = 0;
+    profile_.totalNanoseconds = 0;
+}
+
+PropagationProfile PropagationProfiler::getProfile( ) const
+{
+    PropagationProfile profile = profile_;
+    for( unsigned int i = 0; i < accelerationCounters_.size( ); i++ )
+    {
+        profile.accelerations.at( i ).counter = *accelerationCounters_.at( i );
+    }
+
+    // Every step attempt of a Runge-Kutta integrator evaluates all its stages, so that the attempts that were not
+    // accepted follow from the number of stage evaluations.
+    if( numberOfStagesPerStep_ > 0 )
+    {
+        const std::uint64_t numberOfAttempts = profile.integratorStages.numberOfCalls / numberOfStagesPerStep_;
+        profile.numberOfRejectedSteps = numberOfAttempts > profile.numberOfAcceptedSteps ?
+                    numberOfAttempts - profile.numberOfAcceptedSteps : 0;
+    }
+    return profile;
+}
+
+std::string formatPropagationProfile( const PropagationProfile& profile )
+{
+    std::string report;
+    char header[ 160 ];
+    std::snprintf( header, sizeof( header ), "%-48s %12s %14s %12s %8s\n", "", "calls", "total [ms]", "mean [ns]",
+                   "share" );
+    report += header;
+    for( unsigned int i = 0; i < profile.accelerations.size( ); i++ )
+    {
+        const AccelerationProfile& accelerationProfile = profile.accelerations.at( i );
+        appendCounterRow( report, accelerationProfile.accelerationType + " (" +
+                          accelerationProfile.bodyExertingAcceleration + " on " +
+                          accelerationProfile.bodyUndergoingAcceleration + ")",
+                          accelerationProfile.counter, profile.totalNanoseconds );
+    }
+    appendCounterRow( report, "environment update", profile.environmentUpdate, profile.totalNanoseconds );
+    appendCounterRow( report, "integrator stages (total)", profile.integratorStages, profile.totalNanoseconds );
+    appendCounterRow( report, "output", profile.output, profile.totalNanoseconds );
+
+    char footer[ 160 ];
+    std::snprintf( footer, sizeof( footer ), "accepted steps: %llu, rejected steps: %llu, total time: %.3f ms\n",
+                   static_cast< unsigned long long >( profile.numberOfAcceptedSteps ),
+                   static_cast< unsigned long long >( profile.numberOfRejectedSteps ),
+                   profile.totalNanoseconds * 1.0E-6 );
+    report += footer;
+    return report;
+}
+
+} // namespace tudatpy
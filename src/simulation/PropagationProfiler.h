@@ -0,0 +1,250 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PROPAGATION_PROFILER_H
+#define TUDATPY_PROPAGATION_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+namespace tudatpy
+{
+
+//! Number of calls and cumulative wall-clock time of an instrumented operation.
+struct ProfileCounter
+{
+    ProfileCounter( ): numberOfCalls( 0 ), nanoseconds( 0 ) { }
+
+    void reset( )
+    {
+        numberOfCalls = 0;
+        nanoseconds = 0;
+    }
+
+    //! Number of calls.
+    std::uint64_t numberOfCalls;
+
+    //! Cumulative wall-clock time of the calls, in nanoseconds.
+    std::uint64_t nanoseconds;
+};
+
+//! Wall-clock time since a given time point, in nanoseconds.
+inline std::uint64_t getNanosecondsSince( const std::chrono::steady_clock::time_point startTime )
+{
+    return static_cast< std::uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                             std::chrono::steady_clock::now( ) - startTime ).count( ) );
+}
+
+//! Adds the wall-clock time between its construction and destruction to a counter.
+class ScopedProfileTimer
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param counter Counter to which the time is added.
+     *  \param isCallCounted Whether the timed scope is counted as a call.
+     */
+    ScopedProfileTimer( ProfileCounter& counter, const bool isCallCounted = true ):
+        counter_( counter ), startTime_( std::chrono::steady_clock::now( ) )
+    {
+        if( isCallCounted )
+        {
+            counter_.numberOfCalls++;
+        }
+    }
+
+    ~ScopedProfileTimer( )
+    {
+        counter_.nanoseconds += getNanosecondsSince( startTime_ );
+    }
+
+private:
+
+    //! Counter to which the time is added.
+    ProfileCounter& counter_;
+
+    //! Time at construction.
+    std::chrono::steady_clock::time_point startTime_;
+};
+
+//! Acceleration model forwarding to another model, while timing its updates and evaluations.
+/*!
+ *  Every update is counted as a call; the time of both the update and the evaluation is accumulated.
+ */
+class ProfiledAccelerationModel: public tudat::basic_astrodynamics::AccelerationModel< Eigen::Vector3d >
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param accelerationModel Acceleration model that is timed.
+     *  \param counter Counter to which the calls and time are added.
+     */
+    ProfiledAccelerationModel(
+            const std::shared_ptr< tudat::basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > accelerationModel,
+            const std::shared_ptr< ProfileCounter > counter ):
+        accelerationModel_( accelerationModel ), counter_( counter )
+    { }
+
+    Eigen::Vector3d getAcceleration( )
+    {
+        ScopedProfileTimer timer( *counter_, false );
+        return accelerationModel_->getAcceleration( );
+    }
+
+    void updateMembers( const double currentTime = TUDAT_NAN )
+    {
+        ScopedProfileTimer timer( *counter_ );
+        accelerationModel_->updateMembers( currentTime );
+    }
+
+    void resetTime( const double currentTime = TUDAT_NAN )
+    {
+        accelerationModel_->resetTime( currentTime );
+    }
+
+private:
+
+    //! Acceleration model that is timed.
+    std::shared_ptr< tudat::basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > accelerationModel_;
+
+    //! Counter to which the calls and time are added.
+    std::shared_ptr< ProfileCounter > counter_;
+};
+
+//! Profile of a single acceleration model.
+struct AccelerationProfile
+{
+    //! Name of the body undergoing the acceleration.
+    std::string bodyUndergoingAcceleration;
+
+    //! Name of the body exerting the acceleration.
+    std::string bodyExertingAcceleration;
+
+    //! Name of the type of acceleration.
+    std::string accelerationType;
+
+    //! Number of updates, and time of the updates and evaluations.
+    ProfileCounter counter;
+};
+
+//! Profile of a propagation.
+struct PropagationProfile
+{
+    PropagationProfile( ): numberOfAcceptedSteps( 0 ), numberOfRejectedSteps( 0 ), totalNanoseconds( 0 ) { }
+
+    //! Profiles of the acceleration models (updated for integrator stages and output alike).
+    std::vector< AccelerationProfile > accelerations;
+
+    //! Environment updates.
+    ProfileCounter environmentUpdate;
+
+    //! State derivative evaluations of the integrator stages (including the environment updates and accelerations).
+    ProfileCounter integratorStages;
+
+    //! Creation of the output (state conversion and dependent variables) at the integrated epochs.
+    ProfileCounter output;
+
+    //! Number of integration steps that were accepted.
+    std::uint64_t numberOfAcceptedSteps;
+
+    //! Number of integration steps that were rejected by the step size control (of Runge-Kutta integrators).
+    std::uint64_t numberOfRejectedSteps;
+
+    //! Wall-clock time of the complete propagation loop, in nanoseconds.
+    std::uint64_t totalNanoseconds;
+};
+
+//! Instrumentation of the propagation of a simulator with translational dynamics.
+/*!
+ *  Creates a state derivative model equal to that of the simulator, but with timed acceleration models and environment
+ *  updates, which is used by propagateToSink instead of the model of the simulator. The type-dependent parts of the
+ *  simulator (environment updater, termination conditions and dependent variables) keep using the original models,
+ *  which are updated through the timed ones.
+ */
+class PropagationProfiler
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param simulator Simulator to instrument, which must propagate translational dynamics only, with the Cowell
+     *  propagator.
+     *  \param bodyMap Bodies used in the propagation.
+     *  \throws std::runtime_error For other dynamics or propagators.
+     */
+    PropagationProfiler( tudat::propagators::SingleArcDynamicsSimulator< double, double >& simulator,
+                         const tudat::simulation_setup::NamedBodyMap& bodyMap );
+
+    //! State derivative model with timed acceleration models and environment updates.
+    std::shared_ptr< tudat::propagators::DynamicsStateDerivativeModel< double, double > >
+    getStateDerivativeModel( ) const
+    {
+        return stateDerivativeModel_;
+    }
+
+    //! Reset all counters, before a new propagation.
+    void reset( );
+
+    //! Counter of the state derivative evaluations of the integrator stages.
+    ProfileCounter& getIntegratorStageCounter( )
+    {
+        return profile_.integratorStages;
+    }
+
+    //! Counter of the output creation.
+    ProfileCounter& getOutputCounter( )
+    {
+        return profile_.output;
+    }
+
+    //! Register an accepted integration step.
+    void addAcceptedStep( )
+    {
+        profile_.numberOfAcceptedSteps++;
+    }
+
+    //! Set the wall-clock time of the complete propagation loop.
+    void setTotalTime( const std::uint64_t nanoseconds )
+    {
+        profile_.totalNanoseconds = nanoseconds;
+    }
+
+    //! Profile of the last propagation.
+    PropagationProfile getProfile( ) const;
+
+private:
+
+    //! State derivative model with timed acceleration models and environment updates.
+    std::shared_ptr< tudat::propagators::DynamicsStateDerivativeModel< double, double > > stateDerivativeModel_;
+
+    //! Counters of the acceleration models, in the order of profile_.accelerations.
+    std::vector< std::shared_ptr< ProfileCounter > > accelerationCounters_;
+
+    //! Number of state derivative evaluations per integration step attempt (0 if unknown for the integrator).
+    unsigned int numberOfStagesPerStep_;
+
+    //! Profile, of which the acceleration counters are only filled by getProfile.
+    PropagationProfile profile_;
+};
+
+//! Format a propagation profile as a human-readable table.
+std::string formatPropagationProfile( const PropagationProfile& profile );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_PROPAGATION_PROFILER_H
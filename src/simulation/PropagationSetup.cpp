@@ -0,0 +1,234 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createAccelerationModels.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationSettings.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationTerminationSettings.h"
+
+#include "Conversions.h"
+#include "PropagationSetup.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::basic_astrodynamics;
+
+namespace tudatpy
+{
+
+SelectedAccelerationMap extractSelectedAccelerationMap( const dict& selectedAccelerations )
+{
+    SelectedAccelerationMap selectedAccelerationMap;
+    const list bodiesUndergoingAcceleration = selectedAccelerations.keys( );
+    for( long i = 0; i < len( bodiesUndergoingAcceleration ); i++ )
+    {
+        const std::string bodyUndergoingAcceleration = extract< std::string >( bodiesUndergoingAcceleration[ i ] );
+        const dict accelerationsOfBody = extract< dict >( selectedAccelerations[ bodiesUndergoingAcceleration[ i ] ] );
+        const list bodiesExertingAcceleration = accelerationsOfBody.keys( );
+        for( long j = 0; j < len( bodiesExertingAcceleration ); j++ )
+        {
+            const std::string bodyExertingAcceleration = extract< std::string >( bodiesExertingAcceleration[ j ] );
+            selectedAccelerationMap[ bodyUndergoingAcceleration ][ bodyExertingAcceleration ] =
+                    extractList< std::shared_ptr< AccelerationSettings > >(
+                        accelerationsOfBody[ bodiesExertingAcceleration[ j ] ] );
+        }
+    }
+    return selectedAccelerationMap;
+}
+
+std::shared_ptr< IntegratorSettings< double > > copyIntegratorSettings(
+        const std::shared_ptr< IntegratorSettings< double > > integratorSettings )
+{
+    switch( integratorSettings->integratorType_ )
+    {
+    case euler:
+    case rungeKutta4:
+        return std::make_shared< IntegratorSettings< double > >( *integratorSettings );
+    case rungeKuttaVariableStepSize:
+        return std::make_shared< RungeKuttaVariableStepSizeSettings< double > >(
+                    dynamic_cast< const RungeKuttaVariableStepSizeSettings< double >& >( *integratorSettings ) );
+    default:
+        throw std::runtime_error( "Error when copying integrator settings, only the Euler, RK4 and variable step "
+                                  "Runge-Kutta integrators are supported" );
+    }
+}
+
+std::shared_ptr< PropagationTerminationSettings > copyTerminationSettings(
+        const std::shared_ptr< PropagationTerminationSettings > terminationSettings )
+{
+    const std::shared_ptr< PropagationTimeTerminationSettings > timeTerminationSettings =
+            std::dynamic_pointer_cast< PropagationTimeTerminationSettings >( terminationSettings );
+    if( timeTerminationSettings == nullptr )
+    {
+        throw std::runtime_error( "Error when copying termination settings, only time termination settings are "
+                                  "supported" );
+    }
+    return std::make_shared< PropagationTimeTerminationSettings >( *timeTerminationSettings );
+}
+
+namespace
+{
+
+AccelerationMap createAccelerationModels(
+        const NamedBodyMap& bodyMap, const dict& selectedAccelerations, const list& bodiesToPropagate,
+        const list& centralBodies )
+{
+    return createAccelerationModelsMap(
+                bodyMap, extractSelectedAccelerationMap( selectedAccelerations ),
+                extractList< std::string >( bodiesToPropagate ), extractList< std::string >( centralBodies ) );
+}
+
+std::shared_ptr< TranslationalStatePropagatorSettings< double > > createTranslationalStatePropagatorSettings(
+        const list& centralBodies, const AccelerationMap& accelerationMap, const list& bodiesToPropagate,
+        const object& initialStates, const std::shared_ptr< PropagationTerminationSettings > terminationSettings,
+        const TranslationalPropagatorType propagator, const object& dependentVariablesToSave )
+{
+    const std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables =
+            extractList< std::shared_ptr< SingleDependentVariableSaveSettings > >( dependentVariablesToSave );
+    std::shared_ptr< DependentVariableSaveSettings > dependentVariableSettings;
+    if( !dependentVariables.empty( ) )
+    {
+        dependentVariableSettings = std::make_shared< DependentVariableSaveSettings >( dependentVariables, false );
+    }
+    return std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                extractList< std::string >( centralBodies ), accelerationMap,
+                extractList< std::string >( bodiesToPropagate ), extractVector( initialStates ),
+                terminationSettings, propagator, dependentVariableSettings );
+}
+
+} // namespace
+
+void exposePropagationSetup( )
+{
+    enum_< AvailableIntegrators >( "AvailableIntegrators" )
+            .value( "euler", euler )
+            .value( "runge_kutta_4", rungeKutta4 )
+            .value( "runge_kutta_variable_step_size", rungeKuttaVariableStepSize )
+            ;
+
+    enum_< RungeKuttaCoefficients::CoefficientSets >( "RungeKuttaCoefficientSets" )
+            .value( "runge_kutta_fehlberg_45", RungeKuttaCoefficients::rungeKuttaFehlberg45 )
+            .value( "runge_kutta_fehlberg_56", RungeKuttaCoefficients::rungeKuttaFehlberg56 )
+            .value( "runge_kutta_fehlberg_78", RungeKuttaCoefficients::rungeKuttaFehlberg78 )
+            .value( "runge_kutta_87_dormand_prince", RungeKuttaCoefficients::rungeKutta87DormandPrince )
+            ;
+
+    class_< IntegratorSettings< double >, std::shared_ptr< IntegratorSettings< double > > >(
+                "IntegratorSettings",
+                init< AvailableIntegrators, double, double >(
+                    ( arg( "integrator_type" ), arg( "initial_time" ), arg( "initial_time_step" ) ) ) )
+            .def_readonly( "initial_time", &IntegratorSettings< double >::initialTime_ )
+            .def_readonly( "initial_time_step", &IntegratorSettings< double >::initialTimeStep_ )
+            ;
+
+    class_< RungeKuttaVariableStepSizeSettings< double >,
+            std::shared_ptr< RungeKuttaVariableStepSizeSettings< double > >,
+            bases< IntegratorSettings< double > > >(
+                "RungeKuttaVariableStepSizeSettings",
+                init< double, double, RungeKuttaCoefficients::CoefficientSets, double, double, double, double >(
+                    ( arg( "initial_time" ), arg( "initial_time_step" ), arg( "coefficient_set" ),
+                      arg( "minimum_step_size" ), arg( "maximum_step_size" ),
+                      arg( "relative_error_tolerance" ), arg( "absolute_error_tolerance" ) ) ) )
+            ;
+
+    class_< PropagationTerminationSettings, std::shared_ptr< PropagationTerminationSettings >,
+            boost::noncopyable >( "PropagationTerminationSettings", no_init )
+            ;
+
+    class_< PropagationTimeTerminationSettings, std::shared_ptr< PropagationTimeTerminationSettings >,
+            bases< PropagationTerminationSettings > >(
+                "PropagationTimeTerminationSettings",
+                init< double, optional< bool > >(
+                    ( arg( "termination_time" ), arg( "terminate_exactly_on_final_condition" ) ) ) )
+            .def_readonly( "termination_time", &PropagationTimeTerminationSettings::terminationTime_ )
+            ;
+
+    enum_< AvailableAcceleration >( "AvailableAcceleration" )
+            .value( "point_mass_gravity", central_gravity )
+            .value( "spherical_harmonic_gravity", spherical_harmonic_gravity )
+            .value( "aerodynamic", aerodynamic )
+            .value( "cannon_ball_radiation_pressure", cannon_ball_radiation_pressure )
+            ;
+
+    class_< AccelerationSettings, std::shared_ptr< AccelerationSettings > >(
+                "AccelerationSettings", init< AvailableAcceleration >( arg( "acceleration_type" ) ) )
+            ;
+
+    class_< SphericalHarmonicAccelerationSettings, std::shared_ptr< SphericalHarmonicAccelerationSettings >,
+            bases< AccelerationSettings > >(
+                "SphericalHarmonicAccelerationSettings",
+                init< int, int >( ( arg( "maximum_degree" ), arg( "maximum_order" ) ) ) )
+            ;
+
+    class_< AccelerationMap >( "AccelerationMap" )
+            ;
+
+    def( "create_acceleration_models", &createAccelerationModels,
+         ( arg( "body_map" ), arg( "selected_acceleration_per_body" ), arg( "bodies_to_propagate" ),
+           arg( "central_bodies" ) ) );
+
+    enum_< TranslationalPropagatorType >( "TranslationalPropagatorType" )
+            .value( "cowell", cowell )
+            .value( "encke", encke )
+            .value( "gauss_keplerian", gauss_keplerian )
+            .value( "gauss_modified_equinoctial", gauss_modified_equinoctial )
+            ;
+
+    enum_< PropagationDependentVariables >( "PropagationDependentVariables" )
+            .value( "mach_number", mach_number_dependent_variable )
+            .value( "altitude", altitude_dependent_variable )
+            .value( "airspeed", airspeed_dependent_variable )
+            .value( "local_density", local_density_dependent_variable )
+            .value( "relative_speed", relative_speed_dependent_variable )
+            .value( "relative_position", relative_position_dependent_variable )
+            .value( "relative_distance", relative_distance_dependent_variable )
+            .value( "relative_velocity", relative_velocity_dependent_variable )
+            .value( "total_acceleration_norm", total_acceleration_norm_dependent_variable )
+            .value( "total_acceleration", total_acceleration_dependent_variable )
+            .value( "keplerian_state", keplerian_state_dependent_variable )
+            ;
+
+    class_< SingleDependentVariableSaveSettings, std::shared_ptr< SingleDependentVariableSaveSettings > >(
+                "SingleDependentVariableSaveSettings",
+                "Dependent variable of associated_body (with respect to secondary_body, for relative variables).",
+                init< PropagationDependentVariables, std::string, optional< std::string > >(
+                    ( arg( "variable_type" ), arg( "associated_body" ), arg( "secondary_body" ) = "" ) ) )
+            ;
+
+    class_< PropagatorSettings< double >, std::shared_ptr< PropagatorSettings< double > >, boost::noncopyable >(
+                "PropagatorSettings", no_init )
+            ;
+
+    class_< SingleArcPropagatorSettings< double >, std::shared_ptr< SingleArcPropagatorSettings< double > >,
+            bases< PropagatorSettings< double > >, boost::noncopyable >( "SingleArcPropagatorSettings", no_init )
+            ;
+
+    class_< TranslationalStatePropagatorSettings< double >,
+            std::shared_ptr< TranslationalStatePropagatorSettings< double > >,
+            bases< SingleArcPropagatorSettings< double > >, boost::noncopyable >(
+                "TranslationalStatePropagatorSettings", no_init )
+            .def( "__init__", make_constructor(
+                      &createTranslationalStatePropagatorSettings, default_call_policies( ),
+                      ( arg( "central_bodies" ), arg( "acceleration_models" ), arg( "bodies_to_propagate" ),
+                        arg( "initial_states" ), arg( "termination_settings" ), arg( "propagator" ) = cowell,
+                        arg( "dependent_variables_to_save" ) = list( ) ) ),
+                  "Settings of a translational propagation, saving the dependent variables in\n"
+                  "dependent_variables_to_save (a list of SingleDependentVariableSaveSettings), in that order." )
+            ;
+}
+
+} // namespace tudatpy
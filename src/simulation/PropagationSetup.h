@@ -0,0 +1,47 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PROPAGATION_SETUP_H
+#define TUDATPY_PROPAGATION_SETUP_H
+
+#include <boost/python.hpp>
+
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+#include "Tudat/SimulationSetup/PropagationSetup/accelerationSettings.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationTerminationSettings.h"
+
+namespace tudatpy
+{
+
+//! Convert a nested Python dict {body undergoing: {body exerting: [AccelerationSettings]}} to its Tudat equivalent.
+tudat::simulation_setup::SelectedAccelerationMap extractSelectedAccelerationMap(
+        const boost::python::dict& selectedAccelerations );
+
+//! Copy integrator settings, for propagations that must not share them (Tudat simulators may modify them).
+/*!
+ *  \param integratorSettings Settings to copy, of the Euler, RK4 or variable step Runge-Kutta integrator.
+ *  \return Copy of the settings.
+ *  \throws std::runtime_error For other types of integrator settings.
+ */
+std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > copyIntegratorSettings(
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings );
+
+//! Copy termination settings, for propagations that must not share them.
+/*!
+ *  \param terminationSettings Settings to copy, which must be time termination settings.
+ *  \return Copy of the settings.
+ *  \throws std::runtime_error For other types of termination settings.
+ */
+std::shared_ptr< tudat::propagators::PropagationTerminationSettings > copyTerminationSettings(
+        const std::shared_ptr< tudat::propagators::PropagationTerminationSettings > terminationSettings );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_PROPAGATION_SETUP_H
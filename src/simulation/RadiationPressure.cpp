@@ -0,0 +1,290 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/missionGeometry.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+
+#include "Conversions.h"
+#include "Parallel.h"
+#include "RadiationPressure.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::electromagnetism;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Number of positions evaluated by a worker thread per task.
+const std::size_t pointsPerTask = 4096;
+
+} // namespace
+
+bool isOutsidePenumbraCone( const Eigen::Vector3d& sourcePosition, const double sourceRadius,
+                            const Eigen::Vector3d& occultingBodyPosition, const double occultingBodyRadius,
+                            const Eigen::Vector3d& position )
+{
+    if( !( occultingBodyRadius > 0.0 ) )
+    {
+        return true;
+    }
+
+    const Eigen::Vector3d sourceToOccultingBody = occultingBodyPosition - sourcePosition;
+    const double sourceDistance = sourceToOccultingBody.norm( );
+    const double radiusSum = sourceRadius + occultingBodyRadius;
+    if( radiusSum >= sourceDistance )
+    {
+        return false;
+    }
+
+    // Distance from the apex of the cone along its axis (pointing away from the source), and to the axis.
+    const Eigen::Vector3d axis = sourceToOccultingBody / sourceDistance;
+    const Eigen::Vector3d relativePosition = position - occultingBodyPosition;
+    const double relativeDistanceAlongAxis = relativePosition.dot( axis );
+    const double distanceAlongAxis = relativeDistanceAlongAxis + sourceDistance * occultingBodyRadius / radiusSum;
+    if( distanceAlongAxis <= 0.0 )
+    {
+        return true;
+    }
+    const double distanceToAxisSquared =
+            relativePosition.squaredNorm( ) - relativeDistanceAlongAxis * relativeDistanceAlongAxis;
+
+    // Compare the angle from the axis, seen from the apex, with the half-angle of the cone.
+    const double sineHalfAngleSquared = ( radiusSum / sourceDistance ) * ( radiusSum / sourceDistance );
+    return distanceToAxisSquared * ( 1.0 - sineHalfAngleSquared ) >
+            distanceAlongAxis * distanceAlongAxis * sineHalfAngleSquared;
+}
+
+double computeConicalShadowFunction( const Eigen::Vector3d& sourcePosition, const double sourceRadius,
+                                     const Eigen::Vector3d& occultingBodyPosition, const double occultingBodyRadius,
+                                     const Eigen::Vector3d& position )
+{
+    if( isOutsidePenumbraCone( sourcePosition, sourceRadius, occultingBodyPosition, occultingBodyRadius, position ) )
+    {
+        return 1.0;
+    }
+    return tudat::mission_geometry::computeShadowFunction(
+                sourcePosition, sourceRadius, occultingBodyPosition, occultingBodyRadius, position );
+}
+
+CachedShadowRadiationPressureInterface::CachedShadowRadiationPressureInterface(
+        const std::shared_ptr< RadiationPressureInterface > radiationPressureInterface ):
+    RadiationPressureInterface( radiationPressureInterface->getSourcePowerFunction( ),
+                                radiationPressureInterface->getSourcePositionFunction( ),
+                                radiationPressureInterface->getTargetPositionFunction( ),
+                                radiationPressureInterface->getRadiationPressureCoefficient( ),
+                                radiationPressureInterface->getArea( ) ),
+    shadowingBodyPositionFunctions_( radiationPressureInterface->getOccultingBodyPositions( ) ),
+    shadowingBodyRadii_( radiationPressureInterface->getOccultingBodyRadii( ) ),
+    sourceBodyRadius_( radiationPressureInterface->getSourceRadius( ) ),
+    currentShadowFunction_( 1.0 ),
+    shadowFunctionTime_( TUDAT_NAN ),
+    shadowFunctionTargetPosition_( Eigen::Vector3d::Constant( TUDAT_NAN ) )
+{ }
+
+void CachedShadowRadiationPressureInterface::updateInterface( const double currentTime )
+{
+    // The Tudat interface has no occulting bodies, and computes the unshadowed radiation pressure.
+    RadiationPressureInterface::updateInterface( currentTime );
+
+    const Eigen::Vector3d targetPosition = getCurrentTargetPosition( );
+    if( !( currentTime == shadowFunctionTime_ && targetPosition == shadowFunctionTargetPosition_ ) )
+    {
+        const Eigen::Vector3d sourcePosition = getCurrentSourcePosition( );
+        currentShadowFunction_ = 1.0;
+        for( unsigned int i = 0; i < shadowingBodyPositionFunctions_.size( ); i++ )
+        {
+            currentShadowFunction_ *= computeConicalShadowFunction(
+                        sourcePosition, sourceBodyRadius_, shadowingBodyPositionFunctions_[ i ]( ),
+                        shadowingBodyRadii_[ i ], targetPosition );
+        }
+        shadowFunctionTime_ = currentTime;
+        shadowFunctionTargetPosition_ = targetPosition;
+    }
+    currentRadiationPressure_ *= currentShadowFunction_;
+}
+
+void computeShadowFunctions( const std::size_t numberOfPoints, const double* positions, const double* sourcePositions,
+                             const double sourceRadius, const std::vector< const double* >& occultingBodyPositions,
+                             const std::vector< double >& occultingBodyRadii, double* shadowFunctions,
+                             const unsigned int numberOfThreads, const bool isPenumbraConePrechecked )
+{
+    const auto shadowFunctionModel = isPenumbraConePrechecked ?
+                &computeConicalShadowFunction : &tudat::mission_geometry::computeShadowFunction;
+    const std::size_t numberOfTasks = ( numberOfPoints + pointsPerTask - 1 ) / pointsPerTask;
+    parallelFor( numberOfTasks, getNumberOfThreads( numberOfThreads, numberOfTasks ),
+                 [ & ]( const std::size_t taskIndex, const unsigned int )
+    {
+        const std::size_t lastPoint = std::min( numberOfPoints, ( taskIndex + 1 ) * pointsPerTask );
+        for( std::size_t i = taskIndex * pointsPerTask; i < lastPoint; i++ )
+        {
+            const Eigen::Map< const Eigen::Vector3d > position( positions + 3 * i );
+            const Eigen::Map< const Eigen::Vector3d > sourcePosition( sourcePositions + 3 * i );
+            double shadowFunction = 1.0;
+            for( unsigned int j = 0; j < occultingBodyPositions.size( ); j++ )
+            {
+                shadowFunction *= shadowFunctionModel(
+                            sourcePosition, sourceRadius,
+                            Eigen::Map< const Eigen::Vector3d >( occultingBodyPositions[ j ] + 3 * i ),
+                            occultingBodyRadii[ j ], position );
+            }
+            shadowFunctions[ i ] = shadowFunction;
+        }
+    } );
+}
+
+namespace
+{
+
+//! Radius of a body, as used for the shadow function.
+double getShadowRadius( const NamedBodyMap& bodyMap, const std::string& bodyName )
+{
+    if( bodyMap.count( bodyName ) == 0 )
+    {
+        throw std::runtime_error( "Error when computing shadow functions, body " + bodyName + " does not exist" );
+    }
+    if( bodyMap.at( bodyName )->getShapeModel( ) == nullptr )
+    {
+        throw std::runtime_error( "Error when computing shadow functions, body " + bodyName + " has no shape model" );
+    }
+    return bodyMap.at( bodyName )->getShapeModel( )->getAverageRadius( );
+}
+
+numpy::ndarray getShadowFunctions( const NamedBodyMap& bodyMap, const object& epochs, const object& positions,
+                                   const std::string& centralBody, const object& occultingBodies,
+                                   const std::string& sourceBody, const unsigned int numberOfThreads,
+                                   const bool usePenumbraConePrecheck )
+{
+    const ContiguousArray epochArray( epochs );
+    const ContiguousArray positionArray( positions, 2 );
+    if( positionArray.columns( ) != 3 || positionArray.rows( ) != epochArray.size( ) )
+    {
+        throw std::runtime_error( "Error when computing shadow functions, positions must be an (N x 3) array at the "
+                                  "N epochs" );
+    }
+    const std::size_t numberOfPoints = epochArray.size( );
+
+    const std::vector< std::string > occultingBodyNames = extractList< std::string >( occultingBodies );
+    const double sourceRadius = getShadowRadius( bodyMap, sourceBody );
+    std::vector< double > occultingBodyRadii;
+    for( unsigned int j = 0; j < occultingBodyNames.size( ); j++ )
+    {
+        occultingBodyRadii.push_back( getShadowRadius( bodyMap, occultingBodyNames[ j ] ) );
+    }
+    if( bodyMap.count( centralBody ) == 0 )
+    {
+        throw std::runtime_error( "Error when computing shadow functions, body " + centralBody + " does not exist" );
+    }
+
+    // The ephemerides are evaluated serially (they may call SPICE), relative to the central body of the positions.
+    std::vector< double > sourcePositions( 3 * numberOfPoints );
+    std::vector< std::vector< double > > occultingBodyPositionBlocks(
+                occultingBodyNames.size( ), std::vector< double >( 3 * numberOfPoints ) );
+    for( std::size_t i = 0; i < numberOfPoints; i++ )
+    {
+        const double epoch = epochArray.data( )[ i ];
+        const Eigen::Vector3d centralBodyPosition =
+                bodyMap.at( centralBody )->getStateInBaseFrameFromEphemeris< double, double >( epoch ).head( 3 );
+        Eigen::Map< Eigen::Vector3d >( sourcePositions.data( ) + 3 * i ) =
+                bodyMap.at( sourceBody )->getStateInBaseFrameFromEphemeris< double, double >( epoch ).head( 3 ) -
+                centralBodyPosition;
+        for( unsigned int j = 0; j < occultingBodyNames.size( ); j++ )
+        {
+            Eigen::Map< Eigen::Vector3d >( occultingBodyPositionBlocks[ j ].data( ) + 3 * i ) =
+                    bodyMap.at( occultingBodyNames[ j ] )->getStateInBaseFrameFromEphemeris< double, double >(
+                        epoch ).head( 3 ) - centralBodyPosition;
+        }
+    }
+    std::vector< const double* > occultingBodyPositions;
+    for( unsigned int j = 0; j < occultingBodyNames.size( ); j++ )
+    {
+        occultingBodyPositions.push_back( occultingBodyPositionBlocks[ j ].data( ) );
+    }
+
+    numpy::ndarray shadowFunctions = createArray( numberOfPoints );
+    double* shadowFunctionData = getArrayData( shadowFunctions );
+    {
+        ScopedGilRelease gilRelease;
+        computeShadowFunctions( numberOfPoints, positionArray.data( ), sourcePositions.data( ), sourceRadius,
+                                occultingBodyPositions, occultingBodyRadii, shadowFunctionData, numberOfThreads,
+                                usePenumbraConePrecheck );
+    }
+    return shadowFunctions;
+}
+
+void setCachedShadowFunctions( const NamedBodyMap& bodyMap, const std::string& bodyName )
+{
+    if( bodyMap.count( bodyName ) == 0 )
+    {
+        throw std::runtime_error( "Error when setting radiation pressure interfaces, body " + bodyName +
+                                  " does not exist" );
+    }
+    const std::shared_ptr< Body > body = bodyMap.at( bodyName );
+    const auto radiationPressureInterfaces = body->getRadiationPressureInterfaces( );
+    for( auto interfaceIterator = radiationPressureInterfaces.begin( );
+         interfaceIterator != radiationPressureInterfaces.end( ); interfaceIterator++ )
+    {
+        if( std::dynamic_pointer_cast< CachedShadowRadiationPressureInterface >( interfaceIterator->second ) ==
+                nullptr )
+        {
+            body->setRadiationPressureInterface(
+                        interfaceIterator->first,
+                        std::make_shared< CachedShadowRadiationPressureInterface >( interfaceIterator->second ) );
+        }
+    }
+}
+
+} // namespace
+
+void exposeRadiationPressure( )
+{
+    class_< RadiationPressureInterface, std::shared_ptr< RadiationPressureInterface >, boost::noncopyable >(
+                "RadiationPressureInterface", no_init )
+            .add_property( "current_radiation_pressure", &RadiationPressureInterface::getCurrentRadiationPressure )
+            .add_property( "area", &RadiationPressureInterface::getArea )
+            .add_property( "radiation_pressure_coefficient",
+                           &RadiationPressureInterface::getRadiationPressureCoefficient )
+            ;
+
+    class_< CachedShadowRadiationPressureInterface, std::shared_ptr< CachedShadowRadiationPressureInterface >,
+            bases< RadiationPressureInterface >, boost::noncopyable >(
+                "CachedShadowRadiationPressureInterface", no_init )
+            .add_property( "current_shadow_function",
+                           &CachedShadowRadiationPressureInterface::getCurrentShadowFunction )
+            ;
+
+    def( "set_cached_shadow_functions", &setCachedShadowFunctions, ( arg( "body_map" ), arg( "body_name" ) ),
+         "Replace the radiation pressure interfaces of a body by ones that skip the conical shadow computation\n"
+         "outside the penumbra cone of the occulting bodies, which is where their speedup comes from. The shadow\n"
+         "function is also cached per epoch and position, which only saves its recomputation when the interface\n"
+         "is updated more than once at the same integrator stage. Acceleration models keep the interface they\n"
+         "were created with, so this should be called before creating them." );
+
+    def( "compute_shadow_functions", &getShadowFunctions,
+         ( arg( "body_map" ), arg( "epochs" ), arg( "positions" ), arg( "central_body" ), arg( "occulting_bodies" ),
+           arg( "source_body" ) = "Sun", arg( "number_of_threads" ) = 0, arg( "use_penumbra_cone_precheck" ) = true ),
+         "Shadow functions (visible fraction of the source disc, the product over all occulting bodies) at an\n"
+         "(N x 3) array of positions relative to central_body, at N epochs. The source and occulting bodies are\n"
+         "spheres with the average radius of their shape models. The ephemerides are evaluated serially; the\n"
+         "geometry is evaluated natively on number_of_threads threads (0 for all hardware threads) with the GIL\n"
+         "released. With use_penumbra_cone_precheck=False, Tudat's conical shadow function is evaluated at every\n"
+         "position instead of only inside the penumbra cones (which gives the same values, more slowly)." );
+}
+
+} // namespace tudatpy
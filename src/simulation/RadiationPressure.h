@@ -0,0 +1,122 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_RADIATION_PRESSURE_H
+#define TUDATPY_RADIATION_PRESSURE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Tudat/Astrodynamics/ElectroMagnetism/radiationPressureInterface.h"
+
+namespace tudatpy
+{
+
+//! Determine whether a position lies outside the penumbra cone of an occulting body, so that it is fully illuminated.
+/*!
+ *  The penumbra cone is tangent to both the source and the occulting body, with its apex in between them. Outside of
+ *  it, the discs of the source and the occulting body do not overlap as seen from the position. The test uses a few
+ *  dot products, and no trigonometric functions.
+ */
+bool isOutsidePenumbraCone( const Eigen::Vector3d& sourcePosition, const double sourceRadius,
+                            const Eigen::Vector3d& occultingBodyPosition, const double occultingBodyRadius,
+                            const Eigen::Vector3d& position );
+
+//! Compute the conical shadow function (fraction of the source disc that is visible) at a position.
+/*!
+ *  Positions outside the penumbra cone are fully illuminated; for others, the conical shadow model of Tudat is
+ *  evaluated.
+ *  \param sourcePosition Position of the source of radiation.
+ *  \param sourceRadius Radius of the source.
+ *  \param occultingBodyPosition Position of the occulting body.
+ *  \param occultingBodyRadius Radius of the occulting body.
+ *  \param position Position at which the shadow function is computed.
+ *  \return Shadow function, between 0 (umbra) and 1 (full illumination).
+ */
+double computeConicalShadowFunction( const Eigen::Vector3d& sourcePosition, const double sourceRadius,
+                                     const Eigen::Vector3d& occultingBodyPosition, const double occultingBodyRadius,
+                                     const Eigen::Vector3d& position );
+
+//! Radiation pressure interface evaluating its shadow function with the penumbra cone precheck, and caching it.
+/*!
+ *  The interface is created from an existing one, with the same source, target, area and coefficient. The Tudat
+ *  interface computes the unshadowed radiation pressure, which is then scaled by the shadow function. Its speedup
+ *  over the Tudat interface comes from the precheck (see computeConicalShadowFunction), which skips the trigonometry
+ *  of the conical model outside the penumbra cone. The shadow function (and the positions of the occulting bodies it
+ *  requires) is also only recomputed when the epoch or the target position differ from the previous update; as every
+ *  integrator stage has its own epoch and state, this only saves the recomputation when the interface is updated more
+ *  than once at the same stage. Unlike the Tudat interface, several occulting bodies are supported, in which case the
+ *  product of their shadow functions is used.
+ */
+class CachedShadowRadiationPressureInterface: public tudat::electromagnetism::RadiationPressureInterface
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param radiationPressureInterface Interface of which the settings are copied.
+     */
+    CachedShadowRadiationPressureInterface(
+            const std::shared_ptr< tudat::electromagnetism::RadiationPressureInterface > radiationPressureInterface );
+
+    void updateInterface( const double currentTime = TUDAT_NAN );
+
+    //! Shadow function at the last update.
+    double getCurrentShadowFunction( ) const
+    {
+        return currentShadowFunction_;
+    }
+
+private:
+
+    //! Functions returning the positions of the occulting bodies.
+    std::vector< std::function< Eigen::Vector3d( ) > > shadowingBodyPositionFunctions_;
+
+    //! Radii of the occulting bodies.
+    std::vector< double > shadowingBodyRadii_;
+
+    //! Radius of the source of radiation.
+    double sourceBodyRadius_;
+
+    //! Shadow function at the last update.
+    double currentShadowFunction_;
+
+    //! Epoch at which currentShadowFunction_ was computed.
+    double shadowFunctionTime_;
+
+    //! Target position at which currentShadowFunction_ was computed.
+    Eigen::Vector3d shadowFunctionTargetPosition_;
+};
+
+//! Compute the shadow functions at a series of positions.
+/*!
+ *  The positions are split into blocks that are distributed over the worker threads. Does not touch any Python object,
+ *  so that it may be called with the GIL released.
+ *  \param numberOfPoints Number of positions.
+ *  \param positions Row-major (numberOfPoints x 3) block of positions.
+ *  \param sourcePositions Row-major (numberOfPoints x 3) block of positions of the source at the same epochs.
+ *  \param sourceRadius Radius of the source.
+ *  \param occultingBodyPositions Row-major (numberOfPoints x 3) blocks of positions of each occulting body.
+ *  \param occultingBodyRadii Radii of the occulting bodies.
+ *  \param shadowFunctions Block to which the products of the shadow functions of all occulting bodies are written.
+ *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+ *  \param isPenumbraConePrechecked Whether the shadow functions are computed by computeConicalShadowFunction, or by
+ *  the conical shadow model of Tudat at every position (against which the precheck is validated).
+ */
+void computeShadowFunctions( const std::size_t numberOfPoints, const double* positions, const double* sourcePositions,
+                             const double sourceRadius, const std::vector< const double* >& occultingBodyPositions,
+                             const std::vector< double >& occultingBodyRadii, double* shadowFunctions,
+                             const unsigned int numberOfThreads, const bool isPenumbraConePrechecked = true );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_RADIATION_PRESSURE_H
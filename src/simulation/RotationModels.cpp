@@ -0,0 +1,349 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/python.hpp>
+
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createRotationModel.h"
+
+#include "Conversions.h"
+#include "FrozenBodyMap.h"
+#include "Parallel.h"
+#include "RotationModels.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::ephemerides;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Number of points rotated by a worker thread per task.
+const std::size_t pointsPerTask = 4096;
+
+//! Angular velocity of a rotating frame, expressed in the base frame, from its rotation matrix and its derivative.
+Eigen::Vector3d getAngularVelocity( const Eigen::Matrix3d& rotationToBaseFrame,
+                                    const Eigen::Matrix3d& rotationDerivative )
+{
+    const Eigen::Matrix3d crossProductMatrix = rotationDerivative * rotationToBaseFrame.transpose( );
+    return Eigen::Vector3d( crossProductMatrix( 2, 1 ), crossProductMatrix( 0, 2 ), crossProductMatrix( 1, 0 ) );
+}
+
+//! Skew-symmetric matrix of the cross product with a vector.
+Eigen::Matrix3d getCrossProductMatrix( const Eigen::Vector3d& vector )
+{
+    Eigen::Matrix3d crossProductMatrix;
+    crossProductMatrix << 0.0, -vector.z( ), vector.y( ),
+            vector.z( ), 0.0, -vector.x( ),
+            -vector.y( ), vector.x( ), 0.0;
+    return crossProductMatrix;
+}
+
+} // namespace
+
+TabulatedRotationalEphemeris::TabulatedRotationalEphemeris(
+        const std::shared_ptr< RotationalEphemeris > rotationModel, const double initialTime, const double finalTime,
+        const double timeStep ):
+    RotationalEphemeris( rotationModel->getBaseFrameOrientation( ), rotationModel->getTargetFrameOrientation( ) ),
+    rotationModel_( rotationModel ), initialTime_( initialTime ), timeStep_( timeStep )
+{
+    if( !( timeStep > 0.0 ) || !( finalTime > initialTime ) )
+    {
+        throw std::runtime_error( "Error when tabulating rotation model, time step and interval must be positive" );
+    }
+
+    // The last grid point is the final epoch, so that the original model is not evaluated beyond it.
+    std::size_t numberOfIntervals = static_cast< std::size_t >( std::ceil( ( finalTime - initialTime ) / timeStep ) );
+    if( numberOfIntervals > 1 && !( initialTime + ( numberOfIntervals - 1 ) * timeStep < finalTime ) )
+    {
+        numberOfIntervals--;
+    }
+    finalTime_ = finalTime;
+    quaternions_.resize( 4, numberOfIntervals + 1 );
+    quaternionRates_.resize( 4, numberOfIntervals + 1 );
+    angularVelocities_.resize( 3, numberOfIntervals + 1 );
+    for( std::size_t i = 0; i <= numberOfIntervals; i++ )
+    {
+        const double time = i < numberOfIntervals ? initialTime_ + i * timeStep_ : finalTime_;
+        Eigen::Quaterniond rotation = rotationModel_->getRotationToBaseFrame( time );
+        if( i > 0 && rotation.coeffs( ).dot( quaternions_.col( i - 1 ) ) < 0.0 )
+        {
+            rotation.coeffs( ) *= -1.0;
+        }
+        const Eigen::Vector3d angularVelocity = getAngularVelocity(
+                    rotation.toRotationMatrix( ), rotationModel_->getDerivativeOfRotationToBaseFrame( time ) );
+
+        // For a rotation q to the base frame, dq/dt = 0.5 * ( 0, omega ) * q, with omega in the base frame.
+        const Eigen::Quaterniond quaternionRate =
+                Eigen::Quaterniond( 0.0, 0.5 * angularVelocity.x( ), 0.5 * angularVelocity.y( ),
+                                    0.5 * angularVelocity.z( ) ) * rotation;
+
+        quaternions_.col( i ) = rotation.coeffs( );
+        quaternionRates_.col( i ) = quaternionRate.coeffs( );
+        angularVelocities_.col( i ) = angularVelocity;
+    }
+}
+
+std::size_t TabulatedRotationalEphemeris::getInterval( const double secondsSinceEpoch, double& fraction,
+                                                       double& intervalLength ) const
+{
+    const std::size_t lastInterval = static_cast< std::size_t >( quaternions_.cols( ) - 2 );
+    const std::size_t interval = std::min(
+                static_cast< std::size_t >( ( secondsSinceEpoch - initialTime_ ) / timeStep_ ), lastInterval );
+    const double intervalStart = initialTime_ + interval * timeStep_;
+    intervalLength = interval < lastInterval ? timeStep_ : finalTime_ - intervalStart;
+    fraction = ( secondsSinceEpoch - intervalStart ) / intervalLength;
+    return interval;
+}
+
+Eigen::Quaterniond TabulatedRotationalEphemeris::interpolateRotationToBaseFrame( const double secondsSinceEpoch ) const
+{
+    double fraction, intervalLength;
+    const std::size_t i = getInterval( secondsSinceEpoch, fraction, intervalLength );
+
+    const double fractionSquared = fraction * fraction;
+    const double fractionCubed = fractionSquared * fraction;
+    const Eigen::Vector4d coefficients =
+            ( 2.0 * fractionCubed - 3.0 * fractionSquared + 1.0 ) * quaternions_.col( i ) +
+            ( fractionCubed - 2.0 * fractionSquared + fraction ) * intervalLength * quaternionRates_.col( i ) +
+            ( -2.0 * fractionCubed + 3.0 * fractionSquared ) * quaternions_.col( i + 1 ) +
+            ( fractionCubed - fractionSquared ) * intervalLength * quaternionRates_.col( i + 1 );
+    return Eigen::Quaterniond( coefficients.normalized( ) );
+}
+
+Eigen::Quaterniond TabulatedRotationalEphemeris::getRotationToBaseFrame( const double secondsSinceEpoch )
+{
+    return isTabulated( secondsSinceEpoch ) ? interpolateRotationToBaseFrame( secondsSinceEpoch ) :
+                                              rotationModel_->getRotationToBaseFrame( secondsSinceEpoch );
+}
+
+Eigen::Matrix3d TabulatedRotationalEphemeris::getDerivativeOfRotationToBaseFrame( const double secondsSinceEpoch )
+{
+    if( !isTabulated( secondsSinceEpoch ) )
+    {
+        return rotationModel_->getDerivativeOfRotationToBaseFrame( secondsSinceEpoch );
+    }
+
+    double fraction, intervalLength;
+    const std::size_t i = getInterval( secondsSinceEpoch, fraction, intervalLength );
+    const Eigen::Vector3d angularVelocity =
+            ( 1.0 - fraction ) * angularVelocities_.col( i ) + fraction * angularVelocities_.col( i + 1 );
+    return getCrossProductMatrix( angularVelocity ) *
+            interpolateRotationToBaseFrame( secondsSinceEpoch ).toRotationMatrix( );
+}
+
+const TabulatedRotationalEphemeris* getTabulatedRotationModel( const RotationalEphemeris& rotationModel,
+                                                               const std::size_t numberOfPoints, const double* epochs )
+{
+    const TabulatedRotationalEphemeris* tabulatedRotationModel =
+            dynamic_cast< const TabulatedRotationalEphemeris* >( &rotationModel );
+    const bool isTabulated = tabulatedRotationModel != nullptr &&
+            std::all_of( epochs, epochs + numberOfPoints, [ & ]( const double epoch )
+    {
+        return tabulatedRotationModel->isTabulated( epoch );
+    } );
+    return isTabulated ? tabulatedRotationModel : nullptr;
+}
+
+void rotatePositions( RotationalEphemeris& rotationModel, const std::size_t numberOfPoints, const double* epochs,
+                      const double* positions, double* rotatedPositions, const bool isToTargetFrame,
+                      const unsigned int numberOfThreads )
+{
+    const TabulatedRotationalEphemeris* tabulatedRotationModel =
+            getTabulatedRotationModel( rotationModel, numberOfPoints, epochs );
+    if( tabulatedRotationModel != nullptr )
+    {
+        const std::size_t numberOfTasks = ( numberOfPoints + pointsPerTask - 1 ) / pointsPerTask;
+        parallelFor( numberOfTasks, getNumberOfThreads( numberOfThreads, numberOfTasks ),
+                     [ & ]( const std::size_t taskIndex, const unsigned int )
+        {
+            const std::size_t lastPoint = std::min( numberOfPoints, ( taskIndex + 1 ) * pointsPerTask );
+            for( std::size_t i = taskIndex * pointsPerTask; i < lastPoint; i++ )
+            {
+                const Eigen::Quaterniond rotation =
+                        tabulatedRotationModel->interpolateRotationToBaseFrame( epochs[ i ] );
+                Eigen::Map< Eigen::Vector3d >( rotatedPositions + 3 * i ) =
+                        ( isToTargetFrame ? rotation.inverse( ) : rotation ) *
+                        Eigen::Map< const Eigen::Vector3d >( positions + 3 * i );
+            }
+        } );
+    }
+    else
+    {
+        for( std::size_t i = 0; i < numberOfPoints; i++ )
+        {
+            Eigen::Map< Eigen::Vector3d >( rotatedPositions + 3 * i ) =
+                    ( isToTargetFrame ? rotationModel.getRotationToTargetFrame( epochs[ i ] ) :
+                                        rotationModel.getRotationToBaseFrame( epochs[ i ] ) ) *
+                    Eigen::Map< const Eigen::Vector3d >( positions + 3 * i );
+        }
+    }
+}
+
+namespace
+{
+
+object rotatePositionsFromPython( const std::shared_ptr< RotationalEphemeris > rotationModel, const object& epochs,
+                                  const object& positions, const bool isToTargetFrame,
+                                  const unsigned int numberOfThreads )
+{
+    const ContiguousArray positionArray( positions, 2 );
+    const ContiguousArray epochArray( epochs );
+    if( positionArray.columns( ) != 3 || positionArray.rows( ) != epochArray.size( ) )
+    {
+        throw std::runtime_error( "Error when rotating positions, positions must be an (N x 3) array at the N epochs" );
+    }
+
+    numpy::ndarray rotatedPositions = createArray( positionArray.rows( ), 3 );
+    double* rotatedPositionData = getArrayData( rotatedPositions );
+    {
+        // SPICE is not thread-safe, so the GIL is held if the original model may call it.
+        const bool isSpiceUsed =
+                getTabulatedRotationModel( *rotationModel, epochArray.size( ), epochArray.data( ) ) == nullptr &&
+                usesSpice( rotationModel );
+        ScopedGilRelease gilRelease( !isSpiceUsed );
+        rotatePositions( *rotationModel, positionArray.rows( ), epochArray.data( ), positionArray.data( ),
+                         rotatedPositionData, isToTargetFrame, numberOfThreads );
+    }
+    return rotatedPositions;
+}
+
+object inertialToBodyFixed( const std::shared_ptr< RotationalEphemeris > rotationModel, const object& epochs,
+                            const object& positions, const unsigned int numberOfThreads )
+{
+    return rotatePositionsFromPython( rotationModel, epochs, positions, true, numberOfThreads );
+}
+
+object bodyFixedToInertial( const std::shared_ptr< RotationalEphemeris > rotationModel, const object& epochs,
+                            const object& positions, const unsigned int numberOfThreads )
+{
+    return rotatePositionsFromPython( rotationModel, epochs, positions, false, numberOfThreads );
+}
+
+std::shared_ptr< SimpleRotationModelSettings > createSimpleRotationModelSettings(
+        const std::string& originalFrame, const std::string& targetFrame, const object& initialOrientation,
+        const double initialTime, const double rotationRate )
+{
+    const ContiguousArray orientationArray( initialOrientation, 2 );
+    if( orientationArray.rows( ) != 3 || orientationArray.columns( ) != 3 )
+    {
+        throw std::runtime_error( "Error when creating rotation model settings, initial orientation must be a (3 x 3) "
+                                  "rotation matrix" );
+    }
+    typedef Eigen::Matrix< double, 3, 3, Eigen::RowMajor > RowMajorMatrix3d;
+    const Eigen::Matrix3d rotationMatrix = Eigen::Map< const RowMajorMatrix3d >( orientationArray.data( ) );
+    return std::make_shared< SimpleRotationModelSettings >(
+                originalFrame, targetFrame, Eigen::Quaterniond( rotationMatrix ), initialTime, rotationRate );
+}
+
+std::shared_ptr< RotationalEphemeris > createBodyRotationModel(
+        const std::shared_ptr< RotationModelSettings > rotationModelSettings, const std::string& body )
+{
+    return createRotationModel( rotationModelSettings, body );
+}
+
+std::shared_ptr< TabulatedRotationalEphemeris > createTabulatedRotationModel(
+        const std::shared_ptr< RotationalEphemeris > rotationModel, const double initialTime, const double finalTime,
+        const double timeStep )
+{
+    if( rotationModel == nullptr )
+    {
+        throw std::runtime_error( "Error when tabulating rotation model, no rotation model given" );
+    }
+    return std::make_shared< TabulatedRotationalEphemeris >( rotationModel, initialTime, finalTime, timeStep );
+}
+
+void setTabulatedRotationModel( const NamedBodyMap& bodyMap, const std::string& bodyName, const double initialTime,
+                                const double finalTime, const double timeStep )
+{
+    if( bodyMap.count( bodyName ) == 0 )
+    {
+        throw std::runtime_error( "Error when tabulating rotation model, body " + bodyName + " does not exist" );
+    }
+    const std::shared_ptr< Body > body = bodyMap.at( bodyName );
+    std::shared_ptr< RotationalEphemeris > rotationModel = body->getRotationalEphemeris( );
+    if( std::dynamic_pointer_cast< TabulatedRotationalEphemeris >( rotationModel ) != nullptr )
+    {
+        rotationModel = std::dynamic_pointer_cast< TabulatedRotationalEphemeris >(
+                    rotationModel )->getOriginalRotationModel( );
+    }
+    body->setRotationalEphemeris( createTabulatedRotationModel( rotationModel, initialTime, finalTime, timeStep ) );
+}
+
+} // namespace
+
+void exposeRotationModels( )
+{
+    class_< RotationModelSettings, std::shared_ptr< RotationModelSettings >, boost::noncopyable >(
+                "RotationModelSettings", no_init )
+            ;
+
+    class_< SimpleRotationModelSettings, std::shared_ptr< SimpleRotationModelSettings >,
+            bases< RotationModelSettings >, boost::noncopyable >(
+                "SimpleRotationModelSettings",
+                "Rotation at a constant rate about the z-axis of the target frame, of which the orientation at\n"
+                "initial_time is given by initial_orientation, the (3 x 3) rotation matrix from the target to the\n"
+                "original frame.",
+                no_init )
+            .def( "__init__", make_constructor(
+                      &createSimpleRotationModelSettings, default_call_policies( ),
+                      ( arg( "original_frame" ), arg( "target_frame" ), arg( "initial_orientation" ),
+                        arg( "initial_time" ), arg( "rotation_rate" ) ) ) )
+            ;
+
+    def( "create_rotation_model", &createBodyRotationModel, ( arg( "rotation_model_settings" ), arg( "body_name" ) ) );
+
+    class_< RotationalEphemeris, std::shared_ptr< RotationalEphemeris >, boost::noncopyable >(
+                "RotationalEphemeris", no_init )
+            .add_property( "base_frame", &RotationalEphemeris::getBaseFrameOrientation )
+            .add_property( "target_frame", &RotationalEphemeris::getTargetFrameOrientation )
+            .def( "inertial_to_body_fixed", &inertialToBodyFixed,
+                  ( arg( "epochs" ), arg( "positions" ), arg( "number_of_threads" ) = 0 ),
+                  "Rotate an (N x 3) array of positions at N epochs from the base to the target (body-fixed) frame.\n"
+                  "Evaluated natively with the GIL released (unless the model may call SPICE, which is not\n"
+                  "thread-safe); for a tabulated model covering all epochs, on number_of_threads threads (0 for all\n"
+                  "hardware threads)." )
+            .def( "body_fixed_to_inertial", &bodyFixedToInertial,
+                  ( arg( "epochs" ), arg( "positions" ), arg( "number_of_threads" ) = 0 ),
+                  "Rotate an (N x 3) array of positions at N epochs from the target (body-fixed) to the base frame\n"
+                  "(see inertial_to_body_fixed)." )
+            ;
+
+    class_< TabulatedRotationalEphemeris, std::shared_ptr< TabulatedRotationalEphemeris >,
+            bases< RotationalEphemeris >, boost::noncopyable >( "TabulatedRotationalEphemeris", no_init )
+            .add_property( "original_rotation_model", &TabulatedRotationalEphemeris::getOriginalRotationModel )
+            .add_property( "initial_time", &TabulatedRotationalEphemeris::getInitialTime )
+            .add_property( "final_time", &TabulatedRotationalEphemeris::getFinalTime )
+            .add_property( "time_step", &TabulatedRotationalEphemeris::getTimeStep )
+            ;
+
+    def( "create_tabulated_rotation_model", &createTabulatedRotationModel,
+         ( arg( "rotation_model" ), arg( "initial_time" ), arg( "final_time" ), arg( "time_step" ) = 60.0 ),
+         "Precompute the rotation and angular velocity of a rotation model on a uniform grid from initial_time\n"
+         "(with a last, shorter, step ending at final_time), from which they are interpolated (cubic Hermite\n"
+         "interpolation of the quaternions). Epochs outside the grid are evaluated by the original model." );
+
+    def( "set_tabulated_rotation_model", &setTabulatedRotationModel,
+         ( arg( "body_map" ), arg( "body_name" ), arg( "initial_time" ), arg( "final_time" ),
+           arg( "time_step" ) = 60.0 ),
+         "Replace the rotation model of a body by a tabulated version (see create_tabulated_rotation_model), so\n"
+         "that subsequent propagations with the body map interpolate it instead of evaluating it at every\n"
+         "integrator stage." );
+}
+
+} // namespace tudatpy
@@ -0,0 +1,148 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_ROTATION_MODELS_H
+#define TUDATPY_ROTATION_MODELS_H
+
+#include <cstddef>
+#include <memory>
+
+#include "Tudat/Astrodynamics/Ephemerides/rotationalEphemeris.h"
+
+namespace tudatpy
+{
+
+//! Rotation model interpolating a table of rotations precomputed from another rotation model.
+/*!
+ *  The rotation (as a quaternion) and angular velocity of the original model are stored on a uniform time grid,
+ *  of which the last step ends at the final epoch.
+ *  Rotations in between are found by cubic Hermite interpolation of the quaternion, using its rate at the grid
+ *  points, and renormalization; the angular velocity is interpolated linearly. Evaluation does not modify the
+ *  object, so that it may be done from several threads. Epochs outside the grid are passed to the original model.
+ */
+class TabulatedRotationalEphemeris: public tudat::ephemerides::RotationalEphemeris
+{
+public:
+
+    //! Constructor, evaluating the original model at all grid points.
+    /*!
+     *  \param rotationModel Original rotation model.
+     *  \param initialTime First epoch of the grid.
+     *  \param finalTime Last epoch of the grid; the last step is shortened to end at it.
+     *  \param timeStep Distance between the grid points.
+     */
+    TabulatedRotationalEphemeris(
+            const std::shared_ptr< tudat::ephemerides::RotationalEphemeris > rotationModel,
+            const double initialTime, const double finalTime, const double timeStep );
+
+    Eigen::Quaterniond getRotationToBaseFrame( const double secondsSinceEpoch );
+
+    Eigen::Quaterniond getRotationToTargetFrame( const double secondsSinceEpoch )
+    {
+        return getRotationToBaseFrame( secondsSinceEpoch ).inverse( );
+    }
+
+    Eigen::Matrix3d getDerivativeOfRotationToBaseFrame( const double secondsSinceEpoch );
+
+    Eigen::Matrix3d getDerivativeOfRotationToTargetFrame( const double secondsSinceEpoch )
+    {
+        return getDerivativeOfRotationToBaseFrame( secondsSinceEpoch ).transpose( );
+    }
+
+    //! Whether an epoch lies on the grid, so that it is evaluated from the table.
+    bool isTabulated( const double secondsSinceEpoch ) const
+    {
+        return secondsSinceEpoch >= initialTime_ && secondsSinceEpoch <= finalTime_;
+    }
+
+    //! Rotation to the base frame, interpolated from the table (the epoch must be tabulated).
+    Eigen::Quaterniond interpolateRotationToBaseFrame( const double secondsSinceEpoch ) const;
+
+    //! Original rotation model.
+    std::shared_ptr< tudat::ephemerides::RotationalEphemeris > getOriginalRotationModel( ) const
+    {
+        return rotationModel_;
+    }
+
+    double getInitialTime( ) const
+    {
+        return initialTime_;
+    }
+
+    double getFinalTime( ) const
+    {
+        return finalTime_;
+    }
+
+    double getTimeStep( ) const
+    {
+        return timeStep_;
+    }
+
+private:
+
+    //! Index of the grid interval containing a tabulated epoch, the fraction of the interval at the epoch, and the
+    //! length of the interval.
+    std::size_t getInterval( const double secondsSinceEpoch, double& fraction, double& intervalLength ) const;
+
+    //! Original rotation model.
+    std::shared_ptr< tudat::ephemerides::RotationalEphemeris > rotationModel_;
+
+    //! First epoch of the grid.
+    double initialTime_;
+
+    //! Last epoch of the grid.
+    double finalTime_;
+
+    //! Distance between the grid points.
+    double timeStep_;
+
+    //! Coefficients (x, y, z, w) of the quaternions of the rotation to the base frame at the grid points, with
+    //! consecutive quaternions in the same hemisphere.
+    Eigen::Matrix< double, 4, Eigen::Dynamic > quaternions_;
+
+    //! Time derivatives of quaternions_.
+    Eigen::Matrix< double, 4, Eigen::Dynamic > quaternionRates_;
+
+    //! Angular velocities of the target frame, expressed in the base frame, at the grid points.
+    Eigen::Matrix3Xd angularVelocities_;
+};
+
+//! Tabulated rotation model covering a series of epochs.
+/*!
+ *  \param rotationModel Rotation model to evaluate.
+ *  \param numberOfPoints Number of epochs.
+ *  \param epochs Epochs at which the model is evaluated.
+ *  \return The model, if it is a TabulatedRotationalEphemeris of which the grid covers all epochs, or nullptr.
+ */
+const TabulatedRotationalEphemeris* getTabulatedRotationModel(
+        const tudat::ephemerides::RotationalEphemeris& rotationModel, const std::size_t numberOfPoints,
+        const double* epochs );
+
+//! Rotate a series of positions between the base and the target frame of a rotation model.
+/*!
+ *  For a tabulated rotation model covering all epochs, the points are distributed over the worker threads; otherwise
+ *  they are evaluated serially (as the model may call SPICE). Does not touch any Python object, so that it may be
+ *  called with the GIL released if the evaluated model does not call SPICE.
+ *  \param rotationModel Rotation model to evaluate.
+ *  \param numberOfPoints Number of points.
+ *  \param epochs Epochs of the points.
+ *  \param positions Row-major (numberOfPoints x 3) block of positions.
+ *  \param rotatedPositions Row-major (numberOfPoints x 3) block to which the rotated positions are written.
+ *  \param isToTargetFrame Whether positions are rotated from the base to the target (body-fixed) frame, or back.
+ *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+ */
+void rotatePositions( tudat::ephemerides::RotationalEphemeris& rotationModel, const std::size_t numberOfPoints,
+                      const double* epochs, const double* positions, double* rotatedPositions,
+                      const bool isToTargetFrame, const unsigned int numberOfThreads );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_ROTATION_MODELS_H
@@ -0,0 +1,1028 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/python/make_constructor.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModelTypes.h"
+#include "Tudat/Mathematics/Interpolators/createInterpolator.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createAerodynamicCoefficientInterface.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createAtmosphereModel.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodyShapeModel.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createEphemeris.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createGravityField.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createGroundStations.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createRadiationPressureInterface.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createRotationModel.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationTerminationSettings.h"
+
+#include "SettingsSerialization.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Identifier at the start of every serialized settings string (including the format version).
+const char serializedSettingsIdentifier[ 8 ] = { 'T', 'P', 'Y', 'S', 'E', 'T', '0', '1' };
+
+//! Tags identifying the concrete type of a serialized settings object (0 for nullptr).
+enum SettingsTypeTag
+{
+    null_settings = 0,
+    exponential_atmosphere_settings,
+    direct_spice_ephemeris_settings,
+    interpolated_spice_ephemeris_settings,
+    constant_ephemeris_settings,
+    tabulated_ephemeris_settings,
+    central_gravity_field_settings,
+    spherical_harmonics_gravity_field_settings,
+    simple_rotation_model_settings,
+    spice_rotation_model_settings,
+    spherical_body_shape_settings,
+    oblate_spheroid_body_shape_settings,
+    cannon_ball_radiation_pressure_settings,
+    constant_aerodynamic_coefficient_settings,
+    ground_station_settings
+};
+
+//! Appends values to a binary string.
+class SettingsWriter
+{
+public:
+
+    template< typename ValueType >
+    void write( const ValueType value )
+    {
+        data_.append( reinterpret_cast< const char* >( &value ), sizeof( ValueType ) );
+    }
+
+    void writeTag( const SettingsTypeTag tag )
+    {
+        write< std::uint8_t >( static_cast< std::uint8_t >( tag ) );
+    }
+
+    void writeString( const std::string& value )
+    {
+        write< std::uint64_t >( value.size( ) );
+        data_.append( value );
+    }
+
+    void writeMatrix( const Eigen::MatrixXd& value )
+    {
+        write< std::uint64_t >( value.rows( ) );
+        write< std::uint64_t >( value.cols( ) );
+        data_.append( reinterpret_cast< const char* >( value.data( ) ), value.size( ) * sizeof( double ) );
+    }
+
+    const std::string& getData( ) const
+    {
+        return data_;
+    }
+
+private:
+
+    std::string data_;
+};
+
+//! Reads values from a binary string, checking that it is not exceeded.
+class SettingsReader
+{
+public:
+
+    explicit SettingsReader( const std::string& data ): data_( data ), position_( 0 ) { }
+
+    template< typename ValueType >
+    ValueType read( )
+    {
+        ValueType value;
+        std::memcpy( &value, advance( sizeof( ValueType ) ), sizeof( ValueType ) );
+        return value;
+    }
+
+    SettingsTypeTag readTag( )
+    {
+        return static_cast< SettingsTypeTag >( read< std::uint8_t >( ) );
+    }
+
+    std::string readString( )
+    {
+        const std::size_t size = read< std::uint64_t >( );
+        return std::string( advance( size ), size );
+    }
+
+    //! Read a number of elements, checking that the remaining data can hold them (before they are allocated).
+    /*!
+     *  \param minimumElementSize Minimum size of a serialized element (in bytes).
+     */
+    std::size_t readCount( const std::size_t minimumElementSize )
+    {
+        const std::uint64_t count = read< std::uint64_t >( );
+        if( count > getRemainingSize( ) / minimumElementSize )
+        {
+            throw std::runtime_error( "Error when deserializing settings, data is truncated" );
+        }
+        return static_cast< std::size_t >( count );
+    }
+
+    //! Read a matrix, checking its size against the expected size (where non-negative) and the remaining data.
+    Eigen::MatrixXd readMatrix( const long expectedRows = -1, const long expectedColumns = -1 )
+    {
+        const std::uint64_t rows = read< std::uint64_t >( );
+        const std::uint64_t columns = read< std::uint64_t >( );
+        if( ( expectedRows >= 0 && rows != static_cast< std::uint64_t >( expectedRows ) ) ||
+                ( expectedColumns >= 0 && columns != static_cast< std::uint64_t >( expectedColumns ) ) )
+        {
+            throw std::runtime_error( "Error when deserializing settings, matrix size is inconsistent" );
+        }
+        const std::uint64_t maximumIndex = static_cast< std::uint64_t >( std::numeric_limits< long >::max( ) );
+        if( rows > maximumIndex || columns > maximumIndex ||
+                ( columns > 0 && rows > getRemainingSize( ) / sizeof( double ) / columns ) )
+        {
+            throw std::runtime_error( "Error when deserializing settings, data is truncated" );
+        }
+        Eigen::MatrixXd value( static_cast< long >( rows ), static_cast< long >( columns ) );
+        std::memcpy( value.data( ), advance( value.size( ) * sizeof( double ) ), value.size( ) * sizeof( double ) );
+        return value;
+    }
+
+    bool isAtEnd( ) const
+    {
+        return position_ == data_.size( );
+    }
+
+    std::size_t getRemainingSize( ) const
+    {
+        return data_.size( ) - position_;
+    }
+
+private:
+
+    const char* advance( const std::size_t size )
+    {
+        if( size > data_.size( ) - position_ )
+        {
+            throw std::runtime_error( "Error when deserializing settings, data is truncated" );
+        }
+        const char* value = data_.data( ) + position_;
+        position_ += size;
+        return value;
+    }
+
+    const std::string& data_;
+
+    std::size_t position_;
+};
+
+void throwUnsupportedSettings( const std::string& settingsName )
+{
+    throw std::runtime_error( "Error when serializing settings, this type of " + settingsName +
+                              " settings is not supported" );
+}
+
+void writeAtmosphereSettings( SettingsWriter& writer, const std::shared_ptr< AtmosphereSettings > settings )
+{
+    if( settings == nullptr )
+    {
+        writer.writeTag( null_settings );
+    }
+    else if( auto exponentialSettings = std::dynamic_pointer_cast< ExponentialAtmosphereSettings >( settings ) )
+    {
+        writer.writeTag( exponential_atmosphere_settings );
+        writer.write( exponentialSettings->getDensityScaleHeight( ) );
+        writer.write( exponentialSettings->getConstantTemperature( ) );
+        writer.write( exponentialSettings->getDensityAtZeroAltitude( ) );
+        writer.write( exponentialSettings->getSpecificGasConstant( ) );
+    }
+    else
+    {
+        throwUnsupportedSettings( "atmosphere" );
+    }
+}
+
+std::shared_ptr< AtmosphereSettings > readAtmosphereSettings( SettingsReader& reader )
+{
+    switch( reader.readTag( ) )
+    {
+    case null_settings:
+        return nullptr;
+    case exponential_atmosphere_settings:
+    {
+        const double densityScaleHeight = reader.read< double >( );
+        const double constantTemperature = reader.read< double >( );
+        const double densityAtZeroAltitude = reader.read< double >( );
+        const double specificGasConstant = reader.read< double >( );
+        return std::make_shared< ExponentialAtmosphereSettings >(
+                    densityScaleHeight, constantTemperature, densityAtZeroAltitude, specificGasConstant );
+    }
+    default:
+        throw std::runtime_error( "Error when deserializing settings, atmosphere settings type is invalid" );
+    }
+}
+
+void writeEphemerisSettings( SettingsWriter& writer, const std::shared_ptr< EphemerisSettings > settings )
+{
+    if( settings == nullptr )
+    {
+        writer.writeTag( null_settings );
+    }
+    else if( auto interpolatedSettings = std::dynamic_pointer_cast< InterpolatedSpiceEphemerisSettings >( settings ) )
+    {
+        std::shared_ptr< tudat::interpolators::LagrangeInterpolatorSettings > interpolatorSettings =
+                std::dynamic_pointer_cast< tudat::interpolators::LagrangeInterpolatorSettings >(
+                    interpolatedSettings->getInterpolatorSettings( ) );
+        if( interpolatorSettings == nullptr )
+        {
+            throwUnsupportedSettings( "ephemeris interpolator" );
+        }
+        writer.writeTag( interpolated_spice_ephemeris_settings );
+        writer.writeString( settings->getFrameOrigin( ) );
+        writer.writeString( settings->getFrameOrientation( ) );
+        writer.write( interpolatedSettings->getInitialTime( ) );
+        writer.write( interpolatedSettings->getFinalTime( ) );
+        writer.write( interpolatedSettings->getTimeStep( ) );
+        writer.write< std::int32_t >( interpolatorSettings->getInterpolatorOrder( ) );
+    }
+    else if( auto spiceSettings = std::dynamic_pointer_cast< DirectSpiceEphemerisSettings >( settings ) )
+    {
+        writer.writeTag( direct_spice_ephemeris_settings );
+        writer.writeString( settings->getFrameOrigin( ) );
+        writer.writeString( settings->getFrameOrientation( ) );
+        writer.write< std::uint8_t >( spiceSettings->getCorrectForStellarAberration( ) );
+        writer.write< std::uint8_t >( spiceSettings->getCorrectForLightTimeAberration( ) );
+        writer.write< std::uint8_t >( spiceSettings->getConvergeLighTimeAberration( ) );
+    }
+    else if( auto constantSettings = std::dynamic_pointer_cast< ConstantEphemerisSettings >( settings ) )
+    {
+        writer.writeTag( constant_ephemeris_settings );
+        writer.writeString( settings->getFrameOrigin( ) );
+        writer.writeString( settings->getFrameOrientation( ) );
+        writer.writeMatrix( constantSettings->getConstantState( ) );
+    }
+    else if( auto tabulatedSettings = std::dynamic_pointer_cast< TabulatedEphemerisSettings >( settings ) )
+    {
+        writer.writeTag( tabulated_ephemeris_settings );
+        writer.writeString( settings->getFrameOrigin( ) );
+        writer.writeString( settings->getFrameOrientation( ) );
+        const std::map< double, Eigen::Vector6d >& stateHistory = tabulatedSettings->getBodyStateHistory( );
+        writer.write< std::uint64_t >( stateHistory.size( ) );
+        for( auto stateIterator = stateHistory.begin( ); stateIterator != stateHistory.end( ); stateIterator++ )
+        {
+            writer.write( stateIterator->first );
+            for( int i = 0; i < 6; i++ )
+            {
+                writer.write( stateIterator->second( i ) );
+            }
+        }
+    }
+    else
+    {
+        throwUnsupportedSettings( "ephemeris" );
+    }
+}
+
+std::shared_ptr< EphemerisSettings > readEphemerisSettings( SettingsReader& reader )
+{
+    const SettingsTypeTag tag = reader.readTag( );
+    if( tag == null_settings )
+    {
+        return nullptr;
+    }
+
+    const std::string frameOrigin = reader.readString( );
+    const std::string frameOrientation = reader.readString( );
+    switch( tag )
+    {
+    case interpolated_spice_ephemeris_settings:
+    {
+        const double initialTime = reader.read< double >( );
+        const double finalTime = reader.read< double >( );
+        const double timeStep = reader.read< double >( );
+        const int interpolatorOrder = reader.read< std::int32_t >( );
+        return std::make_shared< InterpolatedSpiceEphemerisSettings >(
+                    initialTime, finalTime, timeStep, frameOrigin, frameOrientation,
+                    std::make_shared< tudat::interpolators::LagrangeInterpolatorSettings >( interpolatorOrder ) );
+    }
+    case direct_spice_ephemeris_settings:
+    {
+        const bool correctForStellarAberration = reader.read< std::uint8_t >( );
+        const bool correctForLightTimeAberration = reader.read< std::uint8_t >( );
+        const bool convergeLightTimeAberration = reader.read< std::uint8_t >( );
+        return std::make_shared< DirectSpiceEphemerisSettings >(
+                    frameOrigin, frameOrientation, correctForStellarAberration, correctForLightTimeAberration,
+                    convergeLightTimeAberration );
+    }
+    case constant_ephemeris_settings:
+        return std::make_shared< ConstantEphemerisSettings >(
+                    Eigen::Vector6d( reader.readMatrix( 6, 1 ) ), frameOrigin, frameOrientation );
+    case tabulated_ephemeris_settings:
+    {
+        std::map< double, Eigen::Vector6d > stateHistory;
+        const std::size_t numberOfEpochs = reader.readCount( 7 * sizeof( double ) );
+        for( std::size_t i = 0; i < numberOfEpochs; i++ )
+        {
+            const double epoch = reader.read< double >( );
+            Eigen::Vector6d state;
+            for( int j = 0; j < 6; j++ )
+            {
+                state( j ) = reader.read< double >( );
+            }
+            stateHistory[ epoch ] = state;
+        }
+        return std::make_shared< TabulatedEphemerisSettings >( stateHistory, frameOrigin, frameOrientation );
+    }
+    default:
+        throw std::runtime_error( "Error when deserializing settings, ephemeris settings type is invalid" );
+    }
+}
+
+void writeGravityFieldSettings( SettingsWriter& writer, const std::shared_ptr< GravityFieldSettings > settings )
+{
+    if( settings == nullptr )
+    {
+        writer.writeTag( null_settings );
+    }
+    else if( auto sphericalHarmonicsSettings =
+             std::dynamic_pointer_cast< SphericalHarmonicsGravityFieldSettings >( settings ) )
+    {
+        writer.writeTag( spherical_harmonics_gravity_field_settings );
+        writer.write( sphericalHarmonicsSettings->getGravitationalParameter( ) );
+        writer.write( sphericalHarmonicsSettings->getReferenceRadius( ) );
+        writer.writeMatrix( sphericalHarmonicsSettings->getCosineCoefficients( ) );
+        writer.writeMatrix( sphericalHarmonicsSettings->getSineCoefficients( ) );
+        writer.writeString( sphericalHarmonicsSettings->getAssociatedReferenceFrame( ) );
+    }
+    else if( auto centralSettings = std::dynamic_pointer_cast< CentralGravityFieldSettings >( settings ) )
+    {
+        writer.writeTag( central_gravity_field_settings );
+        writer.write( centralSettings->getGravitationalParameter( ) );
+    }
+    else
+    {
+        throwUnsupportedSettings( "gravity field" );
+    }
+}
+
+std::shared_ptr< GravityFieldSettings > readGravityFieldSettings( SettingsReader& reader )
+{
+    switch( reader.readTag( ) )
+    {
+    case null_settings:
+        return nullptr;
+    case spherical_harmonics_gravity_field_settings:
+    {
+        const double gravitationalParameter = reader.read< double >( );
+        const double referenceRadius = reader.read< double >( );
+        const Eigen::MatrixXd cosineCoefficients = reader.readMatrix( );
+        const Eigen::MatrixXd sineCoefficients = reader.readMatrix( );
+        const std::string associatedReferenceFrame = reader.readString( );
+        return std::make_shared< SphericalHarmonicsGravityFieldSettings >(
+                    gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                    associatedReferenceFrame );
+    }
+    case central_gravity_field_settings:
+        return std::make_shared< CentralGravityFieldSettings >( reader.read< double >( ) );
+    default:
+        throw std::runtime_error( "Error when deserializing settings, gravity field settings type is invalid" );
+    }
+}
+
+void writeRotationModelSettings( SettingsWriter& writer, const std::shared_ptr< RotationModelSettings > settings )
+{
+    if( settings == nullptr )
+    {
+        writer.writeTag( null_settings );
+    }
+    else if( auto simpleSettings = std::dynamic_pointer_cast< SimpleRotationModelSettings >( settings ) )
+    {
+        writer.writeTag( simple_rotation_model_settings );
+        writer.writeString( settings->getOriginalFrame( ) );
+        writer.writeString( settings->getTargetFrame( ) );
+        writer.writeMatrix( simpleSettings->getInitialOrientation( ).coeffs( ) );
+        writer.write( simpleSettings->getInitialTime( ) );
+        writer.write( simpleSettings->getRotationRate( ) );
+    }
+    else if( std::dynamic_pointer_cast< SpiceRotationModelSettings >( settings ) != nullptr )
+    {
+        writer.writeTag( spice_rotation_model_settings );
+        writer.writeString( settings->getOriginalFrame( ) );
+        writer.writeString( settings->getTargetFrame( ) );
+    }
+    else
+    {
+        throwUnsupportedSettings( "rotation model" );
+    }
+}
+
+std::shared_ptr< RotationModelSettings > readRotationModelSettings( SettingsReader& reader )
+{
+    const SettingsTypeTag tag = reader.readTag( );
+    if( tag == null_settings )
+    {
+        return nullptr;
+    }
+
+    const std::string originalFrame = reader.readString( );
+    const std::string targetFrame = reader.readString( );
+    switch( tag )
+    {
+    case simple_rotation_model_settings:
+    {
+        Eigen::Quaterniond initialOrientation;
+        initialOrientation.coeffs( ) = reader.readMatrix( 4, 1 );
+        const double initialTime = reader.read< double >( );
+        const double rotationRate = reader.read< double >( );
+        return std::make_shared< SimpleRotationModelSettings >(
+                    originalFrame, targetFrame, initialOrientation, initialTime, rotationRate );
+    }
+    case spice_rotation_model_settings:
+        return std::make_shared< SpiceRotationModelSettings >( originalFrame, targetFrame );
+    default:
+        throw std::runtime_error( "Error when deserializing settings, rotation model settings type is invalid" );
+    }
+}
+
+void writeBodyShapeSettings( SettingsWriter& writer, const std::shared_ptr< BodyShapeSettings > settings )
+{
+    if( settings == nullptr )
+    {
+        writer.writeTag( null_settings );
+    }
+    else if( auto oblateSettings = std::dynamic_pointer_cast< OblateSphericalBodyShapeSettings >( settings ) )
+    {
+        writer.writeTag( oblate_spheroid_body_shape_settings );
+        writer.write( oblateSettings->getEquatorialRadius( ) );
+        writer.write( oblateSettings->getFlattening( ) );
+    }
+    else if( auto sphericalSettings = std::dynamic_pointer_cast< SphericalBodyShapeSettings >( settings ) )
+    {
+        writer.writeTag( spherical_body_shape_settings );
+        writer.write( sphericalSettings->getRadius( ) );
+    }
+    else
+    {
+        throwUnsupportedSettings( "body shape" );
+    }
+}
+
+std::shared_ptr< BodyShapeSettings > readBodyShapeSettings( SettingsReader& reader )
+{
+    switch( reader.readTag( ) )
+    {
+    case null_settings:
+        return nullptr;
+    case oblate_spheroid_body_shape_settings:
+    {
+        const double equatorialRadius = reader.read< double >( );
+        const double flattening = reader.read< double >( );
+        return std::make_shared< OblateSphericalBodyShapeSettings >( equatorialRadius, flattening );
+    }
+    case spherical_body_shape_settings:
+        return std::make_shared< SphericalBodyShapeSettings >( reader.read< double >( ) );
+    default:
+        throw std::runtime_error( "Error when deserializing settings, body shape settings type is invalid" );
+    }
+}
+
+void writeRadiationPressureSettings( SettingsWriter& writer,
+                                     const std::shared_ptr< RadiationPressureInterfaceSettings > settings )
+{
+    auto cannonBallSettings = std::dynamic_pointer_cast< CannonBallRadiationPressureInterfaceSettings >( settings );
+    if( cannonBallSettings == nullptr )
+    {
+        throwUnsupportedSettings( "radiation pressure" );
+    }
+    writer.writeTag( cannon_ball_radiation_pressure_settings );
+    writer.writeString( cannonBallSettings->getSourceBody( ) );
+    writer.write( cannonBallSettings->getArea( ) );
+    writer.write( cannonBallSettings->getRadiationPressureCoefficient( ) );
+    const std::vector< std::string > occultingBodies = cannonBallSettings->getOccultingBodies( );
+    writer.write< std::uint64_t >( occultingBodies.size( ) );
+    for( unsigned int i = 0; i < occultingBodies.size( ); i++ )
+    {
+        writer.writeString( occultingBodies.at( i ) );
+    }
+}
+
+std::shared_ptr< RadiationPressureInterfaceSettings > readRadiationPressureSettings( SettingsReader& reader )
+{
+    if( reader.readTag( ) != cannon_ball_radiation_pressure_settings )
+    {
+        throw std::runtime_error( "Error when deserializing settings, radiation pressure settings type is invalid" );
+    }
+    const std::string sourceBody = reader.readString( );
+    const double area = reader.read< double >( );
+    const double radiationPressureCoefficient = reader.read< double >( );
+    std::vector< std::string > occultingBodies( reader.readCount( sizeof( std::uint64_t ) ) );
+    for( unsigned int i = 0; i < occultingBodies.size( ); i++ )
+    {
+        occultingBodies.at( i ) = reader.readString( );
+    }
+    return std::make_shared< CannonBallRadiationPressureInterfaceSettings >(
+                sourceBody, area, radiationPressureCoefficient, occultingBodies );
+}
+
+void writeAerodynamicCoefficientSettings( SettingsWriter& writer,
+                                          const std::shared_ptr< AerodynamicCoefficientSettings > settings )
+{
+    if( settings == nullptr )
+    {
+        writer.writeTag( null_settings );
+        return;
+    }
+    auto constantSettings = std::dynamic_pointer_cast< ConstantAerodynamicCoefficientSettings >( settings );
+    if( constantSettings == nullptr )
+    {
+        throwUnsupportedSettings( "aerodynamic coefficient" );
+    }
+    writer.writeTag( constant_aerodynamic_coefficient_settings );
+    writer.write( constantSettings->getReferenceLength( ) );
+    writer.write( constantSettings->getReferenceArea( ) );
+    writer.write( constantSettings->getReferenceLateralLength( ) );
+    writer.writeMatrix( constantSettings->getMomentReferencePoint( ) );
+    writer.writeMatrix( constantSettings->getConstantForceCoefficient( ) );
+    writer.writeMatrix( constantSettings->getConstantMomentCoefficient( ) );
+    writer.write< std::uint8_t >( constantSettings->getAreCoefficientsInAerodynamicFrame( ) );
+    writer.write< std::uint8_t >( constantSettings->getAreCoefficientsInNegativeAxisDirection( ) );
+}
+
+std::shared_ptr< AerodynamicCoefficientSettings > readAerodynamicCoefficientSettings( SettingsReader& reader )
+{
+    switch( reader.readTag( ) )
+    {
+    case null_settings:
+        return nullptr;
+    case constant_aerodynamic_coefficient_settings:
+    {
+        const double referenceLength = reader.read< double >( );
+        const double referenceArea = reader.read< double >( );
+        const double lateralReferenceLength = reader.read< double >( );
+        const Eigen::Vector3d momentReferencePoint = reader.readMatrix( 3, 1 );
+        const Eigen::Vector3d forceCoefficients = reader.readMatrix( 3, 1 );
+        const Eigen::Vector3d momentCoefficients = reader.readMatrix( 3, 1 );
+        const bool areCoefficientsInAerodynamicFrame = reader.read< std::uint8_t >( );
+        const bool areCoefficientsInNegativeAxisDirection = reader.read< std::uint8_t >( );
+        return std::make_shared< ConstantAerodynamicCoefficientSettings >(
+                    referenceLength, referenceArea, lateralReferenceLength, momentReferencePoint, forceCoefficients,
+                    momentCoefficients, areCoefficientsInAerodynamicFrame, areCoefficientsInNegativeAxisDirection );
+    }
+    default:
+        throw std::runtime_error( "Error when deserializing settings, aerodynamic settings type is invalid" );
+    }
+}
+
+void writeGroundStationSettings( SettingsWriter& writer, const std::shared_ptr< GroundStationSettings > settings )
+{
+    writer.writeTag( ground_station_settings );
+    writer.writeString( settings->getStationName( ) );
+    writer.writeMatrix( settings->getGroundStationPosition( ) );
+    writer.write< std::int32_t >( settings->getPositionElementType( ) );
+}
+
+std::shared_ptr< GroundStationSettings > readGroundStationSettings( SettingsReader& reader )
+{
+    if( reader.readTag( ) != ground_station_settings )
+    {
+        throw std::runtime_error( "Error when deserializing settings, ground station settings type is invalid" );
+    }
+    const std::string stationName = reader.readString( );
+    const Eigen::Vector3d position = reader.readMatrix( 3, 1 );
+    const int positionElementType = reader.read< std::int32_t >( );
+    return std::make_shared< GroundStationSettings >(
+                stationName, position,
+                static_cast< tudat::coordinate_conversions::PositionElementTypes >( positionElementType ) );
+}
+
+void writeBodySettings( SettingsWriter& writer, const BodySettings& settings )
+{
+    if( !settings.gravityFieldVariationSettings.empty( ) )
+    {
+        throwUnsupportedSettings( "gravity field variation" );
+    }
+
+    writer.write( settings.constantMass );
+    writeAtmosphereSettings( writer, settings.atmosphereSettings );
+    writeEphemerisSettings( writer, settings.ephemerisSettings );
+    writeGravityFieldSettings( writer, settings.gravityFieldSettings );
+    writeRotationModelSettings( writer, settings.rotationModelSettings );
+    writeBodyShapeSettings( writer, settings.shapeModelSettings );
+    writeAerodynamicCoefficientSettings( writer, settings.aerodynamicCoefficientSettings );
+
+    writer.write< std::uint64_t >( settings.radiationPressureSettings.size( ) );
+    for( auto settingsIterator = settings.radiationPressureSettings.begin( );
+         settingsIterator != settings.radiationPressureSettings.end( ); settingsIterator++ )
+    {
+        writer.writeString( settingsIterator->first );
+        writeRadiationPressureSettings( writer, settingsIterator->second );
+    }
+
+    writer.write< std::uint64_t >( settings.groundStationSettings.size( ) );
+    for( unsigned int i = 0; i < settings.groundStationSettings.size( ); i++ )
+    {
+        writeGroundStationSettings( writer, settings.groundStationSettings.at( i ) );
+    }
+}
+
+std::shared_ptr< BodySettings > readBodySettings( SettingsReader& reader )
+{
+    std::shared_ptr< BodySettings > settings = std::make_shared< BodySettings >( );
+    settings->constantMass = reader.read< double >( );
+    settings->atmosphereSettings = readAtmosphereSettings( reader );
+    settings->ephemerisSettings = readEphemerisSettings( reader );
+    settings->gravityFieldSettings = readGravityFieldSettings( reader );
+    settings->rotationModelSettings = readRotationModelSettings( reader );
+    settings->shapeModelSettings = readBodyShapeSettings( reader );
+    settings->aerodynamicCoefficientSettings = readAerodynamicCoefficientSettings( reader );
+
+    const std::size_t numberOfRadiationPressureSettings = reader.readCount( sizeof( std::uint64_t ) );
+    for( std::size_t i = 0; i < numberOfRadiationPressureSettings; i++ )
+    {
+        const std::string sourceBody = reader.readString( );
+        settings->radiationPressureSettings[ sourceBody ] = readRadiationPressureSettings( reader );
+    }
+
+    const std::size_t numberOfGroundStations = reader.readCount( sizeof( std::uint8_t ) );
+    for( std::size_t i = 0; i < numberOfGroundStations; i++ )
+    {
+        settings->groundStationSettings.push_back( readGroundStationSettings( reader ) );
+    }
+    return settings;
+}
+
+void writeIntegratorSettings(
+        SettingsWriter& writer,
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > settings )
+{
+    using namespace tudat::numerical_integrators;
+    writer.write< std::int64_t >( settings->integratorType_ );
+    writer.write( settings->initialTime_ );
+    writer.write( settings->initialTimeStep_ );
+    if( const std::shared_ptr< RungeKuttaVariableStepSizeSettings< double > > variableStepSettings =
+            std::dynamic_pointer_cast< RungeKuttaVariableStepSizeSettings< double > >( settings ) )
+    {
+        writer.write< std::int64_t >( variableStepSettings->coefficientSet_ );
+        writer.write( variableStepSettings->minimumStepSize_ );
+        writer.write( variableStepSettings->maximumStepSize_ );
+        writer.write( variableStepSettings->relativeErrorTolerance_ );
+        writer.write( variableStepSettings->absoluteErrorTolerance_ );
+        writer.write( variableStepSettings->safetyFactorForNextStepSize_ );
+        writer.write( variableStepSettings->maximumFactorIncreaseForNextStepSize_ );
+        writer.write( variableStepSettings->minimumFactorDecreaseForNextStepSize_ );
+    }
+}
+
+void writeTerminationSettings( SettingsWriter& writer,
+                               const std::shared_ptr< tudat::propagators::PropagationTerminationSettings > settings )
+{
+    using namespace tudat::propagators;
+    writer.write< std::int64_t >( settings->terminationType_ );
+    writer.write( settings->terminateExactlyOnFinalCondition_ );
+    if( const std::shared_ptr< PropagationTimeTerminationSettings > timeSettings =
+            std::dynamic_pointer_cast< PropagationTimeTerminationSettings >( settings ) )
+    {
+        writer.write( timeSettings->terminationTime_ );
+    }
+}
+
+void writeStringList( SettingsWriter& writer, const std::vector< std::string >& values )
+{
+    writer.write< std::uint64_t >( values.size( ) );
+    for( unsigned int i = 0; i < values.size( ); i++ )
+    {
+        writer.writeString( values.at( i ) );
+    }
+}
+
+//! Write the acceleration model types of an acceleration map, ordered by the names of the bodies.
+void writeAccelerationModelTypes( SettingsWriter& writer,
+                                  const tudat::basic_astrodynamics::AccelerationMap& accelerationMap )
+{
+    std::vector< std::string > bodiesUndergoingAcceleration;
+    for( auto bodyIterator = accelerationMap.begin( ); bodyIterator != accelerationMap.end( ); bodyIterator++ )
+    {
+        bodiesUndergoingAcceleration.push_back( bodyIterator->first );
+    }
+    std::sort( bodiesUndergoingAcceleration.begin( ), bodiesUndergoingAcceleration.end( ) );
+    writeStringList( writer, bodiesUndergoingAcceleration );
+
+    for( unsigned int i = 0; i < bodiesUndergoingAcceleration.size( ); i++ )
+    {
+        const auto& accelerationsOnBody = accelerationMap.at( bodiesUndergoingAcceleration.at( i ) );
+        std::vector< std::string > bodiesExertingAcceleration;
+        for( auto bodyIterator = accelerationsOnBody.begin( ); bodyIterator != accelerationsOnBody.end( );
+             bodyIterator++ )
+        {
+            bodiesExertingAcceleration.push_back( bodyIterator->first );
+        }
+        std::sort( bodiesExertingAcceleration.begin( ), bodiesExertingAcceleration.end( ) );
+        writeStringList( writer, bodiesExertingAcceleration );
+
+        for( unsigned int j = 0; j < bodiesExertingAcceleration.size( ); j++ )
+        {
+            const auto& accelerationModels = accelerationsOnBody.at( bodiesExertingAcceleration.at( j ) );
+            writer.write< std::uint64_t >( accelerationModels.size( ) );
+            for( unsigned int k = 0; k < accelerationModels.size( ); k++ )
+            {
+                writer.write< std::int64_t >(
+                            tudat::basic_astrodynamics::getAccelerationModelType( accelerationModels.at( k ) ) );
+            }
+        }
+    }
+}
+
+void writePropagatorSettings( SettingsWriter& writer,
+                              const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > settings )
+{
+    using namespace tudat::propagators;
+    const std::shared_ptr< SingleArcPropagatorSettings< double > > singleArcSettings =
+            std::dynamic_pointer_cast< SingleArcPropagatorSettings< double > >( settings );
+    writer.write( singleArcSettings != nullptr );
+    if( singleArcSettings == nullptr )
+    {
+        return;
+    }
+
+    writeTerminationSettings( writer, singleArcSettings->getTerminationSettings( ) );
+    const std::shared_ptr< DependentVariableSaveSettings > dependentVariableSettings =
+            singleArcSettings->getDependentVariablesToSave( );
+    writer.write< std::uint64_t >(
+                dependentVariableSettings == nullptr ? 0 : dependentVariableSettings->dependentVariables_.size( ) );
+    for( unsigned int i = 0; dependentVariableSettings != nullptr &&
+         i < dependentVariableSettings->dependentVariables_.size( ); i++ )
+    {
+        const std::shared_ptr< SingleDependentVariableSaveSettings > variableSettings =
+                dependentVariableSettings->dependentVariables_.at( i );
+        writer.write< std::int64_t >( variableSettings->dependentVariableType_ );
+        writer.writeString( variableSettings->associatedBody_ );
+        writer.writeString( variableSettings->secondaryBody_ );
+    }
+
+    const std::shared_ptr< TranslationalStatePropagatorSettings< double > > translationalSettings =
+            std::dynamic_pointer_cast< TranslationalStatePropagatorSettings< double > >( settings );
+    writer.write( translationalSettings != nullptr );
+    if( translationalSettings != nullptr )
+    {
+        writer.write< std::int64_t >( translationalSettings->propagator_ );
+        writeStringList( writer, translationalSettings->bodiesToIntegrate_ );
+        writeStringList( writer, translationalSettings->centralBodies_ );
+        writeAccelerationModelTypes( writer, translationalSettings->accelerationsMap_ );
+    }
+}
+
+//! Create a writer, and write the identifier and top-level type of a serialized settings string.
+SettingsWriter createSettingsWriter( const SerializedSettingsType type )
+{
+    SettingsWriter writer;
+    for( unsigned int i = 0; i < sizeof( serializedSettingsIdentifier ); i++ )
+    {
+        writer.write( serializedSettingsIdentifier[ i ] );
+    }
+    writer.write< std::uint8_t >( static_cast< std::uint8_t >( type ) );
+    return writer;
+}
+
+//! Create a reader positioned after the identifier, checking the top-level type of a serialized settings string.
+SettingsReader createSettingsReader( const std::string& data, const SerializedSettingsType expectedType )
+{
+    if( getSerializedSettingsType( data ) != expectedType )
+    {
+        throw std::runtime_error( "Error when deserializing settings, data holds settings of another type" );
+    }
+    SettingsReader reader( data );
+    for( unsigned int i = 0; i <= sizeof( serializedSettingsIdentifier ); i++ )
+    {
+        reader.read< char >( );
+    }
+    return reader;
+}
+
+//! Throw if a reader did not consume its complete input.
+template< typename SettingsType >
+std::shared_ptr< SettingsType > checkFullyRead( const SettingsReader& reader,
+                                                const std::shared_ptr< SettingsType > settings )
+{
+    if( !reader.isAtEnd( ) )
+    {
+        throw std::runtime_error( "Error when deserializing settings, data has trailing bytes" );
+    }
+    return settings;
+}
+
+} // namespace
+
+std::string serializeSettings( const std::shared_ptr< BodySettings > settings )
+{
+    SettingsWriter writer = createSettingsWriter( serialized_body_settings );
+    writeBodySettings( writer, *settings );
+    return writer.getData( );
+}
+
+std::string serializeSettings( const std::shared_ptr< AtmosphereSettings > settings )
+{
+    SettingsWriter writer = createSettingsWriter( serialized_atmosphere_settings );
+    writeAtmosphereSettings( writer, settings );
+    return writer.getData( );
+}
+
+std::string serializeSettings( const std::shared_ptr< EphemerisSettings > settings )
+{
+    SettingsWriter writer = createSettingsWriter( serialized_ephemeris_settings );
+    writeEphemerisSettings( writer, settings );
+    return writer.getData( );
+}
+
+std::string serializeSettings( const std::shared_ptr< GravityFieldSettings > settings )
+{
+    SettingsWriter writer = createSettingsWriter( serialized_gravity_field_settings );
+    writeGravityFieldSettings( writer, settings );
+    return writer.getData( );
+}
+
+std::string serializePropagationSettings(
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings )
+{
+    SettingsWriter writer = createSettingsWriter( serialized_propagation_settings );
+    writeIntegratorSettings( writer, integratorSettings );
+    writePropagatorSettings( writer, propagatorSettings );
+    return writer.getData( );
+}
+
+SerializedSettingsType getSerializedSettingsType( const std::string& data )
+{
+    if( data.size( ) <= sizeof( serializedSettingsIdentifier ) ||
+            std::memcmp( data.data( ), serializedSettingsIdentifier, sizeof( serializedSettingsIdentifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when deserializing settings, data is not serialized settings of this "
+                                  "version" );
+    }
+    return static_cast< SerializedSettingsType >(
+                static_cast< std::uint8_t >( data[ sizeof( serializedSettingsIdentifier ) ] ) );
+}
+
+template< >
+std::shared_ptr< BodySettings > deserializeSettings< BodySettings >( const std::string& data )
+{
+    SettingsReader reader = createSettingsReader( data, serialized_body_settings );
+    return checkFullyRead( reader, readBodySettings( reader ) );
+}
+
+template< >
+std::shared_ptr< AtmosphereSettings > deserializeSettings< AtmosphereSettings >( const std::string& data )
+{
+    SettingsReader reader = createSettingsReader( data, serialized_atmosphere_settings );
+    return checkFullyRead( reader, readAtmosphereSettings( reader ) );
+}
+
+template< >
+std::shared_ptr< EphemerisSettings > deserializeSettings< EphemerisSettings >( const std::string& data )
+{
+    SettingsReader reader = createSettingsReader( data, serialized_ephemeris_settings );
+    return checkFullyRead( reader, readEphemerisSettings( reader ) );
+}
+
+template< >
+std::shared_ptr< GravityFieldSettings > deserializeSettings< GravityFieldSettings >( const std::string& data )
+{
+    SettingsReader reader = createSettingsReader( data, serialized_gravity_field_settings );
+    return checkFullyRead( reader, readGravityFieldSettings( reader ) );
+}
+
+namespace
+{
+
+object createBytes( const std::string& data )
+{
+    return object( handle<>( PyBytes_FromStringAndSize( data.data( ), static_cast< Py_ssize_t >( data.size( ) ) ) ) );
+}
+
+std::string extractBytes( const object& bytes )
+{
+    char* data;
+    Py_ssize_t size;
+    if( PyBytes_AsStringAndSize( bytes.ptr( ), &data, &size ) == -1 )
+    {
+        throw_error_already_set( );
+    }
+    return std::string( data, static_cast< std::size_t >( size ) );
+}
+
+//! Install a deserialized settings object as the C++ object held by an uninitialized Python instance.
+template< typename SettingsType >
+void installSettings( const object& self, const std::shared_ptr< SettingsType > settings )
+{
+    if( extract< SettingsType& >( self ).check( ) )
+    {
+        throw std::runtime_error( "Error when unpickling settings, object is already initialized" );
+    }
+
+    typedef objects::pointer_holder< std::shared_ptr< SettingsType >, SettingsType > Holder;
+    typedef objects::instance< Holder > Instance;
+    void* memory = Holder::allocate( self.ptr( ), offsetof( Instance, storage ), sizeof( Holder ) );
+    try
+    {
+        ( new( memory ) Holder( settings ) )->install( self.ptr( ) );
+    }
+    catch( ... )
+    {
+        Holder::deallocate( self.ptr( ), memory );
+        throw;
+    }
+}
+
+void setSettingsState( const object& self, const object& state )
+{
+    const std::string data = extractBytes( state );
+    switch( getSerializedSettingsType( data ) )
+    {
+    case serialized_body_settings:
+        installSettings( self, deserializeSettings< BodySettings >( data ) );
+        break;
+    case serialized_atmosphere_settings:
+        installSettings( self, deserializeSettings< AtmosphereSettings >( data ) );
+        break;
+    case serialized_ephemeris_settings:
+        installSettings( self, deserializeSettings< EphemerisSettings >( data ) );
+        break;
+    case serialized_gravity_field_settings:
+        installSettings( self, deserializeSettings< GravityFieldSettings >( data ) );
+        break;
+    default:
+        throw std::runtime_error( "Error when unpickling settings, settings type is invalid" );
+    }
+}
+
+} // namespace
+
+// The settings classes are not default-constructible, so instances are recreated with copyreg.__newobj__ (creating
+// an instance without C++ object), after which __setstate__ installs the deserialized object.
+object reduceSettings( const object& self )
+{
+    std::string data;
+    if( extract< std::shared_ptr< BodySettings > >( self ).check( ) )
+    {
+        data = serializeSettings( extract< std::shared_ptr< BodySettings > >( self )( ) );
+    }
+    else if( extract< std::shared_ptr< AtmosphereSettings > >( self ).check( ) )
+    {
+        data = serializeSettings( extract< std::shared_ptr< AtmosphereSettings > >( self )( ) );
+    }
+    else if( extract< std::shared_ptr< EphemerisSettings > >( self ).check( ) )
+    {
+        data = serializeSettings( extract< std::shared_ptr< EphemerisSettings > >( self )( ) );
+    }
+    else if( extract< std::shared_ptr< GravityFieldSettings > >( self ).check( ) )
+    {
+        data = serializeSettings( extract< std::shared_ptr< GravityFieldSettings > >( self )( ) );
+    }
+    else
+    {
+        throw std::runtime_error( "Error when pickling settings, object type is not supported" );
+    }
+
+    return make_tuple( import( "copyreg" ).attr( "__newobj__" ), make_tuple( self.attr( "__class__" ) ),
+                       createBytes( data ) );
+}
+
+void exposeSettingsSerialization( )
+{
+    // Boost.Python gives every exposed class a __reduce__ that refuses pickling, so it is replaced for the (already
+    // exposed) base classes and all classes derived from them; __setstate__ is inherited from the base classes.
+    const char* baseClassNames[ ] =
+    { "BodySettings", "AtmosphereSettings", "EphemerisSettings", "GravityFieldSettings" };
+    const list scopeValues = dict( scope( ).attr( "__dict__" ) ).values( );
+    for( const char* baseClassName : baseClassNames )
+    {
+        object baseClass = scope( ).attr( baseClassName );
+        baseClass.attr( "__setstate__" ) = make_function( &setSettingsState );
+        for( long i = 0; i < len( scopeValues ); i++ )
+        {
+            object value = scopeValues[ i ];
+            if( PyType_Check( value.ptr( ) ) && PyObject_IsSubclass( value.ptr( ), baseClass.ptr( ) ) == 1 )
+            {
+                value.attr( "__reduce__" ) = make_function( &reduceSettings );
+            }
+        }
+    }
+}
+
+} // namespace tudatpy
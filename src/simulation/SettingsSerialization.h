@@ -0,0 +1,81 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_SETTINGS_SERIALIZATION_H
+#define TUDATPY_SETTINGS_SERIALIZATION_H
+
+#include <memory>
+#include <string>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationSettings.h"
+
+namespace tudatpy
+{
+
+//! Kinds of settings objects that can be serialized at the top level.
+enum SerializedSettingsType
+{
+    serialized_body_settings = 1,
+    serialized_atmosphere_settings = 2,
+    serialized_ephemeris_settings = 3,
+    serialized_gravity_field_settings = 4,
+    serialized_propagation_settings = 5
+};
+
+//! Serialize body settings, including all nested environment settings, to a compact binary string.
+/*!
+ *  The format stores doubles and integers in native byte order, and is meant for transfer between processes on the
+ *  same machine (e.g. pickling for multiprocessing), not for long-term storage. Settings types that cannot be
+ *  reconstructed from their public interface (e.g. gravity field variations) raise an error.
+ */
+std::string serializeSettings( const std::shared_ptr< tudat::simulation_setup::BodySettings > settings );
+
+//! Serialize atmosphere settings to a compact binary string (see above).
+std::string serializeSettings( const std::shared_ptr< tudat::simulation_setup::AtmosphereSettings > settings );
+
+//! Serialize ephemeris settings to a compact binary string (see above).
+std::string serializeSettings( const std::shared_ptr< tudat::simulation_setup::EphemerisSettings > settings );
+
+//! Serialize gravity field settings to a compact binary string (see above).
+std::string serializeSettings( const std::shared_ptr< tudat::simulation_setup::GravityFieldSettings > settings );
+
+//! Serialize the settings that determine a single-arc propagation, to compare propagations (it cannot be read back).
+/*!
+ *  Stores the integrator settings and, for single-arc propagator settings, the termination settings (the termination
+ *  time of time conditions, and the type of the others) and the dependent variables. For translational dynamics, the
+ *  propagator type, the propagated and central bodies and the types of the acceleration models are stored as well.
+ *  The bodies and the parameters of the acceleration models are not.
+ */
+std::string serializePropagationSettings(
+        const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< tudat::propagators::PropagatorSettings< double > > propagatorSettings );
+
+//! Kind of settings object stored in a serialized string.
+SerializedSettingsType getSerializedSettingsType( const std::string& data );
+
+//! Reconstruct a settings object from a string created by serializeSettings.
+/*!
+ *  \tparam SettingsType BodySettings, AtmosphereSettings, EphemerisSettings or GravityFieldSettings; must match the
+ *  type that was serialized.
+ */
+template< typename SettingsType >
+std::shared_ptr< SettingsType > deserializeSettings( const std::string& data );
+
+//! Python __reduce__ of the serializable settings classes, reconstructing them with copyreg.__newobj__ and
+//! __setstate__ (see exposeSettingsSerialization).
+boost::python::object reduceSettings( const boost::python::object& self );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_SETTINGS_SERIALIZATION_H
@@ -0,0 +1,268 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/python.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/sphericalBodyShapeModel.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodyShapeModel.h"
+
+#include "Conversions.h"
+#include "Parallel.h"
+#include "ShapeModels.h"
+#include "SimulationSetup.h"
+
+using namespace boost::python;
+using namespace tudat::simulation_setup;
+using namespace tudat::basic_astrodynamics;
+
+namespace tudatpy
+{
+
+namespace
+{
+
+//! Number of points converted by a worker thread per task.
+const std::size_t pointsPerTask = 4096;
+
+} // namespace
+
+Eigen::Vector3d convertCartesianToGeodeticPosition( const double equatorialRadius, const double flattening,
+                                                    const Eigen::Vector3d& position )
+{
+    const double eccentricitySquared = flattening * ( 2.0 - flattening );
+    const double eccentricityToTheFourth = eccentricitySquared * eccentricitySquared;
+    const double distanceToAxisSquared = position.x( ) * position.x( ) + position.y( ) * position.y( );
+    const double distanceToAxis = std::sqrt( distanceToAxisSquared );
+
+    const double p = distanceToAxisSquared / ( equatorialRadius * equatorialRadius );
+    const double q = ( 1.0 - eccentricitySquared ) * position.z( ) * position.z( ) /
+            ( equatorialRadius * equatorialRadius );
+    const double r = ( p + q - eccentricityToTheFourth ) / 6.0;
+    const double evoluteTest = 8.0 * r * r * r + eccentricityToTheFourth * p * q;
+
+    double altitude, latitude;
+    if( distanceToAxis == 0.0 )
+    {
+        // On the polar axis, the nearest point of the spheroid is the pole (also at the center).
+        altitude = std::fabs( position.z( ) ) - equatorialRadius * ( 1.0 - flattening );
+        latitude = position.z( ) < 0.0 ? -0.5 * M_PI : 0.5 * M_PI;
+    }
+    else if( eccentricitySquared == 0.0 )
+    {
+        altitude = position.norm( ) - equatorialRadius;
+        latitude = std::atan2( position.z( ), distanceToAxis );
+    }
+    else if( evoluteTest > 0.0 || q != 0.0 )
+    {
+        double u;
+        if( evoluteTest > 0.0 )
+        {
+            // Outside the evolute of the meridian ellipse, which holds for all points not deep inside the body.
+            const double firstRoot = std::sqrt( evoluteTest );
+            const double secondRoot = std::sqrt( eccentricityToTheFourth * p * q );
+            u = r + 0.5 * std::cbrt( ( firstRoot + secondRoot ) * ( firstRoot + secondRoot ) ) +
+                    0.5 * std::cbrt( ( firstRoot - secondRoot ) * ( firstRoot - secondRoot ) );
+        }
+        else
+        {
+            const double firstRoot = std::sqrt( -evoluteTest );
+            const double secondRoot = std::sqrt( -8.0 * r * r * r );
+            const double thirdRoot = std::sqrt( eccentricityToTheFourth * p * q );
+            const double angle = 2.0 / 3.0 * std::atan2( thirdRoot, firstRoot + secondRoot );
+            u = -4.0 * r * std::sin( angle ) * std::cos( M_PI / 6.0 + angle );
+        }
+        const double v = std::sqrt( u * u + eccentricityToTheFourth * q );
+        const double w = eccentricitySquared * ( u + v - q ) / ( 2.0 * v );
+        const double k = ( u + v ) / ( std::sqrt( w * w + u + v ) + w );
+        const double d = k * distanceToAxis / ( k + eccentricitySquared );
+        const double distance = std::sqrt( d * d + position.z( ) * position.z( ) );
+        altitude = ( k + eccentricitySquared - 1.0 ) * distance / k;
+        latitude = 2.0 * std::atan2( position.z( ), distance + d );
+    }
+    else
+    {
+        // On the singular disc in the equatorial plane, inside the evolute.
+        const double eccentricity = std::sqrt( eccentricitySquared );
+        const double polarFactor = std::sqrt( 1.0 - eccentricitySquared );
+        const double equatorialFactor = std::sqrt( eccentricitySquared - p );
+        altitude = -equatorialRadius * polarFactor * equatorialFactor / eccentricity;
+        latitude = 2.0 * std::atan2( std::sqrt( eccentricityToTheFourth - p ),
+                                     eccentricity * equatorialFactor + polarFactor * std::sqrt( p ) );
+    }
+    return Eigen::Vector3d( altitude, latitude, std::atan2( position.y( ), position.x( ) ) );
+}
+
+void computeGeodeticPositions( BodyShapeModel& shapeModel, const std::size_t numberOfPoints, const double* positions,
+                               double* geodeticPositions, const unsigned int numberOfThreads )
+{
+    double equatorialRadius = 0.0, flattening = 0.0;
+    bool isClosedForm = true;
+    if( OblateSpheroidBodyShapeModel* oblateSpheroid = dynamic_cast< OblateSpheroidBodyShapeModel* >( &shapeModel ) )
+    {
+        equatorialRadius = oblateSpheroid->getEquatorialRadius( );
+        flattening = oblateSpheroid->getFlattening( );
+    }
+    else if( dynamic_cast< SphericalBodyShapeModel* >( &shapeModel ) != nullptr )
+    {
+        equatorialRadius = shapeModel.getAverageRadius( );
+    }
+    else
+    {
+        isClosedForm = false;
+    }
+
+    if( isClosedForm )
+    {
+        const std::size_t numberOfTasks = ( numberOfPoints + pointsPerTask - 1 ) / pointsPerTask;
+        parallelFor( numberOfTasks, getNumberOfThreads( numberOfThreads, numberOfTasks ),
+                     [ & ]( const std::size_t taskIndex, const unsigned int )
+        {
+            const std::size_t lastPoint = std::min( numberOfPoints, ( taskIndex + 1 ) * pointsPerTask );
+            for( std::size_t i = taskIndex * pointsPerTask; i < lastPoint; i++ )
+            {
+                Eigen::Map< Eigen::Vector3d >( geodeticPositions + 3 * i ) = convertCartesianToGeodeticPosition(
+                            equatorialRadius, flattening, Eigen::Map< const Eigen::Vector3d >( positions + 3 * i ) );
+            }
+        } );
+    }
+    else
+    {
+        for( std::size_t i = 0; i < numberOfPoints; i++ )
+        {
+            const Eigen::Map< const Eigen::Vector3d > position( positions + 3 * i );
+            geodeticPositions[ 3 * i ] = shapeModel.getAltitude( position );
+            geodeticPositions[ 3 * i + 1 ] = std::asin( position.z( ) / position.norm( ) );
+            geodeticPositions[ 3 * i + 2 ] = std::atan2( position.y( ), position.x( ) );
+        }
+    }
+}
+
+namespace
+{
+
+//! Convert the (N x 3) array of body-fixed positions passed from Python to a contiguous block of geodetic positions.
+std::vector< double > getGeodeticPositionBlock( BodyShapeModel& shapeModel, const ContiguousArray& positionArray,
+                                                const unsigned int numberOfThreads )
+{
+    if( positionArray.columns( ) != 3 )
+    {
+        throw std::runtime_error( "Error when computing geodetic positions, positions must be an (N x 3) array" );
+    }
+
+    std::vector< double > geodeticPositions( 3 * positionArray.rows( ) );
+    ScopedGilRelease gilRelease;
+    computeGeodeticPositions( shapeModel, positionArray.rows( ), positionArray.data( ), geodeticPositions.data( ),
+                              numberOfThreads );
+    return geodeticPositions;
+}
+
+object getGeodeticPositions( BodyShapeModel& shapeModel, const object& positions, const unsigned int numberOfThreads )
+{
+    const ContiguousArray positionArray( positions, 2 );
+    const std::vector< double > geodeticPositions =
+            getGeodeticPositionBlock( shapeModel, positionArray, numberOfThreads );
+
+    numpy::ndarray geodeticPositionArray = createArray( positionArray.rows( ), 3 );
+    std::copy( geodeticPositions.begin( ), geodeticPositions.end( ), getArrayData( geodeticPositionArray ) );
+    return geodeticPositionArray;
+}
+
+object getAltitudes( BodyShapeModel& shapeModel, const object& positions, const unsigned int numberOfThreads )
+{
+    const ContiguousArray positionArray( positions, 2 );
+    const std::vector< double > geodeticPositions =
+            getGeodeticPositionBlock( shapeModel, positionArray, numberOfThreads );
+
+    numpy::ndarray altitudes = createArray( positionArray.rows( ) );
+    double* altitudeData = getArrayData( altitudes );
+    for( std::size_t i = 0; i < positionArray.rows( ); i++ )
+    {
+        altitudeData[ i ] = geodeticPositions[ 3 * i ];
+    }
+    return altitudes;
+}
+
+double getAltitude( BodyShapeModel& shapeModel, const object& position )
+{
+    return shapeModel.getAltitude( extractVector( position ) );
+}
+
+void setClosedFormShapeModel( const NamedBodyMap& bodyMap, const std::string& bodyName )
+{
+    if( bodyMap.count( bodyName ) == 0 )
+    {
+        throw std::runtime_error( "Error when setting shape model, body " + bodyName + " does not exist" );
+    }
+    const std::shared_ptr< OblateSpheroidBodyShapeModel > shapeModel =
+            std::dynamic_pointer_cast< OblateSpheroidBodyShapeModel >( bodyMap.at( bodyName )->getShapeModel( ) );
+    if( shapeModel == nullptr )
+    {
+        throw std::runtime_error( "Error when setting shape model, body " + bodyName + " is not an oblate spheroid" );
+    }
+    bodyMap.at( bodyName )->setShapeModel( std::make_shared< ClosedFormOblateSpheroidBodyShapeModel >(
+                                               shapeModel->getEquatorialRadius( ), shapeModel->getFlattening( ) ) );
+}
+
+} // namespace
+
+void exposeShapeModels( )
+{
+    class_< BodyShapeSettings, std::shared_ptr< BodyShapeSettings >, boost::noncopyable >(
+                "BodyShapeSettings", no_init )
+            ;
+
+    class_< SphericalBodyShapeSettings, std::shared_ptr< SphericalBodyShapeSettings >,
+            bases< BodyShapeSettings >, boost::noncopyable >(
+                "SphericalBodyShapeSettings", init< double >( arg( "radius" ) ) )
+            ;
+
+    class_< OblateSphericalBodyShapeSettings, std::shared_ptr< OblateSphericalBodyShapeSettings >,
+            bases< BodyShapeSettings >, boost::noncopyable >(
+                "OblateSphericalBodyShapeSettings",
+                init< double, double >( ( arg( "equatorial_radius" ), arg( "flattening" ) ) ) )
+            ;
+
+    class_< BodyShapeModel, std::shared_ptr< BodyShapeModel >, boost::noncopyable >( "BodyShapeModel", no_init )
+            .add_property( "average_radius", &BodyShapeModel::getAverageRadius )
+            .def( "get_altitude", &getAltitude, arg( "body_fixed_position" ) )
+            .def( "get_geodetic_positions", &getGeodeticPositions,
+                  ( arg( "body_fixed_positions" ), arg( "number_of_threads" ) = 0 ),
+                  "Altitudes, geodetic latitudes and longitudes of an (N x 3) array of body-fixed positions, as an\n"
+                  "(N x 3) array. Oblate spheroids use the closed-form conversion of Vermeille (2011), evaluated\n"
+                  "natively on number_of_threads threads (0 for all hardware threads) with the GIL released; for\n"
+                  "shape models other than spheres and oblate spheroids, the latitudes are geocentric." )
+            .def( "get_altitudes", &getAltitudes, ( arg( "body_fixed_positions" ), arg( "number_of_threads" ) = 0 ),
+                  "Altitudes of an (N x 3) array of body-fixed positions (see get_geodetic_positions)." )
+            ;
+
+    class_< OblateSpheroidBodyShapeModel, std::shared_ptr< OblateSpheroidBodyShapeModel >, bases< BodyShapeModel >,
+            boost::noncopyable >( "OblateSpheroidBodyShapeModel", no_init )
+            .add_property( "equatorial_radius", &OblateSpheroidBodyShapeModel::getEquatorialRadius )
+            .add_property( "flattening", &OblateSpheroidBodyShapeModel::getFlattening )
+            ;
+
+    class_< ClosedFormOblateSpheroidBodyShapeModel, std::shared_ptr< ClosedFormOblateSpheroidBodyShapeModel >,
+            bases< OblateSpheroidBodyShapeModel >, boost::noncopyable >(
+                "ClosedFormOblateSpheroidBodyShapeModel", no_init )
+            ;
+
+    def( "set_closed_form_shape_model", &setClosedFormShapeModel, ( arg( "body_map" ), arg( "body_name" ) ),
+         "Replace the oblate spheroid shape model of a body by one computing altitudes with the closed-form\n"
+         "geodetic conversion. Flight conditions keep the shape model they were created with, so this should be\n"
+         "called before creating the acceleration models." );
+}
+
+} // namespace tudatpy
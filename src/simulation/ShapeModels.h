@@ -0,0 +1,79 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_SHAPE_MODELS_H
+#define TUDATPY_SHAPE_MODELS_H
+
+#include <cstddef>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/oblateSpheroidBodyShapeModel.h"
+
+namespace tudatpy
+{
+
+//! Convert a body-fixed Cartesian position to geodetic coordinates w.r.t. an oblate spheroid, without iterations.
+/*!
+ *  Uses the closed-form solution of Vermeille (2011), "An analytical method to transform geocentric into geodetic
+ *  coordinates", Journal of Geodesy 85(2), which is exact for all positions, including those inside the evolute of the
+ *  meridian ellipse (close to the center of the body). Positions on the polar axis (including the center) and spheres
+ *  (zero flattening), for which the general solution divides by zero, are converted directly. At the center, the
+ *  altitude is minus the polar radius, and the latitude is that of the north pole.
+ *  \param equatorialRadius Equatorial radius of the spheroid.
+ *  \param flattening Flattening of the spheroid.
+ *  \param position Body-fixed Cartesian position.
+ *  \return Altitude, geodetic latitude and longitude.
+ */
+Eigen::Vector3d convertCartesianToGeodeticPosition( const double equatorialRadius, const double flattening,
+                                                    const Eigen::Vector3d& position );
+
+//! Oblate spheroid shape model computing the altitude with the closed-form geodetic conversion.
+/*!
+ *  Replaces the iterative conversion of the Tudat model, for instance in the flight conditions of a propagation (which
+ *  compute the altitude at every integrator stage).
+ */
+class ClosedFormOblateSpheroidBodyShapeModel: public tudat::basic_astrodynamics::OblateSpheroidBodyShapeModel
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  \param equatorialRadius Equatorial radius of the spheroid.
+     *  \param flattening Flattening of the spheroid.
+     */
+    ClosedFormOblateSpheroidBodyShapeModel( const double equatorialRadius, const double flattening ):
+        OblateSpheroidBodyShapeModel( equatorialRadius, flattening )
+    { }
+
+    double getAltitude( const Eigen::Vector3d& bodyFixedPosition )
+    {
+        return convertCartesianToGeodeticPosition( getEquatorialRadius( ), getFlattening( ), bodyFixedPosition ).x( );
+    }
+};
+
+//! Compute the geodetic coordinates of a series of body-fixed positions w.r.t. a shape model.
+/*!
+ *  Oblate spheroids are evaluated with the closed-form conversion and spheres directly, with the points distributed
+ *  over the worker threads; for other shape models, only the altitude is defined (the latitude is geocentric), and
+ *  the points are evaluated serially by the model. Does not touch any Python object, so that it may be called with the
+ *  GIL released.
+ *  \param shapeModel Shape model to evaluate.
+ *  \param numberOfPoints Number of points.
+ *  \param positions Row-major (numberOfPoints x 3) block of body-fixed positions.
+ *  \param geodeticPositions Row-major (numberOfPoints x 3) block to which the altitudes, latitudes and longitudes are
+ *  written.
+ *  \param numberOfThreads Number of worker threads (0 selects the number of hardware threads).
+ */
+void computeGeodeticPositions( tudat::basic_astrodynamics::BodyShapeModel& shapeModel,
+                               const std::size_t numberOfPoints, const double* positions, double* geodeticPositions,
+                               const unsigned int numberOfThreads );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_SHAPE_MODELS_H
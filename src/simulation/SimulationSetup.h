@@ -0,0 +1,73 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_SIMULATION_SETUP_H
+#define TUDATPY_SIMULATION_SETUP_H
+
+namespace tudatpy
+{
+
+//! Expose the complete simulation_setup module in the current scope (initializing NumPy first).
+void exposeSimulationSetup( );
+
+//! Expose the body settings, bodies and body creation functions in the current scope.
+void exposeEnvironmentSetup( );
+
+//! Expose the ephemerides, ephemeris settings and ephemeris caches in the current scope.
+void exposeEphemerides( );
+
+//! Expose the rotation models and their tabulation in the current scope.
+void exposeRotationModels( );
+
+//! Expose the atmosphere models and their settings in the current scope.
+void exposeAtmosphereModels( );
+
+//! Expose the gravity field models and their settings in the current scope.
+void exposeGravityFieldModels( );
+
+//! Expose the ground station settings and link geometry functions in the current scope.
+void exposeGroundStations( );
+
+//! Expose the body shape models and their vectorized geodetic conversion in the current scope.
+void exposeShapeModels( );
+
+//! Expose the radiation pressure interfaces and the batch shadow function computation in the current scope.
+void exposeRadiationPressure( );
+
+//! Expose the integrator, termination, acceleration and propagator settings in the current scope.
+void exposePropagationSetup( );
+
+//! Expose the acceleration models and their batch evaluation in the current scope.
+void exposeAccelerationModels( );
+
+//! Expose the dynamics simulators in the current scope.
+void exposeDynamicsSimulator( );
+
+//! Expose the dense trajectory returned by SingleArcDynamicsSimulator.integrate_equations_of_motion_dense.
+void exposeDenseOutput( );
+
+//! Expose the parallel batch propagation functions in the current scope.
+void exposeBatchPropagation( );
+
+//! Expose the asynchronous propagation function and its futures in the current scope.
+void exposeAsyncPropagation( );
+
+//! Expose the incremental propagation of variations of a baseline in the current scope.
+void exposeIncrementalPropagation( );
+
+//! Expose the Monte Carlo runner in the current scope.
+void exposeMonteCarlo( );
+
+//! Add pickling support to the (previously exposed) settings classes in the current scope.
+void exposeSettingsSerialization( );
+
+} // namespace tudatpy
+
+#endif // TUDATPY_SIMULATION_SETUP_H
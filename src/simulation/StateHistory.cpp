@@ -0,0 +1,62 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include "StateHistory.h"
+
+namespace tudatpy
+{
+
+StateHistory::StateHistory( const std::map< double, Eigen::VectorXd >& history ):
+    stateSize_( history.empty( ) ? 0 : history.begin( )->second.rows( ) )
+{
+    epochs_.reserve( history.size( ) );
+    states_.reserve( history.size( ) * stateSize_ );
+    for( auto historyIterator = history.begin( ); historyIterator != history.end( ); historyIterator++ )
+    {
+        if( static_cast< std::size_t >( historyIterator->second.rows( ) ) != stateSize_ )
+        {
+            throw std::runtime_error( "Error when creating state history, state sizes are inconsistent" );
+        }
+        epochs_.push_back( historyIterator->first );
+        states_.insert( states_.end( ), historyIterator->second.data( ),
+                        historyIterator->second.data( ) + stateSize_ );
+    }
+}
+
+void StateHistory::append( const double epoch, const double* state, const std::size_t stateSize )
+{
+    if( epochs_.empty( ) )
+    {
+        stateSize_ = stateSize;
+    }
+    else if( stateSize != stateSize_ )
+    {
+        throw std::runtime_error( "Error when appending to state history, state sizes are inconsistent" );
+    }
+    epochs_.push_back( epoch );
+    states_.insert( states_.end( ), state, state + stateSize_ );
+}
+
+void StateHistory::reserve( const std::size_t numberOfEntries )
+{
+    epochs_.reserve( numberOfEntries );
+    states_.reserve( numberOfEntries * stateSize_ );
+}
+
+void StateHistory::clear( )
+{
+    epochs_.clear( );
+    states_.clear( );
+    stateSize_ = 0;
+}
+
+} // namespace tudatpy
@@ -0,0 +1,105 @@
+/*    Copyright (c) 2010-2018, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_STATE_HISTORY_H
+#define TUDATPY_STATE_HISTORY_H
+
+#include <map>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudatpy
+{
+
+//! Contiguous storage of a propagated state history.
+/*!
+ *  Epochs and states are stored in two flat arrays (epochs, and states as a row-major (N x stateSize) block), so that
+ *  they can be handed to NumPy without copying.
+ */
+class StateHistory
+{
+public:
+
+    //! Constructor for an empty history.
+    StateHistory( ): stateSize_( 0 ) { }
+
+    //! Constructor, flattening a history as stored by the Tudat dynamics simulators.
+    /*!
+     *  \param history State history, with the epoch as key. All states must have the same size.
+     */
+    explicit StateHistory( const std::map< double, Eigen::VectorXd >& history );
+
+    //! Append an entry, after the last one.
+    /*!
+     *  The storage grows geometrically, so that appending is amortized constant time, without an allocation per
+     *  entry. The first entry appended to an empty history sets its state size.
+     *  \param epoch Epoch of the entry.
+     *  \param state State at the epoch.
+     */
+    void append( const double epoch, const Eigen::VectorXd& state )
+    {
+        append( epoch, state.data( ), state.rows( ) );
+    }
+
+    //! Append an entry, after the last one (see above), from a contiguous block of stateSize values.
+    void append( const double epoch, const double* state, const std::size_t stateSize );
+
+    //! Reserve storage for a number of entries (of the current state size).
+    void reserve( const std::size_t numberOfEntries );
+
+    //! Remove all entries.
+    void clear( );
+
+    //! Number of stored epochs.
+    std::size_t size( ) const
+    {
+        return epochs_.size( );
+    }
+
+    //! Size of a single state vector.
+    std::size_t getStateSize( ) const
+    {
+        return stateSize_;
+    }
+
+    //! Stored epochs.
+    const std::vector< double >& getEpochs( ) const
+    {
+        return epochs_;
+    }
+
+    //! Stored states, as a row-major (size( ) x getStateSize( )) block.
+    const std::vector< double >& getStates( ) const
+    {
+        return states_;
+    }
+
+    //! Pointer to the state at the given index.
+    const double* getState( const std::size_t index ) const
+    {
+        return states_.data( ) + index * stateSize_;
+    }
+
+private:
+
+    //! Stored epochs.
+    std::vector< double > epochs_;
+
+    //! Stored states (row-major).
+    std::vector< double > states_;
+
+    //! Size of a single state vector.
+    std::size_t stateSize_;
+};
+
+} // namespace tudatpy
+
+#endif // TUDATPY_STATE_HISTORY_H
@@ -0,0 +1,37 @@
+"""Point-mass propagation of a vehicle about the Earth, without SPICE, shared by the simulation tests."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+EARTH_GRAVITATIONAL_PARAMETER = 3.986004418E14
+INITIAL_STATE = [7.0E6, 0.0, 0.0, 0.0, np.sqrt(EARTH_GRAVITATIONAL_PARAMETER / 7.0E6), 0.0]
+
+
+def create_body_settings():
+    body_settings = {'Earth': setup.BodySettings(), 'Vehicle': setup.BodySettings()}
+    body_settings['Earth'].gravity_field_settings = setup.CentralGravityFieldSettings(EARTH_GRAVITATIONAL_PARAMETER)
+    body_settings['Vehicle'].constant_mass = 1000.0
+    return body_settings
+
+
+def create_bodies():
+    return setup.create_bodies(create_body_settings(), 'Earth', 'J2000')
+
+
+def create_propagator_settings(bodies, termination_time, initial_state=INITIAL_STATE,
+                               propagator=setup.TranslationalPropagatorType.cowell, dependent_variables_to_save=()):
+    selected_accelerations = {'Vehicle': {
+        'Earth': [setup.AccelerationSettings(setup.AvailableAcceleration.point_mass_gravity)]}}
+    acceleration_models = setup.create_acceleration_models(bodies, selected_accelerations, ['Vehicle'], ['Earth'])
+    return setup.TranslationalStatePropagatorSettings(
+        ['Earth'], acceleration_models, ['Vehicle'], initial_state,
+        setup.PropagationTimeTerminationSettings(termination_time), propagator, list(dependent_variables_to_save))
+
+
+def create_rk4_settings(time_step=10.0):
+    return setup.IntegratorSettings(setup.AvailableIntegrators.runge_kutta_4, 0.0, time_step)
+
+
+def create_variable_step_settings():
+    return setup.RungeKuttaVariableStepSizeSettings(
+        0.0, 10.0, setup.RungeKuttaCoefficientSets.runge_kutta_fehlberg_78, 1.0E-3, 300.0, 1.0E-12, 1.0E-12)
@@ -1,4 +1,3 @@
-
-from simulation_setup import BodySettings
+from tudatpy.core.simulation_setup import BodySettings
 
 test = BodySettings()
@@ -0,0 +1,50 @@
+"""Asynchronous propagations equal synchronous ones, and pending propagations can be cancelled."""
+import asyncio
+import concurrent.futures
+import time
+
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+bodies = point_mass_setup.create_bodies()
+integrator_settings = point_mass_setup.create_rk4_settings()
+simulator = setup.SingleArcDynamicsSimulator(
+    bodies, integrator_settings, point_mass_setup.create_propagator_settings(bodies, 3600.0))
+expected_epochs = simulator.state_history_epochs.copy()
+expected_states = simulator.state_history.copy()
+
+
+async def propagate():
+    return await setup.propagate_async(
+        bodies, integrator_settings, point_mass_setup.create_propagator_settings(bodies, 3600.0))
+
+result = asyncio.run(propagate())
+assert np.array_equal(result.state_history_epochs, expected_epochs)
+assert np.array_equal(result.state_history, expected_states)
+
+# A propagation sharing the bodies of a running one is pending until that one is done, so it can be cancelled; the
+# cancelled propagation does not hold the bodies, so that later propagations using them still run.
+long_future = setup.propagate_async(
+    bodies, point_mass_setup.create_rk4_settings(1.0), point_mass_setup.create_propagator_settings(bodies, 5.0E5),
+    setup.HistoryStorage.contiguous)
+while not long_future.running() and not long_future.done():
+    time.sleep(1.0E-3)
+pending_futures = [setup.propagate_async(
+    bodies, integrator_settings, point_mass_setup.create_propagator_settings(bodies, 3600.0)) for _ in range(3)]
+assert long_future.running()
+assert all(future.cancel() for future in pending_futures[:2])
+assert all(future.cancelled() for future in pending_futures[:2])
+try:
+    pending_futures[0].result()
+except concurrent.futures.CancelledError:
+    pass
+else:
+    raise AssertionError('Cancelled propagation returned a result')
+
+assert long_future.result().state_history_epochs[-1] == 5.0E5
+result = pending_futures[2].result()
+assert np.array_equal(result.state_history_epochs, expected_epochs)
+assert np.array_equal(result.state_history, expected_states)
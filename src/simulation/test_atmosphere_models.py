@@ -0,0 +1,75 @@
+"""Batched atmosphere evaluations match point-by-point evaluations, also when run from several threads."""
+import os
+import shutil
+import tempfile
+import threading
+
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+SCALE_HEIGHT = 7.2E3
+CONSTANT_TEMPERATURE = 290.0
+DENSITY_AT_ZERO_ALTITUDE = 1.225
+
+
+def get_point_densities(atmosphere_model, altitudes, longitudes, latitudes, times):
+    return np.array([atmosphere_model.get_density(altitude, longitude, latitude, time)[0]
+                     for altitude, longitude, latitude, time in zip(altitudes, longitudes, latitudes, times)])
+
+
+def get_densities_from_threads(atmosphere_model, altitudes, number_of_threads=4):
+    densities = [None] * number_of_threads
+
+    def evaluate(thread_index):
+        for _ in range(20):
+            densities[thread_index] = atmosphere_model.get_density(altitudes[thread_index::number_of_threads])
+    threads = [threading.Thread(target=evaluate, args=(i,)) for i in range(number_of_threads)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    return densities
+
+
+random_generator = np.random.RandomState(0)
+altitudes = random_generator.uniform(0.0, 5.0E5, size=2000)
+longitudes = random_generator.uniform(-np.pi, np.pi, size=len(altitudes))
+latitudes = random_generator.uniform(-0.5 * np.pi, 0.5 * np.pi, size=len(altitudes))
+times = random_generator.uniform(0.0, 86400.0, size=len(altitudes))
+
+# Exponential atmosphere, evaluated with a dedicated kernel.
+exponential_atmosphere = setup.create_atmosphere_model(
+    setup.ExponentialAtmosphereSettings(SCALE_HEIGHT, CONSTANT_TEMPERATURE, DENSITY_AT_ZERO_ALTITUDE), 'Earth')
+densities = exponential_atmosphere.get_density(altitudes, longitudes, latitudes, times)
+assert np.allclose(densities, DENSITY_AT_ZERO_ALTITUDE * np.exp(-altitudes / SCALE_HEIGHT), rtol=1.0E-14, atol=0.0)
+assert np.allclose(densities, get_point_densities(exponential_atmosphere, altitudes, longitudes, latitudes, times),
+                   rtol=1.0E-14, atol=0.0)
+assert np.array_equal(exponential_atmosphere.get_temperature(altitudes),
+                      np.full(len(altitudes), CONSTANT_TEMPERATURE))
+thread_densities = get_densities_from_threads(exponential_atmosphere, altitudes)
+for thread_index, thread_density in enumerate(thread_densities):
+    assert np.array_equal(thread_density, densities[thread_index::len(thread_densities)])
+
+# Tabulated atmosphere, whose interpolators store the interval found by their last lookup.
+directory = tempfile.mkdtemp()
+try:
+    table_altitudes = np.arange(0.0, 1.0E6 + 1.0, 1.0E3)
+    table_temperatures = 190.0 + 100.0 * np.exp(-table_altitudes / 1.0E5)
+    table_densities = DENSITY_AT_ZERO_ALTITUDE * np.exp(-table_altitudes / SCALE_HEIGHT)
+    table_pressures = table_densities * 287.0 * table_temperatures
+    table_file_path = os.path.join(directory, 'atmosphere.dat')
+    np.savetxt(table_file_path,
+               np.column_stack((table_altitudes, table_densities, table_pressures, table_temperatures)))
+    tabulated_atmosphere = setup.create_atmosphere_model(setup.TabulatedAtmosphereSettings(table_file_path), 'Earth')
+
+    densities = tabulated_atmosphere.get_density(altitudes, longitudes, latitudes, times)
+    assert np.array_equal(densities,
+                          get_point_densities(tabulated_atmosphere, altitudes, longitudes, latitudes, times))
+    assert np.allclose(tabulated_atmosphere.get_density(table_altitudes[:500]), table_densities[:500],
+                       rtol=1.0E-12, atol=0.0)
+    thread_densities = get_densities_from_threads(tabulated_atmosphere, altitudes)
+    for thread_index, thread_density in enumerate(thread_densities):
+        assert np.array_equal(thread_density, densities[thread_index::len(thread_densities)])
+finally:
+    shutil.rmtree(directory)
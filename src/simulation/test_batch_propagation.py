@@ -0,0 +1,34 @@
+"""Batch propagations on several threads equal serial propagations by the Tudat simulator, bit for bit."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+selected_accelerations = {'Vehicle': {
+    'Earth': [setup.AccelerationSettings(setup.AvailableAcceleration.point_mass_gravity)]}}
+random_generator = np.random.RandomState(0)
+initial_states = np.array(point_mass_setup.INITIAL_STATE) * random_generator.uniform(0.9, 1.1, size=(16, 6))
+termination_settings = setup.PropagationTimeTerminationSettings(3600.0)
+bodies = point_mass_setup.create_bodies()
+
+for integrator_settings in [point_mass_setup.create_rk4_settings(),
+                            point_mass_setup.create_variable_step_settings()]:
+    expected = []
+    for initial_state in initial_states:
+        propagator_settings = point_mass_setup.create_propagator_settings(bodies, 3600.0, initial_state)
+        simulator = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings)
+        expected.append((simulator.state_history_epochs.copy(), simulator.state_history.copy()))
+
+    for number_of_threads in [1, 4]:
+        state_histories = setup.propagate_batch(
+            point_mass_setup.create_body_settings(), selected_accelerations, ['Vehicle'], ['Earth'], initial_states,
+            termination_settings, integrator_settings, number_of_threads, 'Earth', 'J2000')
+        assert len(state_histories) == len(initial_states)
+        for state_history, (expected_epochs, expected_states) in zip(state_histories, expected):
+            assert np.array_equal(state_history.epochs, expected_epochs)
+            assert np.array_equal(state_history.states, expected_states)
+
+    # The settings passed in are not modified by the propagations.
+    assert integrator_settings.initial_time == 0.0
+    assert termination_settings.termination_time == 3600.0
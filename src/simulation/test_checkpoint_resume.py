@@ -0,0 +1,41 @@
+"""A propagation resumed from an interrupted checkpoint file equals an uninterrupted one, bit for bit."""
+import os
+import tempfile
+
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+bodies = point_mass_setup.create_bodies()
+propagator_settings = point_mass_setup.create_propagator_settings(bodies, 3600.0)
+checkpoint_path = os.path.join(tempfile.mkdtemp(), 'propagation.checkpoint')
+
+for integrator_settings in [point_mass_setup.create_rk4_settings(),
+                            point_mass_setup.create_variable_step_settings()]:
+    reference = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, True,
+                                                 setup.HistoryStorage.contiguous)
+
+    # A checkpoint after every step, of which the file is then cut in the middle, as if the process was stopped.
+    simulator = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, False)
+    simulator.integrate_equations_of_motion_with_checkpoints(point_mass_setup.INITIAL_STATE, checkpoint_path, 0.0)
+    assert np.array_equal(simulator.state_history, reference.state_history)
+    with open(checkpoint_path, 'r+b') as checkpoint_file:
+        checkpoint_file.truncate(os.path.getsize(checkpoint_path) * 3 // 5)
+
+    resumed = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, False)
+    resumed.integrate_equations_of_motion_with_checkpoints(point_mass_setup.INITIAL_STATE, checkpoint_path, 0.0)
+    assert np.array_equal(resumed.state_history_epochs, reference.state_history_epochs)
+    assert np.array_equal(resumed.state_history, reference.state_history)
+
+    # Checkpoints of a propagation with other settings are rejected.
+    other_settings = point_mass_setup.create_propagator_settings(bodies, 7200.0)
+    other = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, other_settings, False)
+    try:
+        other.integrate_equations_of_motion_with_checkpoints(point_mass_setup.INITIAL_STATE, checkpoint_path, 0.0)
+    except RuntimeError:
+        pass
+    else:
+        raise AssertionError('checkpoints of a propagation with other settings were resumed')
+    os.remove(checkpoint_path)
@@ -0,0 +1,37 @@
+"""Hermite dense output between the steps of a variable step propagation agrees with a fine-step propagation."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+bodies = point_mass_setup.create_bodies()
+propagator_settings = point_mass_setup.create_propagator_settings(bodies, 3600.0)
+
+# Steps of at most 60 s, over which the interpolation error is below 1E-4 m.
+integrator_settings = setup.RungeKuttaVariableStepSizeSettings(
+    0.0, 10.0, setup.RungeKuttaCoefficientSets.runge_kutta_fehlberg_78, 1.0E-3, 60.0, 1.0E-12, 1.0E-12)
+trajectory = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, False
+                                              ).integrate_equations_of_motion_dense(point_mass_setup.INITIAL_STATE)
+assert np.all(np.diff(trajectory.epochs) > 0.0)
+assert np.array_equal(trajectory.evaluate(trajectory.epochs), trajectory.states)
+
+# RK4 with a step of 1 s is accurate to well below the tolerances below.
+reference = setup.SingleArcDynamicsSimulator(bodies, point_mass_setup.create_rk4_settings(1.0), propagator_settings,
+                                             True, setup.HistoryStorage.contiguous)
+is_within_trajectory = reference.state_history_epochs <= trajectory.final_epoch
+epochs = reference.state_history_epochs[is_within_trajectory]
+errors = trajectory.evaluate(epochs) - reference.state_history[is_within_trajectory]
+assert np.max(np.linalg.norm(errors[:, :3], axis=1)) < 1.0E-2
+assert np.max(np.linalg.norm(errors[:, 3:], axis=1)) < 1.0E-5
+
+# Dense output is only defined for the Cowell propagator, which is checked before propagating.
+encke_settings = point_mass_setup.create_propagator_settings(
+    bodies, 3600.0, propagator=setup.TranslationalPropagatorType.encke)
+try:
+    setup.SingleArcDynamicsSimulator(bodies, integrator_settings, encke_settings, False
+                                     ).integrate_equations_of_motion_dense(point_mass_setup.INITIAL_STATE)
+except RuntimeError:
+    pass
+else:
+    raise AssertionError('dense output of an Encke propagation was created')
@@ -0,0 +1,45 @@
+"""Deferred dependent variables equal those computed during the propagation, at the same epochs."""
+import os
+import tempfile
+
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+bodies = point_mass_setup.create_bodies()
+variables = setup.PropagationDependentVariables
+dependent_variables = [
+    setup.SingleDependentVariableSaveSettings(variables.relative_position, 'Vehicle', 'Earth'),
+    setup.SingleDependentVariableSaveSettings(variables.relative_distance, 'Vehicle', 'Earth'),
+    setup.SingleDependentVariableSaveSettings(variables.relative_velocity, 'Vehicle', 'Earth'),
+    setup.SingleDependentVariableSaveSettings(variables.total_acceleration, 'Vehicle')]
+propagator_settings = point_mass_setup.create_propagator_settings(
+    bodies, 3600.0, dependent_variables_to_save=dependent_variables)
+
+for integrator_settings in [point_mass_setup.create_rk4_settings(),
+                            point_mass_setup.create_variable_step_settings()]:
+    reference = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings)
+    assert reference.dependent_variable_history.shape == (len(reference.state_history_epochs), 3 + 1 + 3 + 3)
+    assert np.array_equal(reference.dependent_variable_history[:, :3], reference.state_history[:, :3])
+    assert np.array_equal(reference.dependent_variable_history[:, 4:7], reference.state_history[:, 3:])
+
+    for history_storage in [setup.HistoryStorage.map, setup.HistoryStorage.contiguous]:
+        deferred = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, True,
+                                                    history_storage, defer_dependent_variables=True)
+        assert np.array_equal(deferred.state_history_epochs, reference.state_history_epochs)
+        assert np.array_equal(deferred.state_history, reference.state_history)
+        assert np.allclose(deferred.dependent_variable_history, reference.dependent_variable_history,
+                           rtol=1.0E-12, atol=1.0E-12)
+
+    # Streamed to a file, the deferred dependent variables are computed as each epoch is written.
+    file_path = os.path.join(tempfile.mkdtemp(), 'output.bin')
+    streamed = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, False,
+                                                defer_dependent_variables=True)
+    streamed.integrate_equations_of_motion_to_file(point_mass_setup.INITIAL_STATE, file_path, 64)
+    output = setup.ChunkedOutputFile(file_path)
+    assert output.dependent_variable_size == 10
+    for column in range(10):
+        assert np.allclose(output.read_column(1 + 6 + column), reference.dependent_variable_history[:, column],
+                           rtol=1.0E-12, atol=1.0E-12)
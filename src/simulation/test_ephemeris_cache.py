@@ -0,0 +1,59 @@
+"""An ephemeris cache reproduces the SPICE states it was generated from, and rejects corrupted headers."""
+import os
+import shutil
+import struct
+import tempfile
+
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+# Byte offsets of the number of epochs and of the time step in the cache file header.
+NUMBER_OF_EPOCHS_OFFSET = 16
+TIME_STEP_OFFSET = 32
+
+setup.load_standard_spice_kernels()
+
+directory = tempfile.mkdtemp()
+try:
+    file_path = os.path.join(directory, 'ephemerides.cache')
+    setup.generate_ephemeris_cache(file_path, ['Earth', 'Moon'], 0.0, 86400.0, 300.0)
+    cache = setup.EphemerisCache(file_path)
+    assert sorted(cache.body_names) == ['Earth', 'Moon']
+    assert cache.initial_time == 0.0 and cache.final_time == 86400.0
+
+    grid_epochs = np.arange(0.0, 86401.0, 300.0)
+    random_generator = np.random.RandomState(0)
+    epochs = np.concatenate([random_generator.uniform(0.0, 86400.0, size=2000), [86400.0]])
+    for body_name in ['Earth', 'Moon']:
+        spice_ephemeris = setup.create_body_ephemeris(setup.DirectSpiceEphemerisSettings(), body_name)
+        cached_ephemeris = cache.get_ephemeris(body_name)
+        assert cached_ephemeris.frame_origin == 'SSB' and cached_ephemeris.frame_orientation == 'ECLIPJ2000'
+
+        # The grid points are returned as written, other epochs are interpolated to well below 1 m and 1 mm/s.
+        assert np.array_equal(cached_ephemeris.get_cartesian_state(grid_epochs),
+                              spice_ephemeris.get_cartesian_state(grid_epochs))
+        difference = cached_ephemeris.get_cartesian_state(epochs) - spice_ephemeris.get_cartesian_state(epochs)
+        assert np.max(np.linalg.norm(difference[:, :3], axis=1)) < 1.0E-3
+        assert np.max(np.linalg.norm(difference[:, 3:], axis=1)) < 1.0E-6
+
+    # Headers with an invalid time step, or a number of epochs that does not fit in the file, are rejected.
+    corrupted_headers = [(TIME_STEP_OFFSET, struct.pack('<d', 0.0)),
+                         (TIME_STEP_OFFSET, struct.pack('<d', -300.0)),
+                         (TIME_STEP_OFFSET, struct.pack('<d', float('nan'))),
+                         (NUMBER_OF_EPOCHS_OFFSET, struct.pack('<Q', 2 ** 62)),
+                         (NUMBER_OF_EPOCHS_OFFSET, struct.pack('<Q', 2 ** 64 - 1))]
+    for offset, value in corrupted_headers:
+        corrupted_file_path = os.path.join(directory, 'corrupted.cache')
+        shutil.copyfile(file_path, corrupted_file_path)
+        with open(corrupted_file_path, 'r+b') as corrupted_file:
+            corrupted_file.seek(offset)
+            corrupted_file.write(value)
+        try:
+            setup.EphemerisCache(corrupted_file_path)
+        except RuntimeError:
+            pass
+        else:
+            raise AssertionError('Corrupted ephemeris cache header was accepted')
+finally:
+    shutil.rmtree(directory)
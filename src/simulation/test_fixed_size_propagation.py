@@ -0,0 +1,45 @@
+"""The fixed-size propagation agrees with the Tudat simulator for the same settings."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+bodies = point_mass_setup.create_bodies()
+
+# RK4, with the termination time a multiple of the step size: the same steps, up to round-off.
+propagator_settings = point_mass_setup.create_propagator_settings(bodies, 3600.0)
+integrator_settings = point_mass_setup.create_rk4_settings()
+reference = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings)
+fixed_size = setup.propagate_fixed_size_translational(bodies, integrator_settings, propagator_settings)
+assert np.array_equal(fixed_size.epochs, reference.state_history_epochs)
+assert np.allclose(fixed_size.states, reference.state_history, rtol=1.0E-10, atol=0.0)
+
+# RKF78 with the same step size control, both ending on the termination time.
+selected_accelerations = {'Vehicle': {
+    'Earth': [setup.AccelerationSettings(setup.AvailableAcceleration.point_mass_gravity)]}}
+acceleration_models = setup.create_acceleration_models(bodies, selected_accelerations, ['Vehicle'], ['Earth'])
+exact_propagator_settings = setup.TranslationalStatePropagatorSettings(
+    ['Earth'], acceleration_models, ['Vehicle'], point_mass_setup.INITIAL_STATE,
+    setup.PropagationTimeTerminationSettings(3600.0, True))
+integrator_settings = point_mass_setup.create_variable_step_settings()
+reference = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, exact_propagator_settings)
+fixed_size = setup.propagate_fixed_size_translational(bodies, integrator_settings, exact_propagator_settings)
+assert fixed_size.epochs[-1] == 3600.0
+assert abs(reference.state_history_epochs[-1] - 3600.0) < 1.0E-6
+assert np.allclose(fixed_size.states[-1, :3], reference.state_history[-1, :3], rtol=0.0, atol=1.0E-3)
+assert np.allclose(fixed_size.states[-1, 3:], reference.state_history[-1, 3:], rtol=0.0, atol=1.0E-6)
+
+# Settings outside the supported subset are rejected rather than ignored.
+dependent_variables = [setup.SingleDependentVariableSaveSettings(
+    setup.PropagationDependentVariables.relative_distance, 'Vehicle', 'Earth')]
+for unsupported_settings in [
+        point_mass_setup.create_propagator_settings(bodies, 3600.0, dependent_variables_to_save=dependent_variables),
+        point_mass_setup.create_propagator_settings(bodies, 3600.0,
+                                                    propagator=setup.TranslationalPropagatorType.encke)]:
+    try:
+        setup.propagate_fixed_size_translational(bodies, point_mass_setup.create_rk4_settings(), unsupported_settings)
+    except RuntimeError:
+        pass
+    else:
+        raise AssertionError('unsupported settings were propagated')
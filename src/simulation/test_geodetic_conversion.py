@@ -0,0 +1,67 @@
+"""The closed-form geodetic conversion agrees with Tudat's iterative one, including at the poles and the center."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+EQUATORIAL_RADIUS = 6378137.0
+FLATTENING = 1.0 / 298.257223563
+POLAR_RADIUS = EQUATORIAL_RADIUS * (1.0 - FLATTENING)
+
+
+def convert_iteratively(positions):
+    """Fixed-point iteration on the offset of the intercept of the normal with the polar axis."""
+    eccentricity_squared = FLATTENING * (2.0 - FLATTENING)
+    distances_to_axis = np.hypot(positions[:, 0], positions[:, 1])
+    offsets = eccentricity_squared * positions[:, 2]
+    for _ in range(100):
+        sine_latitudes = (positions[:, 2] + offsets) / np.hypot(distances_to_axis, positions[:, 2] + offsets)
+        normal_radii = EQUATORIAL_RADIUS / np.sqrt(1.0 - eccentricity_squared * sine_latitudes ** 2)
+        offsets = eccentricity_squared * normal_radii * sine_latitudes
+    return np.column_stack([np.hypot(distances_to_axis, positions[:, 2] + offsets) - normal_radii,
+                            np.arctan2(positions[:, 2] + offsets, distances_to_axis),
+                            np.arctan2(positions[:, 1], positions[:, 0])])
+
+
+body_settings = point_mass_setup.create_body_settings()
+body_settings['Earth'].shape_model_settings = setup.OblateSphericalBodyShapeSettings(EQUATORIAL_RADIUS, FLATTENING)
+bodies = setup.create_bodies(body_settings, 'Earth', 'J2000')
+shape_model = bodies['Earth'].shape_model
+
+# Points from deep inside the body to far above it, and on the polar axis (except the center, see below). Points in
+# the equatorial plane inside the evolute of the meridian ellipse (within 43 km of the center) are excluded, as the
+# iteration converges to the equatorial foot point there rather than to the nearest point of the spheroid.
+random_generator = np.random.RandomState(0)
+directions = random_generator.normal(size=(10000, 3))
+directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+positions = directions * random_generator.uniform(1.0E5, 5.0E7, size=(10000, 1))
+polar_positions = np.array([[0.0, 0.0, z] for z in [POLAR_RADIUS, -POLAR_RADIUS, 7.0E6, -7.0E6, 1.0E3, -1.0E3]])
+positions = np.vstack([positions, polar_positions])
+
+geodetic_positions = shape_model.get_geodetic_positions(positions)
+iterative_altitudes = np.array([shape_model.get_altitude(position) for position in positions])
+assert np.allclose(geodetic_positions[:, 0], iterative_altitudes, rtol=0.0, atol=1.0E-3)
+reference = convert_iteratively(positions)
+assert np.allclose(geodetic_positions[:, 0], reference[:, 0], rtol=0.0, atol=1.0E-6)
+assert np.allclose(geodetic_positions[:, 1], reference[:, 1], rtol=0.0, atol=1.0E-12)
+assert np.allclose(geodetic_positions[:, 2], reference[:, 2], rtol=0.0, atol=1.0E-12)
+assert np.array_equal(geodetic_positions[-6:, 1], [np.pi / 2, -np.pi / 2] * 3)
+
+# At the center, the nearest points of the spheroid are the poles.
+center = shape_model.get_geodetic_positions(np.zeros((1, 3)))[0]
+assert np.allclose(center, [-POLAR_RADIUS, np.pi / 2, 0.0], rtol=0.0, atol=1.0E-6)
+
+# With zero flattening, the conversion is that of a sphere.
+body_settings['Earth'].shape_model_settings = setup.OblateSphericalBodyShapeSettings(EQUATORIAL_RADIUS, 0.0)
+spherical_shape_model = setup.create_bodies(body_settings, 'Earth', 'J2000')['Earth'].shape_model
+spherical_positions = spherical_shape_model.get_geodetic_positions(positions)
+assert np.allclose(spherical_positions[:, 0], np.linalg.norm(positions, axis=1) - EQUATORIAL_RADIUS,
+                   rtol=0.0, atol=1.0E-6)
+assert np.allclose(spherical_positions[:, 1], np.arctan2(positions[:, 2], np.hypot(positions[:, 0], positions[:, 1])),
+                   rtol=0.0, atol=1.0E-12)
+
+# The shape model set by set_closed_form_shape_model uses the same conversion.
+setup.set_closed_form_shape_model(bodies, 'Earth')
+closed_form_altitudes = np.array([bodies['Earth'].shape_model.get_altitude(position) for position in positions])
+assert np.array_equal(closed_form_altitudes, geodetic_positions[:, 0])
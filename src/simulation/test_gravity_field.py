@@ -0,0 +1,52 @@
+"""Batched spherical harmonic accelerations agree with Tudat's, for full and truncated fields, on any thread count."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+GRAVITATIONAL_PARAMETER = 3.986004418E14
+REFERENCE_RADIUS = 6378137.0
+DEGREE = 8
+
+
+def create_field(cosine_coefficients, sine_coefficients):
+    settings = setup.SphericalHarmonicsGravityFieldSettings(
+        GRAVITATIONAL_PARAMETER, REFERENCE_RADIUS, cosine_coefficients, sine_coefficients, 'IAU_Earth')
+    return setup.create_gravity_field_model(settings, 'Earth')
+
+
+random_generator = np.random.RandomState(0)
+cosine_coefficients = np.tril(random_generator.uniform(-1.0E-6, 1.0E-6, size=(DEGREE + 1, DEGREE + 1)))
+sine_coefficients = np.tril(random_generator.uniform(-1.0E-6, 1.0E-6, size=(DEGREE + 1, DEGREE + 1)))
+cosine_coefficients[0, 0] = 1.0
+cosine_coefficients[1, :] = 0.0
+sine_coefficients[:, 0] = 0.0
+sine_coefficients[1, :] = 0.0
+cosine_coefficients[2, 0] = -4.84165E-4
+field = create_field(cosine_coefficients, sine_coefficients)
+
+# Enough points for several tasks per thread, so that the per-thread caches are reused across points.
+directions = random_generator.normal(size=(3000, 3))
+directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+positions = directions * random_generator.uniform(REFERENCE_RADIUS, 5.0 * REFERENCE_RADIUS, size=(3000, 1))
+
+accelerations = field.get_accelerations(positions, number_of_threads=1)
+expected = np.array([field.get_gravitational_acceleration(position) for position in positions])
+assert np.allclose(accelerations, expected, rtol=1.0E-12, atol=0.0)
+assert np.array_equal(field.get_accelerations(positions, number_of_threads=4), accelerations)
+assert np.array_equal(field.get_accelerations(positions), accelerations)
+
+# Truncation equals a field created from the truncated coefficients.
+truncated_field = create_field(cosine_coefficients[:5, :3].copy(), sine_coefficients[:5, :3].copy())
+truncated = field.get_accelerations(positions, 4, 2, number_of_threads=1)
+expected = np.array([truncated_field.get_gravitational_acceleration(position) for position in positions])
+assert np.allclose(truncated, expected, rtol=1.0E-12, atol=0.0)
+assert np.array_equal(field.get_accelerations(positions, 4, 2, number_of_threads=4), truncated)
+assert not np.array_equal(truncated, accelerations)
+
+for degree, order in [(DEGREE + 1, 0), (2, 3)]:
+    try:
+        field.get_accelerations(positions, degree, order)
+    except RuntimeError:
+        pass
+    else:
+        raise AssertionError('unavailable degree and order were evaluated')
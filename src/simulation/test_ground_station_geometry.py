@@ -0,0 +1,87 @@
+"""Ground station geometry for a spacecraft at known elevations, azimuths and ranges from a station."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+RADIUS = 6371.0E3
+ROTATION_RATE = 7.2921159E-5
+LATITUDE = np.deg2rad(52.0)
+LONGITUDE = np.deg2rad(4.4)
+
+# A spherical body, so that the geodetic and geocentric latitude of the station are equal.
+body_settings = {'Earth': setup.BodySettings()}
+body_settings['Earth'].rotation_model_settings = setup.SimpleRotationModelSettings(
+    'J2000', 'IAU_Earth', np.eye(3), 0.0, ROTATION_RATE)
+body_settings['Earth'].shape_model_settings = setup.SphericalBodyShapeSettings(RADIUS)
+body_settings['Earth'].add_ground_station_settings(setup.GroundStationSettings(
+    'Station', [0.0, LATITUDE, LONGITUDE], setup.PositionElementTypes.geodetic_position))
+bodies = setup.create_bodies(body_settings, 'Earth', 'J2000')
+rotation_model = bodies['Earth'].rotation_model
+
+east = np.array([-np.sin(LONGITUDE), np.cos(LONGITUDE), 0.0])
+north = np.array([-np.sin(LATITUDE) * np.cos(LONGITUDE), -np.sin(LATITUDE) * np.sin(LONGITUDE), np.cos(LATITUDE)])
+up = np.array([np.cos(LATITUDE) * np.cos(LONGITUDE), np.cos(LATITUDE) * np.sin(LONGITUDE), np.sin(LATITUDE)])
+station = RADIUS * up
+
+
+def get_directions(azimuths, elevations):
+    return (np.outer(np.sin(azimuths) * np.cos(elevations), east) +
+            np.outer(np.cos(azimuths) * np.cos(elevations), north) + np.outer(np.sin(elevations), up))
+
+
+def get_states(epochs, body_fixed_positions, body_fixed_velocities):
+    """Inertial states of points moving with the given velocities in the rotating frame."""
+    positions = rotation_model.body_fixed_to_inertial(epochs, body_fixed_positions)
+    velocities = (np.cross([0.0, 0.0, ROTATION_RATE], positions) +
+                  rotation_model.body_fixed_to_inertial(epochs, body_fixed_velocities))
+    return np.hstack([positions, velocities])
+
+
+# Points fixed to the body at random azimuths and elevations, over several tasks per thread.
+random_generator = np.random.RandomState(0)
+epochs = np.linspace(0.0, 86400.0, 3001)
+azimuths = random_generator.uniform(0.01, 2.0 * np.pi - 0.01, size=len(epochs))
+elevations = random_generator.uniform(-1.2, 1.2, size=len(epochs))
+states = get_states(epochs, station + 1.0E6 * get_directions(azimuths, elevations), np.zeros((len(epochs), 3)))
+geometry = setup.compute_ground_station_geometry(bodies, 'Earth', epochs, states, number_of_threads=1)
+assert geometry['station_names'] == ['Station']
+assert np.allclose(geometry['elevation'][0], elevations, rtol=0.0, atol=1.0E-9)
+assert np.allclose(geometry['azimuth'][0], azimuths, rtol=0.0, atol=1.0E-9)
+assert np.allclose(geometry['range'][0], 1.0E6, rtol=0.0, atol=1.0E-6)
+assert np.allclose(geometry['range_rate'][0], 0.0, rtol=0.0, atol=1.0E-9)
+threaded_geometry = setup.compute_ground_station_geometry(bodies, 'Earth', epochs, states, number_of_threads=4)
+for key in ['elevation', 'azimuth', 'range', 'range_rate']:
+    assert np.array_equal(threaded_geometry[key], geometry[key])
+
+# A satellite rising along the zenith of the station at 100 m/s.
+epochs = np.linspace(0.0, 3600.0, 361)
+heights = 1.0E6 + 100.0 * epochs
+states = get_states(epochs, station + np.outer(heights, up), np.tile(100.0 * up, (len(epochs), 1)))
+geometry = setup.compute_ground_station_geometry(bodies, 'Earth', epochs, states, ['Station'])
+assert np.allclose(geometry['elevation'][0], np.pi / 2.0, rtol=0.0, atol=1.0E-7)
+assert np.allclose(geometry['range'][0], heights, rtol=0.0, atol=1.0E-6)
+assert np.allclose(geometry['range_rate'][0], 100.0, rtol=0.0, atol=1.0E-8)
+assert np.array_equal(geometry['visibility_windows']['Station'], [[0.0, 3600.0]])
+
+# A pass of which the elevation rises and sets linearly, crossing the horizon at 200 s and 800 s, between samples.
+epochs = np.arange(0.0, 1001.0, 7.0)
+pass_elevations = 0.3 - 1.0E-3 * np.abs(epochs - 500.0)
+states = get_states(epochs, station + 1.0E6 * get_directions(np.ones(len(epochs)), pass_elevations),
+                    np.zeros((len(epochs), 3)))
+windows = setup.compute_ground_station_geometry(bodies, 'Earth', epochs, states)['visibility_windows']['Station']
+assert np.allclose(windows, [[200.0, 800.0]], rtol=0.0, atol=1.0E-6)
+windows = setup.compute_ground_station_geometry(bodies, 'Earth', epochs, states,
+                                                minimum_elevation=0.1)['visibility_windows']['Station']
+assert np.allclose(windows, [[300.0, 700.0]], rtol=0.0, atol=1.0E-6)
+assert setup.compute_ground_station_geometry(bodies, 'Earth', epochs, states,
+                                             minimum_elevation=0.35)['visibility_windows']['Station'].shape == (0, 2)
+windows = setup.compute_ground_station_geometry(bodies, 'Earth', epochs[50:], states[50:])['visibility_windows']
+assert np.allclose(windows['Station'], [[epochs[50], 800.0]], rtol=0.0, atol=1.0E-6)
+
+# Epochs that are not strictly increasing are rejected.
+try:
+    setup.compute_ground_station_geometry(bodies, 'Earth', epochs[::-1], states)
+except RuntimeError:
+    pass
+else:
+    raise AssertionError('decreasing epochs were accepted')
@@ -0,0 +1,38 @@
+"""The history arrays of a simulator stay valid, and unchanged, when the simulator propagates again."""
+import gc
+
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+bodies = point_mass_setup.create_bodies()
+propagator_settings = point_mass_setup.create_propagator_settings(bodies, 3600.0)
+integrator_settings = point_mass_setup.create_rk4_settings()
+other_initial_state = np.array(point_mass_setup.INITIAL_STATE) * 1.1
+
+for history_storage in [setup.HistoryStorage.map, setup.HistoryStorage.contiguous]:
+    simulator = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, propagator_settings, True,
+                                                 history_storage)
+    states = simulator.state_history
+    epochs = simulator.state_history_epochs
+    expected_states = states.copy()
+    expected_epochs = epochs.copy()
+
+    simulator.integrate_equations_of_motion(other_initial_state)
+    other_states = simulator.state_history
+    gc.collect()
+    # Allocations of the size of the history would reuse its memory, had it been freed.
+    garbage = [np.full(states.shape, np.nan) for _ in range(16)]
+
+    assert not states.flags.writeable
+    assert np.array_equal(states, expected_states)
+    assert np.array_equal(epochs, expected_epochs)
+    assert np.array_equal(other_states[0], other_initial_state)
+    assert not np.array_equal(other_states, states)
+
+    # The history outlives the simulator as well.
+    del simulator
+    gc.collect()
+    assert np.array_equal(states, expected_states)
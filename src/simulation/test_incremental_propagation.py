@@ -0,0 +1,38 @@
+"""A variation resumed from a checkpoint of the baseline equals a complete propagation of it, bit for bit."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+bodies = point_mass_setup.create_bodies()
+baseline_settings = point_mass_setup.create_propagator_settings(bodies, 7200.0)
+
+for integrator_settings in [point_mass_setup.create_rk4_settings(),
+                            point_mass_setup.create_variable_step_settings()]:
+    propagation = setup.IncrementalPropagation(bodies, integrator_settings, baseline_settings, 5)
+    reference = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, baseline_settings, True,
+                                                 setup.HistoryStorage.contiguous)
+    assert np.array_equal(propagation.baseline_state_history_epochs, reference.state_history_epochs)
+    assert np.array_equal(propagation.baseline_state_history, reference.state_history)
+    assert not propagation.baseline_state_history.flags.writeable
+
+    # A variation terminating earlier, which is resumed from the last checkpoint before its termination.
+    variation_settings = point_mass_setup.create_propagator_settings(bodies, 3600.0)
+    variation, resumed_epoch = propagation.propagate(variation_settings, 3600.0)
+    assert 0.0 < resumed_epoch < 3600.0
+    assert resumed_epoch in propagation.checkpoint_epochs
+    reference = setup.SingleArcDynamicsSimulator(bodies, integrator_settings, variation_settings, True,
+                                                 setup.HistoryStorage.contiguous)
+    assert np.array_equal(variation.state_history_epochs, reference.state_history_epochs)
+    assert np.array_equal(variation.state_history, reference.state_history)
+
+    # Variations with other initial states are rejected.
+    other_settings = point_mass_setup.create_propagator_settings(
+        bodies, 3600.0, np.array(point_mass_setup.INITIAL_STATE) * 1.01)
+    try:
+        propagation.propagate(other_settings, 3600.0)
+    except RuntimeError:
+        pass
+    else:
+        raise AssertionError('a variation with other initial states was propagated')
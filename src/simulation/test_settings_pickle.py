@@ -0,0 +1,58 @@
+"""Settings survive a pickle round trip, and corrupted pickled states raise instead of being installed."""
+import copyreg
+import pickle
+
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+import point_mass_setup
+
+cosine_coefficients = np.zeros((3, 3))
+cosine_coefficients[0, 0] = 1.0
+cosine_coefficients[2, 0] = -4.84165371736E-4
+sine_coefficients = np.zeros((3, 3))
+
+body_settings = point_mass_setup.create_body_settings()['Earth']
+body_settings.constant_mass = 5.972E24
+body_settings.atmosphere_settings = setup.ExponentialAtmosphereSettings(7200.0, 290.0, 1.225)
+body_settings.ephemeris_settings = setup.DirectSpiceEphemerisSettings('SSB', 'J2000')
+body_settings.add_ground_station_settings(setup.GroundStationSettings('Delft', [0.0, 0.905, 0.0762],
+                                                                      setup.PositionElementTypes.geodetic_position))
+
+all_settings = [
+    setup.ExponentialAtmosphereSettings(7200.0, 290.0, 1.225),
+    setup.DirectSpiceEphemerisSettings('Earth', 'J2000'),
+    setup.InterpolatedSpiceEphemerisSettings(0.0, 86400.0, 300.0, 'SSB', 'ECLIPJ2000', 8),
+    setup.CentralGravityFieldSettings(point_mass_setup.EARTH_GRAVITATIONAL_PARAMETER),
+    setup.SphericalHarmonicsGravityFieldSettings(point_mass_setup.EARTH_GRAVITATIONAL_PARAMETER, 6378137.0,
+                                                 cosine_coefficients, sine_coefficients, 'IAU_Earth'),
+    body_settings]
+
+for settings in all_settings:
+    restored = pickle.loads(pickle.dumps(settings))
+    assert type(restored) is type(settings)
+    # The serialized state holds every field, so equal states imply equal settings.
+    state = settings.__reduce__()[2]
+    assert restored.__reduce__()[2] == state
+
+    # Every truncation of the state, and a state with trailing data, is rejected.
+    for corrupted_state in [state[:size] for size in range(len(state))] + [state + b'\0']:
+        instance = copyreg.__newobj__(type(settings))
+        try:
+            instance.__setstate__(corrupted_state)
+        except RuntimeError:
+            pass
+        else:
+            raise AssertionError('a corrupted state of {} was installed'.format(type(settings).__name__))
+
+# A matrix size exceeding the data is rejected before the matrix is allocated.
+state = all_settings[4].__reduce__()[2]
+matrix_size_offset = state.index(np.uint64(3).tobytes() + np.uint64(3).tobytes())
+corrupted_state = state[:matrix_size_offset] + np.uint64(2 ** 40).tobytes() * 2 + state[matrix_size_offset + 16:]
+try:
+    copyreg.__newobj__(setup.SphericalHarmonicsGravityFieldSettings).__setstate__(corrupted_state)
+except RuntimeError:
+    pass
+else:
+    raise AssertionError('a state with an oversized matrix was installed')
@@ -0,0 +1,46 @@
+"""The penumbra cone precheck of the shadow functions agrees with Tudat's conical shadow function at 2M points."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+ASTRONOMICAL_UNIT = 1.495978707E11
+SUN_RADIUS = 6.957E8
+EARTH_RADIUS = 6378137.0
+
+# The Sun and Earth at fixed positions, without SPICE.
+body_settings = {'Sun': setup.BodySettings(), 'Earth': setup.BodySettings()}
+body_settings['Sun'].ephemeris_settings = setup.ConstantEphemerisSettings(
+    [ASTRONOMICAL_UNIT, 0.0, 0.0, 0.0, 0.0, 0.0], 'SSB', 'J2000')
+body_settings['Sun'].shape_model_settings = setup.SphericalBodyShapeSettings(SUN_RADIUS)
+body_settings['Earth'].ephemeris_settings = setup.ConstantEphemerisSettings(np.zeros(6), 'SSB', 'J2000')
+body_settings['Earth'].shape_model_settings = setup.SphericalBodyShapeSettings(EARTH_RADIUS)
+bodies = setup.create_bodies(body_settings, 'SSB', 'J2000')
+
+# 1M points in a shell around the Earth, and 1M points in and around its shadow (up to beyond the apex of the
+# umbra, 1.4E9 m behind the Earth), where the boundary of the penumbra cone is densely sampled.
+random_generator = np.random.RandomState(0)
+directions = random_generator.normal(size=(1000000, 3))
+directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+shell_positions = directions * random_generator.uniform(EARTH_RADIUS + 1.0E5, 1.0E8, size=(1000000, 1))
+distances_to_axis = random_generator.uniform(0.0, 1.5E7, size=1000000)
+angles = random_generator.uniform(0.0, 2.0 * np.pi, size=1000000)
+shadow_positions = np.column_stack([random_generator.uniform(-1.5E9, -EARTH_RADIUS - 1.0E5, size=1000000),
+                                    distances_to_axis * np.cos(angles), distances_to_axis * np.sin(angles)])
+positions = np.vstack([shell_positions, shadow_positions])
+epochs = np.zeros(len(positions))
+
+prechecked = setup.compute_shadow_functions(bodies, epochs, positions, 'Earth', ['Earth'])
+reference = setup.compute_shadow_functions(bodies, epochs, positions, 'Earth', ['Earth'],
+                                           use_penumbra_cone_precheck=False)
+assert np.count_nonzero(reference == 0.0) > 100000
+assert np.count_nonzero((reference > 0.0) & (reference < 1.0)) > 100000
+
+# Positions inside the penumbra cone are evaluated by Tudat's function in both cases, so that any difference is a
+# position classified as lit by the precheck while Tudat's function shadows it.
+assert np.all((prechecked >= 0.0) & (prechecked <= 1.0))
+assert np.allclose(prechecked, reference, rtol=0.0, atol=1.0E-12)
+assert not np.any((prechecked == 1.0) & (reference < 1.0 - 1.0E-12))
+
+# The result does not depend on the number of threads.
+single_threaded = setup.compute_shadow_functions(bodies, epochs, positions, 'Earth', ['Earth'], number_of_threads=1)
+assert np.array_equal(single_threaded, prechecked)
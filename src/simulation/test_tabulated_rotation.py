@@ -0,0 +1,31 @@
+"""A tabulated rotation model interpolates the original one to 1E-10 rad, including over its shortened last step."""
+import numpy as np
+
+from tudatpy.core import simulation_setup as setup
+
+ROTATION_RATE = 7.2921159E-5
+FINAL_TIME = 86437.0
+
+original = setup.create_rotation_model(
+    setup.SimpleRotationModelSettings('J2000', 'IAU_Earth', np.eye(3), 0.0, ROTATION_RATE), 'Earth')
+tabulated = setup.create_tabulated_rotation_model(original, 0.0, FINAL_TIME, 60.0)
+assert tabulated.final_time == FINAL_TIME
+
+# Off-grid epochs over the whole grid, the grid points, and epochs in the last step, which is 37 s long.
+random_generator = np.random.RandomState(0)
+epochs = np.concatenate([random_generator.uniform(0.0, FINAL_TIME, size=20000), np.arange(0.0, 86401.0, 60.0),
+                         random_generator.uniform(86400.0, FINAL_TIME, size=1000), [FINAL_TIME]])
+directions = random_generator.normal(size=(len(epochs), 3))
+directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+
+expected = original.inertial_to_body_fixed(epochs, directions)
+interpolated = tabulated.inertial_to_body_fixed(epochs, directions, number_of_threads=1)
+assert np.max(np.linalg.norm(interpolated - expected, axis=1)) < 1.0E-10
+assert np.array_equal(tabulated.inertial_to_body_fixed(epochs, directions, number_of_threads=4), interpolated)
+back = tabulated.body_fixed_to_inertial(epochs, interpolated)
+assert np.max(np.linalg.norm(back - directions, axis=1)) < 1.0E-14
+
+# Outside the grid, the original model is evaluated.
+outside_epochs = np.array([-100.0, -1.0E-3, FINAL_TIME + 1.0E-3, FINAL_TIME + 100.0])
+assert np.array_equal(tabulated.inertial_to_body_fixed(outside_epochs, directions[:4]),
+                      original.inertial_to_body_fixed(outside_epochs, directions[:4]))